@@ -0,0 +1,774 @@
+/*
+  ==============================================================================
+
+    AnalysisScheduler.cpp
+    Created: 16 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "AnalysisScheduler.h"
+#include "BPMAnalyzer.h"
+#include "AudioEngine/DecodedTrackCache.h"
+#include "AudioEngine/DiskTrackCache.h"
+#include <algorithm>
+
+namespace
+{
+    constexpr int blockSize = 65536;
+    constexpr int waveformPoints = 2000;
+    constexpr size_t folderBatchSize = 256;
+
+    // Lesepuffer, Onset-Kurven samt Tempo- und Beat-Arbeitsspeicher, Loudness-Blöcke
+    size_t estimateWorkingSet(juce::int64 numSamples, double sampleRate)
+    {
+        const double seconds = sampleRate > 0.0 ? numSamples / sampleRate : 0.0;
+        return (size_t)(2 * blockSize) * sizeof(float) + (size_t)(seconds * 90.0) * 64 + 256 * 1024;
+    }
+
+    std::shared_ptr<TrackAnalysis> loadStored(const juce::File& file)
+    {
+        TrackDatabase::Record record;
+
+        if (!TrackDatabase::getInstance().lookup(file, record))
+            return nullptr;
+
+        return TrackAnalysis::fromRecord(file, std::move(record));
+    }
+}
+
+//==============================================================================
+bool TrackAnalysis::isUpToDate() const
+{
+    return file.existsAsFile()
+        && file.getSize() == fileSize
+        && file.getLastModificationTime().toMilliseconds() == modificationTime;
+}
+
+size_t TrackAnalysis::getSizeInBytes() const noexcept
+{
+    return sizeof(TrackAnalysis)
+        + (waveform.minSamples.size() + waveform.maxSamples.size()) * sizeof(float)
+        + beatGrid.segments.size() * sizeof(BeatGrid::Segment)
+        + (size_t)file.getFullPathName().getNumBytesAsUTF8();
+}
+
+TrackDatabase::Record TrackAnalysis::toRecord() const
+{
+    TrackDatabase::Record record;
+    record.duration = duration;
+    record.sampleRate = sampleRate;
+    record.bpm = bpm;
+    record.bpmConfidence = bpmConfidence;
+    record.loudness = loudness;
+    record.peak = peak;
+    record.beatGrid = beatGrid;
+    record.waveform = TrackDatabase::Record::buildWaveformLevels(waveform.minSamples, waveform.maxSamples);
+    return record;
+}
+
+std::shared_ptr<TrackAnalysis> TrackAnalysis::fromRecord(const juce::File& file, TrackDatabase::Record record)
+{
+    // Nur vollständige Datensätze, ohne Wellenform taugt er nicht für Decks und find()
+    if (record.waveform.empty())
+        return nullptr;
+
+    auto analysis = std::make_shared<TrackAnalysis>();
+    analysis->file = file;
+    analysis->fileSize = file.getSize();
+    analysis->modificationTime = file.getLastModificationTime().toMilliseconds();
+    analysis->duration = record.duration;
+    analysis->sampleRate = record.sampleRate;
+    analysis->bpm = record.bpm;
+    analysis->bpmConfidence = record.bpmConfidence;
+    analysis->beatGrid = std::move(record.beatGrid);
+    analysis->loudness = record.loudness;
+    analysis->peak = record.peak;
+
+    auto& overview = analysis->waveform;
+    overview.minSamples = std::move(record.waveform.front().minSamples);
+    overview.maxSamples = std::move(record.waveform.front().maxSamples);
+    overview.duration = record.duration;
+    overview.sampleRate = (int)record.sampleRate;
+    overview.isValid = true;
+
+    return analysis;
+}
+
+//==============================================================================
+class AnalysisScheduler::Worker : public juce::Thread
+{
+public:
+    Worker(AnalysisScheduler& scheduler, int index)
+        : juce::Thread("Analysis Worker " + juce::String(index))
+        , owner(scheduler)
+    {
+        formatManager.registerBasicFormats();
+    }
+
+    void run() override
+    {
+        owner.workerLoop(*this);
+    }
+
+    juce::AudioFormatManager formatManager;
+
+private:
+    AnalysisScheduler& owner;
+};
+
+//==============================================================================
+AnalysisScheduler::ForegroundScope::ForegroundScope()
+{
+    auto& scheduler = getInstance();
+    const std::lock_guard<std::mutex> guard(scheduler.lock);
+    ++scheduler.foregroundWork;
+}
+
+AnalysisScheduler::ForegroundScope::~ForegroundScope()
+{
+    auto& scheduler = getInstance();
+
+    {
+        const std::lock_guard<std::mutex> guard(scheduler.lock);
+        --scheduler.foregroundWork;
+    }
+
+    scheduler.workChanged.notify_all();
+}
+
+//==============================================================================
+AnalysisScheduler& AnalysisScheduler::getInstance()
+{
+    static AnalysisScheduler scheduler;
+    return scheduler;
+}
+
+AnalysisScheduler::AnalysisScheduler()
+{
+    // Vor den Workern anlegen: statische Objekte sterben in umgekehrter Reihenfolge,
+    // so leben Datenbank und Caches länger als der Scheduler
+    TrackDatabase::getInstance();
+    DecodedTrackCache::getInstance();
+    DiskTrackCache::getInstance();
+
+    // Höchstens die Hälfte der Kerne, Audio Thread und Deck-Loader brauchen auch welche
+    const int numWorkers = juce::jlimit(1, 4, juce::SystemStats::getNumCpus() / 2);
+
+    for (int i = 0; i < numWorkers; ++i)
+    {
+        workers.push_back(std::make_unique<Worker>(*this, i + 1));
+        workers.back()->startThread(juce::Thread::Priority::background);
+    }
+}
+
+AnalysisScheduler::~AnalysisScheduler()
+{
+    shutdown();
+}
+
+void AnalysisScheduler::shutdown()
+{
+    {
+        const std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+
+        // Wie cancelAll(); laufende Jobs tragen sich in finishJob() selbst aus
+        for (auto& queue : lanes)
+        {
+            for (const auto& job : queue)
+                queuedPaths.erase(job.file.getFullPathName());
+
+            queue.clear();
+        }
+
+        for (auto& job : running)
+            job->cancelled = true;
+    }
+
+    workChanged.notify_all();
+
+    for (auto& worker : workers)
+        worker->stopThread(4000);
+
+    // Schon eingereihte Ergebnisse erreichen danach niemanden mehr
+    listeners.clear();
+    TrackDatabase::getInstance().flush();
+}
+
+//==============================================================================
+void AnalysisScheduler::request(const juce::File& file, Lane lane)
+{
+    if (!file.existsAsFile() || find(file) != nullptr)
+        return;
+
+    {
+        const std::lock_guard<std::mutex> guard(lock);
+        enqueue({ file, lane });
+    }
+
+    workChanged.notify_all();
+}
+
+void AnalysisScheduler::request(const juce::Array<juce::File>& files, Lane lane)
+{
+    {
+        const std::lock_guard<std::mutex> guard(lock);
+
+        for (const auto& file : files)
+            enqueue({ file, lane });
+    }
+
+    workChanged.notify_all();
+}
+
+void AnalysisScheduler::requestFolder(const juce::File& folder, bool recursive, Lane lane)
+{
+    if (!folder.isDirectory())
+        return;
+
+    {
+        const std::lock_guard<std::mutex> guard(lock);
+        enqueue({ folder, lane, true, recursive });
+    }
+
+    workChanged.notify_all();
+}
+
+void AnalysisScheduler::enqueue(const Job& job)
+{
+    if (stopping)
+        return;
+
+    const auto path = job.file.getFullPathName();
+
+    if (!job.isFolder && results.count(path) > 0)
+        return;
+
+    if (isQueued(path))
+    {
+        // Läuft schon: nur die Lane anheben, damit der Job nicht mehr weicht
+        for (auto& current : running)
+        {
+            if (current->job.file == job.file)
+            {
+                current->job.lane = juce::jmin(current->job.lane, job.lane);
+                return;
+            }
+        }
+
+        // Wartet in einer niedrigeren Lane: dort herausnehmen und weiter vorne einreihen
+        bool moved = false;
+
+        for (int lane = (int)job.lane + 1; lane < numLanes && !moved; ++lane)
+        {
+            auto& queue = lanes[lane];
+            auto it = std::find_if(queue.begin(), queue.end(), [&](const Job& queued) { return queued.file == job.file; });
+
+            if (it != queue.end())
+            {
+                auto raised = *it;
+                raised.lane = job.lane;
+                queue.erase(it);
+                lanes[(int)job.lane].push_back(raised);
+                moved = true;
+            }
+        }
+
+        return;
+    }
+
+    queuedPaths.insert(path);
+    lanes[(int)job.lane].push_back(job);
+}
+
+void AnalysisScheduler::cancel(const juce::File& file)
+{
+    {
+        const std::lock_guard<std::mutex> guard(lock);
+
+        for (auto& queue : lanes)
+            queue.erase(std::remove_if(queue.begin(), queue.end(), [&](const Job& job) { return job.file == file; }), queue.end());
+
+        bool isRunning = false;
+
+        for (auto& current : running)
+        {
+            if (current->job.file == file)
+            {
+                current->cancelled = true;
+                isRunning = true;
+            }
+        }
+
+        if (!isRunning)
+            queuedPaths.erase(file.getFullPathName());
+    }
+
+    workChanged.notify_all();
+}
+
+void AnalysisScheduler::cancelLane(Lane lane)
+{
+    {
+        const std::lock_guard<std::mutex> guard(lock);
+
+        for (const auto& job : lanes[(int)lane])
+            queuedPaths.erase(job.file.getFullPathName());
+
+        lanes[(int)lane].clear();
+
+        for (auto& current : running)
+            if (current->job.lane == lane)
+                current->cancelled = true;
+    }
+
+    workChanged.notify_all();
+}
+
+void AnalysisScheduler::cancelAll()
+{
+    for (int lane = 0; lane < numLanes; ++lane)
+        cancelLane((Lane)lane);
+}
+
+TrackAnalysisPtr AnalysisScheduler::find(const juce::File& file)
+{
+    TrackAnalysisPtr analysis;
+    const auto path = file.getFullPathName();
+
+    {
+        const std::lock_guard<std::mutex> guard(lock);
+        auto it = results.find(path);
+
+        if (it != results.end())
+        {
+            analysis = it->second.analysis;
+            resultsByAge.splice(resultsByAge.begin(), resultsByAge, it->second.lruPosition);
+        }
+    }
+
+    // Nicht im Speicher: aus einer früheren Sitzung?
+    if (analysis == nullptr)
+    {
+        analysis = loadStored(file);
+
+        if (analysis != nullptr)
+            addResult(analysis);
+
+        return analysis;
+    }
+
+    // Datei geändert: Ergebnis verwerfen, der nächste request() analysiert neu
+    if (!analysis->isUpToDate())
+    {
+        const std::lock_guard<std::mutex> guard(lock);
+        auto it = results.find(path);
+
+        if (it != results.end() && it->second.analysis == analysis)
+        {
+            resultBytes -= analysis->getSizeInBytes();
+            resultsByAge.erase(it->second.lruPosition);
+            results.erase(it);
+        }
+
+        return nullptr;
+    }
+
+    return analysis;
+}
+
+bool AnalysisScheduler::isPending(const juce::File& file) const
+{
+    const std::lock_guard<std::mutex> guard(lock);
+    return isQueued(file.getFullPathName());
+}
+
+double AnalysisScheduler::getProgress(const juce::File& file) const
+{
+    const std::lock_guard<std::mutex> guard(lock);
+
+    for (const auto& current : running)
+        if (current->job.file == file)
+            return current->progress.load();
+
+    return 0.0;
+}
+
+TrackAnalysisPtr AnalysisScheduler::waitFor(const juce::File& file, int timeoutMs)
+{
+    const auto path = file.getFullPathName();
+
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        workChanged.wait_for(guard, std::chrono::milliseconds(timeoutMs), [&] { return stopping || !isQueued(path); });
+    }
+
+    return find(file);
+}
+
+int AnalysisScheduler::getNumPending() const
+{
+    const std::lock_guard<std::mutex> guard(lock);
+
+    size_t pending = running.size();
+    for (const auto& queue : lanes)
+        pending += queue.size();
+
+    return (int)pending;
+}
+
+int AnalysisScheduler::getNumPending(Lane lane) const
+{
+    const std::lock_guard<std::mutex> guard(lock);
+
+    auto pending = lanes[(int)lane].size();
+    for (const auto& current : running)
+        if (current->job.lane == lane)
+            ++pending;
+
+    return (int)pending;
+}
+
+void AnalysisScheduler::setMemoryBudget(size_t bytes)
+{
+    {
+        const std::lock_guard<std::mutex> guard(lock);
+        memoryBudget = bytes;
+        evictResults();
+    }
+
+    workChanged.notify_all();
+}
+
+size_t AnalysisScheduler::getMemoryBudget() const
+{
+    const std::lock_guard<std::mutex> guard(lock);
+    return memoryBudget;
+}
+
+//==============================================================================
+void AnalysisScheduler::workerLoop(Worker& worker)
+{
+    while (!worker.threadShouldExit())
+    {
+        std::shared_ptr<RunningJob> current;
+
+        {
+            std::unique_lock<std::mutex> guard(lock);
+
+            ++idleWorkers;
+            workChanged.wait_for(guard, std::chrono::milliseconds(500), [this] { return stopping || hasStartableJob(); });
+            --idleWorkers;
+
+            if (stopping)
+                return;
+
+            current = startNextJob();
+        }
+
+        // Nichts zu tun: was bisher analysiert wurde, in den Index der Bibliothek
+        if (current == nullptr)
+        {
+            TrackDatabase::getInstance().flush();
+            continue;
+        }
+
+        Outcome outcome;
+
+        if (current->job.isFolder)
+        {
+            outcome = scanFolder(worker, *current);
+        }
+        else
+        {
+            // Aus einer früheren Sitzung bekannt: nur ausliefern
+            auto analysis = loadStored(current->job.file);
+
+            if (analysis != nullptr)
+            {
+                outcome = Outcome::done;
+            }
+            else
+            {
+                analysis = std::make_shared<TrackAnalysis>();
+                outcome = analyseTrack(worker, *current, *analysis);
+
+                if (outcome == Outcome::done)
+                    TrackDatabase::getInstance().store(analysis->file, analysis->toRecord());
+            }
+
+            if (outcome == Outcome::done)
+            {
+                TrackAnalysisPtr result = analysis;
+                addResult(result);
+
+                juce::MessageManager::callAsync([this, result]
+                {
+                    listeners.call([&result](Listener& listener) { listener.trackAnalysed(result); });
+                });
+            }
+        }
+
+        finishJob(current, outcome);
+    }
+}
+
+bool AnalysisScheduler::hasStartableJob() const
+{
+    // Während ein Deck lädt, nur die Deck-Lane
+    const int usableLanes = foregroundWork.load() > 0 ? 1 : numLanes;
+
+    for (int lane = 0; lane < usableLanes; ++lane)
+        if (!lanes[lane].empty())
+            return true;
+
+    return false;
+}
+
+std::shared_ptr<AnalysisScheduler::RunningJob> AnalysisScheduler::startNextJob()
+{
+    const int usableLanes = foregroundWork.load() > 0 ? 1 : numLanes;
+
+    for (int lane = 0; lane < usableLanes; ++lane)
+    {
+        if (lanes[lane].empty())
+            continue;
+
+        auto job = std::make_shared<RunningJob>();
+        job->job = lanes[lane].front();
+        lanes[lane].pop_front();
+
+        running.push_back(job);
+        return job;
+    }
+
+    return nullptr;
+}
+
+void AnalysisScheduler::finishJob(const std::shared_ptr<RunningJob>& job, Outcome outcome)
+{
+    {
+        const std::lock_guard<std::mutex> guard(lock);
+
+        inFlightBytes -= job->reservedBytes;
+        yieldingJobs -= job->yielding ? 1 : 0;
+        running.erase(std::remove(running.begin(), running.end(), job), running.end());
+
+        // Zurückgestellt: vorne in die eigene Lane, bleibt in queuedPaths
+        if (outcome == Outcome::yielded && !job->cancelled && !stopping)
+            lanes[(int)job->job.lane].push_front(job->job);
+        else
+            queuedPaths.erase(job->job.file.getFullPathName());
+    }
+
+    workChanged.notify_all();
+}
+
+bool AnalysisScheduler::shouldStop(RunningJob& job)
+{
+    if (job.cancelled)
+        return true;
+
+    const std::lock_guard<std::mutex> guard(lock);
+
+    if (stopping)
+        return true;
+
+    if (job.job.lane == Lane::deck)
+        return false;
+
+    if (foregroundWork.load() > 0)
+        return true;
+
+    // Höhere Lane wartet und kein Worker ist frei: Platz machen, aber nur so viele
+    // Jobs, wie dort warten, nicht alle auf einmal
+    if (job.yielding)
+        return true;
+
+    if (idleWorkers > 0)
+        return false;
+
+    size_t waitingAbove = 0;
+    for (int lane = 0; lane < (int)job.job.lane; ++lane)
+        waitingAbove += lanes[lane].size();
+
+    if (waitingAbove <= (size_t)yieldingJobs)
+        return false;
+
+    job.yielding = true;
+    ++yieldingJobs;
+    return true;
+}
+
+bool AnalysisScheduler::reserve(RunningJob& job, size_t bytes)
+{
+    std::unique_lock<std::mutex> guard(lock);
+
+    // Ein Job darf immer laufen, sonst nur so viele, wie ins Budget passen
+    workChanged.wait(guard, [&]
+    {
+        return stopping || job.cancelled || inFlightBytes == 0 || inFlightBytes + bytes <= memoryBudget;
+    });
+
+    if (stopping || job.cancelled)
+        return false;
+
+    inFlightBytes += bytes;
+    job.reservedBytes = bytes;
+    evictResults();
+    return true;
+}
+
+void AnalysisScheduler::addResult(TrackAnalysisPtr analysis)
+{
+    const std::lock_guard<std::mutex> guard(lock);
+    const auto path = analysis->file.getFullPathName();
+
+    auto existing = results.find(path);
+    if (existing != results.end())
+    {
+        resultBytes -= existing->second.analysis->getSizeInBytes();
+        resultsByAge.erase(existing->second.lruPosition);
+        results.erase(existing);
+    }
+
+    resultsByAge.push_front(path);
+    resultBytes += analysis->getSizeInBytes();
+    results[path] = { std::move(analysis), resultsByAge.begin() };
+
+    evictResults();
+}
+
+void AnalysisScheduler::evictResults()
+{
+    while (resultBytes + inFlightBytes > memoryBudget && !resultsByAge.empty())
+    {
+        auto it = results.find(resultsByAge.back());
+        resultBytes -= it->second.analysis->getSizeInBytes();
+        results.erase(it);
+        resultsByAge.pop_back();
+    }
+}
+
+//==============================================================================
+AnalysisScheduler::Outcome AnalysisScheduler::analyseTrack(Worker& worker, RunningJob& job, TrackAnalysis& analysis)
+{
+    const auto& file = job.job.file;
+
+    // Schon dekodiert (Deck)? Dann aus dem Speicher, sonst blockweise von der Platte
+    auto decoded = DecodedTrackCache::getInstance().find(file);
+    std::unique_ptr<juce::AudioFormatReader> reader;
+
+    if (decoded == nullptr)
+    {
+        reader = DiskTrackCache::getInstance().createReader(file);
+
+        if (reader == nullptr)
+            reader.reset(worker.formatManager.createReaderFor(file));
+
+        if (reader == nullptr || reader->lengthInSamples <= 0 || reader->sampleRate <= 0.0)
+            return Outcome::failed;
+    }
+
+    const juce::int64 length = decoded != nullptr ? decoded->buffer.getNumSamples() : reader->lengthInSamples;
+    const double sampleRate = decoded != nullptr ? decoded->sampleRate : reader->sampleRate;
+
+    if (!reserve(job, estimateWorkingSet(length, sampleRate)))
+        return Outcome::cancelled;
+
+    BPMAnalyzer tempo;
+    tempo.beginTrack(sampleRate, length);
+
+    WaveformGenerator::Builder waveform(length, sampleRate, waveformPoints);
+
+    LoudnessMeter loudness;
+    loudness.prepare(sampleRate);
+
+    juce::AudioBuffer<float> block(2, decoded != nullptr ? 1 : blockSize);
+
+    for (juce::int64 start = 0; start < length; start += blockSize)
+    {
+        if (shouldStop(job))
+            return job.cancelled ? Outcome::cancelled : Outcome::yielded;
+
+        const int count = (int)juce::jmin((juce::int64)blockSize, length - start);
+        const float* channels[2];
+
+        if (decoded != nullptr)
+        {
+            channels[0] = decoded->buffer.getReadPointer(0, (int)start);
+            channels[1] = decoded->buffer.getReadPointer(1, (int)start);
+        }
+        else
+        {
+            // Beide Kanäle anfordern: JUCE verdoppelt Mono-Dateien dabei selbst
+            if (!reader->read(&block, 0, count, start, true, true))
+                return Outcome::failed;
+
+            channels[0] = block.getReadPointer(0);
+            channels[1] = block.getReadPointer(1);
+        }
+
+        job.progress = (float)((double)(start + count) / (double)length);
+
+        tempo.addTrackBlock(channels, 2, count);
+        waveform.addBlock(channels[0], channels[1], count);
+        loudness.process(channels, 2, count);
+    }
+
+    tempo.finishTrack();
+
+    analysis.file = file;
+    analysis.fileSize = file.getSize();
+    analysis.modificationTime = file.getLastModificationTime().toMilliseconds();
+    analysis.duration = length / sampleRate;
+    analysis.sampleRate = sampleRate;
+    analysis.bpm = tempo.getBPM();
+    analysis.bpmConfidence = tempo.getConfidence();
+    analysis.beatGrid = tempo.getBeatGrid();
+    analysis.waveform = waveform.finish();
+    analysis.loudness = loudness.getIntegratedLoudness();
+    analysis.peak = loudness.getPeak();
+
+    return Outcome::done;
+}
+
+AnalysisScheduler::Outcome AnalysisScheduler::scanFolder(Worker& worker, RunningJob& job)
+{
+    std::vector<Job> batch;
+
+    auto flush = [this, &batch]
+    {
+        {
+            const std::lock_guard<std::mutex> guard(lock);
+
+            for (const auto& found : batch)
+                enqueue(found);
+        }
+
+        batch.clear();
+        workChanged.notify_all();
+    };
+
+    for (const auto& entry : juce::RangedDirectoryIterator(job.job.file, job.job.recursive, "*", juce::File::findFiles))
+    {
+        const auto& file = entry.getFile();
+
+        if (file.getFileName().startsWithChar('.') || worker.formatManager.findFormatForFileExtension(file.getFileExtension()) == nullptr)
+            continue;
+
+        batch.push_back({ file, job.job.lane });
+
+        if (batch.size() >= folderBatchSize)
+        {
+            flush();
+
+            if (job.cancelled)
+                return Outcome::cancelled;
+        }
+    }
+
+    flush();
+    return Outcome::done;
+}
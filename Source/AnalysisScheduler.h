@@ -0,0 +1,229 @@
+/*
+  ==============================================================================
+
+    AnalysisScheduler.h
+    Created: 16 Oct 2026
+
+    Background analysis of whole playlists and folders: duration, sample
+    rate, BPM and beatgrid, waveform overview and integrated loudness per
+    track, computed in one streaming pass over the file (blocks from the
+    reader, or from the DecodedTrackCache if a deck already decoded it), so
+    a job never holds a whole decoded track.
+
+    Requests go into priority lanes:
+
+      deck      the track a DeckLoader is loading, picked first and never
+                asked to give way
+      playlist  tracks in the playlist
+      library   folder scans
+
+    Workers take the highest non-empty lane. A running job checks between
+    blocks whether it should give way: while a deck load is in progress
+    (ForegroundScope) or a higher lane has work and no worker is idle,
+    playlist and library jobs stop and go back to the front of their lane.
+
+    Memory: the working sets of running jobs plus the finished results kept
+    for find() stay within the memory budget; the least recently used
+    results are dropped first. Every result is also written to the
+    TrackDatabase (TrackAnalysis::toRecord is the only place a record is
+    built); tracks found there from an earlier session are delivered
+    without being decoded again, and find() falls back to it for results
+    no longer in memory. Deck loads get their waveform and beatgrid the
+    same way, there is no second analysis pipeline.
+
+    Workers run at background OS priority. Results are delivered to the
+    listeners on the message thread. The app calls shutdown() before the
+    message loop ends; the TrackDatabase and track caches the workers use
+    are created before the scheduler, so they outlive it.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "AudioEngine/BeatGrid.h"
+#include "AudioEngine/LoudnessMeter.h"
+#include "AudioEngine/TrackDatabase.h"
+#include "WaveformGenerator.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
+
+struct TrackAnalysis
+{
+    juce::File file;
+    juce::int64 fileSize = 0;
+    juce::int64 modificationTime = 0;   // ms
+
+    double duration = 0.0;
+    double sampleRate = 0.0;
+    double bpm = 0.0;
+    double bpmConfidence = 0.0;
+    BeatGrid beatGrid;
+    WaveformGenerator::WaveformData waveform;
+    double loudness = LoudnessMeter::silence;   // integriert, LUFS
+    float peak = 0.0f;
+
+    bool isUpToDate() const;
+    size_t getSizeInBytes() const noexcept;
+
+    /** Conversion to and from the persistent form in the TrackDatabase. */
+    TrackDatabase::Record toRecord() const;
+    static std::shared_ptr<TrackAnalysis> fromRecord(const juce::File& file, TrackDatabase::Record record);
+};
+
+using TrackAnalysisPtr = std::shared_ptr<const TrackAnalysis>;
+
+class AnalysisScheduler
+{
+public:
+    enum class Lane
+    {
+        deck,
+        playlist,
+        library
+    };
+
+    static constexpr int numLanes = 3;
+
+    class Listener
+    {
+    public:
+        virtual ~Listener() = default;
+        virtual void trackAnalysed(const TrackAnalysisPtr& analysis) = 0;
+    };
+
+    /** While one exists, playlist and library jobs pause; a deck load holds one for its duration. */
+    class ForegroundScope
+    {
+    public:
+        ForegroundScope();
+        ~ForegroundScope();
+
+        JUCE_DECLARE_NON_COPYABLE(ForegroundScope)
+    };
+
+    static AnalysisScheduler& getInstance();
+
+    ~AnalysisScheduler();
+
+    /** Cancels every lane, joins the workers and drops the listeners; later requests are ignored. Message thread. */
+    void shutdown();
+
+    /** Queues file unless it is analysed already; a request in a higher lane moves a queued one up. */
+    void request(const juce::File& file, Lane lane);
+    void request(const juce::Array<juce::File>& files, Lane lane);
+
+    /** Scans folder on a worker and queues every audio file in it. */
+    void requestFolder(const juce::File& folder, bool recursive, Lane lane = Lane::library);
+
+    void cancel(const juce::File& file);
+    void cancelLane(Lane lane);
+    void cancelAll();
+
+    /** The analysis of file if it is in memory and the file did not change since. */
+    TrackAnalysisPtr find(const juce::File& file);
+
+    /** True while file is queued or being analysed. */
+    bool isPending(const juce::File& file) const;
+
+    /** How far the running analysis of file is, 0..1; 0 while it waits. */
+    double getProgress(const juce::File& file) const;
+
+    /** Blocks until file is no longer pending or timeoutMs passed, then returns find(file). */
+    TrackAnalysisPtr waitFor(const juce::File& file, int timeoutMs);
+
+    int getNumPending() const;
+
+    /** Queued and running jobs of one lane, folder scans included. */
+    int getNumPending(Lane lane) const;
+
+    void setMemoryBudget(size_t bytes);
+    size_t getMemoryBudget() const;
+
+    // Message thread
+    void addListener(Listener* listener) { listeners.add(listener); }
+    void removeListener(Listener* listener) { listeners.remove(listener); }
+
+private:
+    AnalysisScheduler();
+
+    class Worker;
+
+    struct Job
+    {
+        juce::File file;
+        Lane lane = Lane::library;
+        bool isFolder = false;
+        bool recursive = false;
+    };
+
+    struct RunningJob
+    {
+        Job job;
+        std::atomic<bool> cancelled { false };
+        bool yielding = false;      // gibt einem Job aus einer höheren Lane Platz
+        std::atomic<float> progress { 0.0f };
+        size_t reservedBytes = 0;
+    };
+
+    enum class Outcome
+    {
+        done,
+        failed,
+        cancelled,
+        yielded
+    };
+
+    struct Result
+    {
+        TrackAnalysisPtr analysis;
+        std::list<juce::String>::iterator lruPosition;
+    };
+
+    void workerLoop(Worker& worker);
+    std::shared_ptr<RunningJob> startNextJob();
+    bool hasStartableJob() const;
+    void finishJob(const std::shared_ptr<RunningJob>& job, Outcome outcome);
+
+    Outcome analyseTrack(Worker& worker, RunningJob& job, TrackAnalysis& analysis);
+    Outcome scanFolder(Worker& worker, RunningJob& job);
+
+    bool shouldStop(RunningJob& job);
+    bool reserve(RunningJob& job, size_t bytes);
+    void addResult(TrackAnalysisPtr analysis);
+    void evictResults();
+
+    void enqueue(const Job& job);   // lock gehalten
+    bool isQueued(const juce::String& path) const { return queuedPaths.count(path) > 0; }
+
+    mutable std::mutex lock;
+    std::condition_variable workChanged;
+
+    std::deque<Job> lanes[numLanes];
+    std::set<juce::String> queuedPaths;
+    std::vector<std::shared_ptr<RunningJob>> running;
+
+    std::map<juce::String, Result> results;
+    std::list<juce::String> resultsByAge;   // zuletzt benutzt vorne
+    size_t resultBytes = 0;
+    size_t inFlightBytes = 0;
+    size_t memoryBudget = 64 * 1024 * 1024;
+
+    std::atomic<int> foregroundWork { 0 };
+    int idleWorkers = 0;
+    int yieldingJobs = 0;
+    bool stopping = false;
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    juce::ListenerList<Listener> listeners;
+
+    JUCE_DECLARE_NON_COPYABLE(AnalysisScheduler)
+};
@@ -22,7 +22,7 @@
 #include <iostream>
 #include "Modulator.h"
 
-#include "../JuceLibraryCode/JuceHeader.h"
+#include <JuceHeader.h>
 
 using namespace std;
 
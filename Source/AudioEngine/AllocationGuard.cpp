@@ -0,0 +1,58 @@
+/*
+  ==============================================================================
+
+    AllocationGuard.cpp
+    Created: 16 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "AllocationGuard.h"
+
+#if RADIOBLAST_CHECK_AUDIO_ALLOCATIONS
+
+#include <cstdlib>
+#include <new>
+
+void* operator new (std::size_t size)
+{
+    if (AllocationGuard::isArmed())
+        AllocationGuard::reportViolation();
+
+    if (auto* ptr = std::malloc (size == 0 ? 1 : size))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[] (std::size_t size)
+{
+    return operator new (size);
+}
+
+void* operator new (std::size_t size, const std::nothrow_t&) noexcept
+{
+    if (AllocationGuard::isArmed())
+        AllocationGuard::reportViolation();
+
+    return std::malloc (size == 0 ? 1 : size);
+}
+
+void* operator new[] (std::size_t size, const std::nothrow_t& tag) noexcept
+{
+    return operator new (size, tag);
+}
+
+void operator delete (void* ptr) noexcept
+{
+    if (ptr != nullptr && AllocationGuard::isArmed())
+        AllocationGuard::reportViolation();
+
+    std::free (ptr);
+}
+
+void operator delete[] (void* ptr) noexcept               { operator delete (ptr); }
+void operator delete (void* ptr, std::size_t) noexcept    { operator delete (ptr); }
+void operator delete[] (void* ptr, std::size_t) noexcept  { operator delete (ptr); }
+
+#endif
@@ -0,0 +1,70 @@
+/*
+  ==============================================================================
+
+    AllocationGuard.h
+    Created: 16 Oct 2026
+
+    Debug check for real-time code. While a ScopedNoAllocation is alive on a
+    thread, every global operator new / delete made by that thread is counted
+    and raises a jassert, so a render path that claims to be allocation-free
+    can prove it under a debugger.
+
+    Build with RADIOBLAST_CHECK_AUDIO_ALLOCATIONS=1 to enable. The counting
+    operator new / delete replacements live in AllocationGuard.cpp; with the
+    flag off the guard compiles to nothing.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <utility>
+
+#ifndef RADIOBLAST_CHECK_AUDIO_ALLOCATIONS
+ #define RADIOBLAST_CHECK_AUDIO_ALLOCATIONS 0
+#endif
+
+namespace AllocationGuard
+{
+   #if RADIOBLAST_CHECK_AUDIO_ALLOCATIONS
+    inline thread_local int guardDepth = 0;
+    inline std::atomic<int> violationCount { 0 };
+
+    inline bool isArmed() noexcept { return guardDepth > 0; }
+
+    /** Called by the replaced operator new / delete when the current thread is guarded. */
+    inline void reportViolation() noexcept
+    {
+        // Disarm while reporting, the assertion machinery may allocate itself
+        const auto depth = std::exchange (guardDepth, 0);
+        violationCount.fetch_add (1, std::memory_order_relaxed);
+        jassertfalse; // heap allocation inside a region that must not allocate
+        guardDepth = depth;
+    }
+
+    /** Number of allocations caught inside guarded regions since startup. */
+    inline int getViolationCount() noexcept { return violationCount.load (std::memory_order_relaxed); }
+
+    class ScopedNoAllocation
+    {
+    public:
+        ScopedNoAllocation() noexcept  { ++guardDepth; }
+        ~ScopedNoAllocation() noexcept { --guardDepth; }
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedNoAllocation)
+    };
+   #else
+    inline bool isArmed() noexcept { return false; }
+    inline int getViolationCount() noexcept { return 0; }
+
+    class ScopedNoAllocation
+    {
+    public:
+        ScopedNoAllocation() noexcept {}
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedNoAllocation)
+    };
+   #endif
+}
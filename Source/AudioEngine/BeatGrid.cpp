@@ -0,0 +1,109 @@
+/*
+  ==============================================================================
+
+    BeatGrid.cpp
+    Created: 16 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "BeatGrid.h"
+#include <algorithm>
+#include <cmath>
+
+//==============================================================================
+int BeatGrid::getNumBeats() const noexcept
+{
+    return segments.empty() ? 0 : segments.back().getLastBeat() + 1;
+}
+
+double BeatGrid::getBPM() const noexcept
+{
+    const Segment* longest = nullptr;
+
+    for (const auto& segment : segments)
+        if (longest == nullptr || segment.numBeats > longest->numBeats)
+            longest = &segment;
+
+    return longest != nullptr ? longest->getBPM() : 0.0;
+}
+
+const BeatGrid::Segment& BeatGrid::findSegmentForBeat(int beat) const noexcept
+{
+    // Letztes Segment mit firstBeat <= beat, davor gilt das erste
+    auto it = std::upper_bound(segments.begin(), segments.end(), beat,
+                               [](int b, const Segment& segment) { return b < segment.firstBeat; });
+
+    return it == segments.begin() ? segments.front() : *(it - 1);
+}
+
+const BeatGrid::Segment& BeatGrid::findSegmentForTime(double time) const noexcept
+{
+    auto it = std::upper_bound(segments.begin(), segments.end(), time,
+                               [](double t, const Segment& segment) { return t < segment.startTime; });
+
+    return it == segments.begin() ? segments.front() : *(it - 1);
+}
+
+double BeatGrid::getBeatTime(int beat) const noexcept
+{
+    if (segments.empty())
+        return 0.0;
+
+    return findSegmentForBeat(beat).getBeatTime(beat);
+}
+
+double BeatGrid::getBeatPosition(double time) const noexcept
+{
+    if (segments.empty())
+        return 0.0;
+
+    const auto& segment = findSegmentForTime(time);
+    const double position = segment.firstBeat + (time - segment.startTime) / segment.beatLength;
+
+    // Zwischen dem letzten Schlag eines Segments und dem ersten des nächsten linear überblenden
+    const int lastBeat = segment.getLastBeat();
+
+    if (position > lastBeat && &segment != &segments.back())
+    {
+        const auto& next = *(&segment + 1);
+        const double lastBeatTime = segment.getBeatTime(lastBeat);
+        const double gap = next.startTime - lastBeatTime;
+
+        if (gap > 0.0)
+            return lastBeat + (time - lastBeatTime) / gap * (next.firstBeat - lastBeat);
+    }
+
+    return position;
+}
+
+double BeatGrid::getBeatPhase(double time) const noexcept
+{
+    const double position = getBeatPosition(time);
+    return position - std::floor(position);
+}
+
+double BeatGrid::getBarPhase(double time) const noexcept
+{
+    const double sinceDownbeat = getBeatPosition(time) - firstDownbeat;
+    const double bars = sinceDownbeat / beatsPerBar;
+    return (bars - std::floor(bars)) * beatsPerBar;
+}
+
+bool BeatGrid::isDownbeat(int beat) const noexcept
+{
+    const int inBar = (beat - firstDownbeat) % beatsPerBar;
+    return inBar == 0;
+}
+
+std::vector<double> BeatGrid::getBeatTimes() const
+{
+    std::vector<double> times;
+    times.reserve((size_t)juce::jmax(0, getNumBeats()));
+
+    for (const auto& segment : segments)
+        for (int beat = segment.firstBeat; beat <= segment.getLastBeat(); ++beat)
+            times.push_back(segment.getBeatTime(beat));
+
+    return times;
+}
@@ -0,0 +1,67 @@
+/*
+  ==============================================================================
+
+    BeatGrid.h
+    Created: 16 Oct 2026
+
+    Beat positions of a whole track as a list of constant-tempo segments.
+    A quantized track is a single segment; live-drummer material gets a new
+    segment wherever the tempo drifts off the previous one. Beats are
+    numbered across segments from 0, every beatsPerBar-th beat starting at
+    firstDownbeat is a downbeat.
+
+    Times are seconds from the start of the track at its own sample rate,
+    so multiplying by the rate gives the sample position of a beat.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+
+struct BeatGrid
+{
+    struct Segment
+    {
+        double startTime = 0.0;     // erster Schlag des Segments, Sekunden
+        double beatLength = 0.5;    // Sekunden pro Schlag
+        int firstBeat = 0;          // Index des ersten Schlags im ganzen Grid
+        int numBeats = 0;
+
+        double getBPM() const noexcept { return 60.0 / beatLength; }
+        double getBeatTime(int beat) const noexcept { return startTime + (beat - firstBeat) * beatLength; }
+        int getLastBeat() const noexcept { return firstBeat + numBeats - 1; }
+    };
+
+    std::vector<Segment> segments;
+    int beatsPerBar = 4;
+    int firstDownbeat = 0;          // 0 .. beatsPerBar - 1
+
+    bool isValid() const noexcept { return !segments.empty() && getNumBeats() > 1; }
+    int getNumBeats() const noexcept;
+
+    /** Tempo of the segment covering the most beats. */
+    double getBPM() const noexcept;
+
+    /** Time of a beat; beats before the first or after the last are extrapolated. */
+    double getBeatTime(int beat) const noexcept;
+
+    /** Fractional beat index at time, e.g. 16.25 is a quarter beat after beat 16. */
+    double getBeatPosition(double time) const noexcept;
+
+    /** Position within the current beat, 0 .. 1. */
+    double getBeatPhase(double time) const noexcept;
+
+    /** Position within the current bar, 0 .. beatsPerBar. */
+    double getBarPhase(double time) const noexcept;
+
+    bool isDownbeat(int beat) const noexcept;
+
+    std::vector<double> getBeatTimes() const;
+
+private:
+    const Segment& findSegmentForBeat(int beat) const noexcept;
+    const Segment& findSegmentForTime(double time) const noexcept;
+};
@@ -0,0 +1,349 @@
+/*
+  ==============================================================================
+
+    BeatTracker.cpp
+    Created: 16 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "BeatTracker.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    constexpr int peakSearchFrames = 2;
+    constexpr int minBeatsForSlope = 4;
+
+    // Laufende Ausgleichsgerade time = intercept + beat * slope, x relativ zum Segmentanfang
+    struct LineFit
+    {
+        double n = 0.0, sumX = 0.0, sumY = 0.0, sumXX = 0.0, sumXY = 0.0;
+
+        void add(double x, double y) noexcept
+        {
+            n += 1.0; sumX += x; sumY += y; sumXX += x * x; sumXY += x * y;
+        }
+
+        // Bei wenigen Schlägen ist die Steigung zu unsicher, dann das geschätzte Tempo nehmen
+        double getSlope(double fallback) const noexcept
+        {
+            const double denominator = n * sumXX - sumX * sumX;
+
+            if (n < minBeatsForSlope || denominator <= 0.0)
+                return fallback;
+
+            return (n * sumXY - sumX * sumY) / denominator;
+        }
+
+        double predict(double x, double fallbackSlope) const noexcept
+        {
+            const double slope = getSlope(fallbackSlope);
+            return (sumY - slope * sumX) / n + slope * x;
+        }
+    };
+}
+
+//==============================================================================
+BeatGrid BeatTracker::track(const std::vector<float>& onsetEnvelope, const std::vector<float>& lowBandEnvelope,
+                            double bpm, double newFrameRate, double newFirstFrameTime)
+{
+    frameRate = newFrameRate;
+    firstFrameTime = newFirstFrameTime;
+    beatFrames.clear();
+    beatTimes.clear();
+
+    BeatGrid grid;
+    grid.beatsPerBar = juce::jmax(1, options.beatsPerBar);
+
+    const int numFrames = (int)onsetEnvelope.size();
+    const double period = bpm > 0.0 ? 60.0 * frameRate / bpm : 0.0;
+
+    if (period < 2.0 || numFrames < (int)(4.0 * period))
+        return grid;
+
+    // Auf Standardabweichung normieren, damit tightness unabhängig vom Pegel ist
+    double sum = 0.0, sumSquares = 0.0;
+    for (auto value : onsetEnvelope)
+    {
+        sum += value;
+        sumSquares += (double)value * value;
+    }
+
+    const double mean = sum / numFrames;
+    const double deviation = std::sqrt(juce::jmax(0.0, sumSquares / numFrames - mean * mean));
+
+    if (!(deviation > 1.0e-9))
+        return grid;
+
+    normalised.resize((size_t)numFrames);
+    for (int i = 0; i < numFrames; ++i)
+        normalised[(size_t)i] = (float)(onsetEnvelope[(size_t)i] / deviation);
+
+    findBeatFrames(period);
+    alignToLowBand(lowBandEnvelope);
+    trimSilentEnds();
+
+    if (beatFrames.size() < 2)
+        return grid;
+
+    for (auto frame : beatFrames)
+        beatTimes.push_back(firstFrameTime + refineFrame(frame) / frameRate);
+
+    buildSegments(grid, 60.0 / bpm);
+    grid.firstDownbeat = findFirstDownbeat(lowBandEnvelope);
+
+    return grid;
+}
+
+void BeatTracker::findBeatFrames(double period)
+{
+    const int numFrames = (int)normalised.size();
+    const int shortest = juce::jmax(1, juce::roundToInt(0.5 * period));
+    const int longest = juce::roundToInt(2.0 * period);
+
+    std::vector<float> penalty((size_t)longest + 1, 0.0f);
+    for (int distance = shortest; distance <= longest; ++distance)
+    {
+        const double ratio = std::log(distance / period);
+        penalty[(size_t)distance] = (float)(options.tightness * ratio * ratio);
+    }
+
+    cumulativeScore.assign((size_t)numFrames, 0.0f);
+    backlink.assign((size_t)numFrames, -1);
+
+    for (int frame = 0; frame < numFrames; ++frame)
+    {
+        float best = 0.0f;
+        int bestPredecessor = -1;
+
+        for (int predecessor = juce::jmax(0, frame - longest); predecessor <= frame - shortest; ++predecessor)
+        {
+            const float candidate = cumulativeScore[(size_t)predecessor] - penalty[(size_t)(frame - predecessor)];
+
+            if (bestPredecessor < 0 || candidate > best)
+            {
+                best = candidate;
+                bestPredecessor = predecessor;
+            }
+        }
+
+        // Ohne lohnenden Vorgänger beginnt hier eine neue Kette
+        if (best <= 0.0f)
+            bestPredecessor = -1;
+
+        cumulativeScore[(size_t)frame] = normalised[(size_t)frame] + juce::jmax(0.0f, best);
+        backlink[(size_t)frame] = bestPredecessor;
+    }
+
+    // Letzter Schlag: bester Frame in der letzten Periode
+    int frame = numFrames - 1;
+    for (int i = juce::jmax(0, numFrames - juce::roundToInt(period)); i < numFrames; ++i)
+        if (cumulativeScore[(size_t)i] > cumulativeScore[(size_t)frame])
+            frame = i;
+
+    for (; frame >= 0; frame = backlink[(size_t)frame])
+        beatFrames.push_back(frame);
+
+    std::reverse(beatFrames.begin(), beatFrames.end());
+}
+
+void BeatTracker::alignToLowBand(const std::vector<float>& lowBandEnvelope)
+{
+    // Offene Hi-Hats auf den Offbeats haben oft mehr Flux als die Kick, dann rastet
+    // die DP neben den Schlägen ein. Schläge liegen da, wo der Bass ist.
+    const int numLowFrames = juce::jmin((int)lowBandEnvelope.size(), (int)normalised.size());
+
+    if (numLowFrames == 0 || beatFrames.size() < 2)
+        return;
+
+    auto lowBandAt = [&](int frame)
+    {
+        float strength = 0.0f;
+        for (int i = juce::jmax(0, frame - peakSearchFrames); i <= juce::jmin(numLowFrames - 1, frame + peakSearchFrames); ++i)
+            strength = juce::jmax(strength, lowBandEnvelope[(size_t)i]);
+
+        return strength;
+    };
+
+    // Viertel-Versätze mitprüfen: bei Halbtempo (174 -> 87) liegen Hats auf 1/4 und 3/4
+    constexpr int numShifts = 4;
+    double shiftScores[numShifts] = {};
+
+    for (size_t beat = 0; beat + 1 < beatFrames.size(); ++beat)
+        for (int shift = 0; shift < numShifts; ++shift)
+            shiftScores[shift] += lowBandAt(beatFrames[beat] + (beatFrames[beat + 1] - beatFrames[beat]) * shift / numShifts);
+
+    const int bestShift = (int)(std::max_element(shiftScores, shiftScores + numShifts) - shiftScores);
+
+    if (bestShift == 0)
+        return;
+
+    for (size_t beat = 0; beat + 1 < beatFrames.size(); ++beat)
+        beatFrames[beat] += (beatFrames[beat + 1] - beatFrames[beat]) * bestShift / numShifts;
+
+    beatFrames.pop_back();
+}
+
+void BeatTracker::trimSilentEnds()
+{
+    if (beatFrames.empty())
+        return;
+
+    // Intro und Outro ohne Onsets: dort hat die DP nur noch das Tempo weitergezählt
+    auto strengthAt = [this](int frame)
+    {
+        float strength = 0.0f;
+        for (int i = juce::jmax(0, frame - peakSearchFrames); i <= juce::jmin((int)normalised.size() - 1, frame + peakSearchFrames); ++i)
+            strength = juce::jmax(strength, normalised[(size_t)i]);
+
+        return strength;
+    };
+
+    double sumSquares = 0.0;
+    for (auto frame : beatFrames)
+        sumSquares += juce::square((double)strengthAt(frame));
+
+    const float threshold = (float)(0.5 * std::sqrt(sumSquares / (double)beatFrames.size()));
+
+    auto first = beatFrames.begin();
+    auto last = beatFrames.end();
+
+    while (first != last && strengthAt(*first) < threshold)
+        ++first;
+
+    while (last != first && strengthAt(*(last - 1)) < threshold)
+        --last;
+
+    beatFrames = std::vector<int>(first, last);
+}
+
+double BeatTracker::refineFrame(int frame) const noexcept
+{
+    // Auf das nächste Onset-Maximum ziehen, parabolisch zwischen den Frames
+    const int numFrames = (int)normalised.size();
+    int peak = frame;
+
+    for (int i = juce::jmax(1, frame - peakSearchFrames); i <= juce::jmin(numFrames - 2, frame + peakSearchFrames); ++i)
+        if (normalised[(size_t)i] > normalised[(size_t)peak])
+            peak = i;
+
+    if (peak <= 0 || peak >= numFrames - 1)
+        return frame;
+
+    const double left = normalised[(size_t)peak - 1], centre = normalised[(size_t)peak], right = normalised[(size_t)peak + 1];
+    const double curvature = left - 2.0 * centre + right;
+    const double offset = curvature < 0.0 ? 0.5 * (left - right) / curvature : 0.0;
+
+    return peak + juce::jlimit(-0.5, 0.5, offset);
+}
+
+void BeatTracker::buildSegments(BeatGrid& grid, double beatLength) const
+{
+    const int numBeats = (int)beatTimes.size();
+
+    int segmentStart = 0, firstMiss = -1, misses = 0;
+    LineFit fit;
+    fit.add(0.0, beatTimes[0]);
+
+    auto closeSegment = [&](int lastBeat)
+    {
+        BeatGrid::Segment segment;
+        segment.beatLength = juce::jmax(1.0e-3, fit.getSlope(beatLength));
+        segment.startTime = fit.predict(0.0, beatLength);
+        segment.firstBeat = segmentStart;
+        segment.numBeats = lastBeat - segmentStart + 1;
+        grid.segments.push_back(segment);
+    };
+
+    for (int beat = 1; beat < numBeats; ++beat)
+    {
+        const double predicted = fit.predict(beat - segmentStart, beatLength);
+
+        if (std::abs(beatTimes[(size_t)beat] - predicted) <= options.segmentTolerance)
+        {
+            fit.add(beat - segmentStart, beatTimes[(size_t)beat]);
+            misses = 0;
+            continue;
+        }
+
+        if (misses++ == 0)
+            firstMiss = beat;
+
+        // Einzelne Ausreißer ignorieren, erst mehrere in Folge heißen: Tempo hat sich geändert
+        if (misses < options.maxMissedBeats)
+            continue;
+
+        closeSegment(firstMiss - 1);
+
+        segmentStart = firstMiss;
+        fit = LineFit();
+
+        for (int i = firstMiss; i <= beat; ++i)
+            fit.add(i - segmentStart, beatTimes[(size_t)i]);
+
+        misses = 0;
+    }
+
+    closeSegment(numBeats - 1);
+}
+
+int BeatTracker::findFirstDownbeat(const std::vector<float>& lowBandEnvelope) const
+{
+    const int beatsPerBar = juce::jmax(1, options.beatsPerBar);
+
+    if (beatsPerBar == 1)
+        return 0;
+
+    // Bassanteil auf dieselbe Skala wie die normierte Onset-Kurve bringen
+    double lowBandScale = 0.0;
+    const int numLowFrames = juce::jmin((int)lowBandEnvelope.size(), (int)normalised.size());
+
+    if (numLowFrames > 0)
+    {
+        double sumSquares = 0.0;
+        for (int i = 0; i < numLowFrames; ++i)
+            sumSquares += juce::square((double)lowBandEnvelope[(size_t)i]);
+
+        const double rms = std::sqrt(sumSquares / numLowFrames);
+        lowBandScale = rms > 1.0e-9 ? 1.0 / rms : 0.0;
+    }
+
+    std::vector<double> phaseScores((size_t)beatsPerBar, 0.0);
+    std::vector<int> phaseCounts((size_t)beatsPerBar, 0);
+
+    for (size_t beat = 0; beat < beatFrames.size(); ++beat)
+    {
+        const int frame = beatFrames[beat];
+        double lowBand = 0.0, overall = 0.0;
+
+        for (int i = juce::jmax(0, frame - peakSearchFrames); i <= juce::jmin((int)normalised.size() - 1, frame + peakSearchFrames); ++i)
+        {
+            overall = juce::jmax(overall, (double)normalised[(size_t)i]);
+
+            if (i < numLowFrames)
+                lowBand = juce::jmax(lowBand, lowBandEnvelope[(size_t)i] * lowBandScale);
+        }
+
+        const auto phase = beat % (size_t)beatsPerBar;
+        phaseScores[phase] += lowBand + 0.5 * overall;
+        ++phaseCounts[phase];
+    }
+
+    int best = 0;
+    double bestScore = -1.0;
+
+    for (int phase = 0; phase < beatsPerBar; ++phase)
+    {
+        const double score = phaseCounts[(size_t)phase] > 0 ? phaseScores[(size_t)phase] / phaseCounts[(size_t)phase] : 0.0;
+
+        if (score > bestScore)
+        {
+            best = phase;
+            bestScore = score;
+        }
+    }
+
+    return best;
+}
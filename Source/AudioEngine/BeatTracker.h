@@ -0,0 +1,85 @@
+/*
+  ==============================================================================
+
+    BeatTracker.h
+    Created: 16 Oct 2026
+
+    Beat positions for a whole track from its onset envelope and tempo
+    (see OnsetDetector, TempoEstimator):
+
+      1. Dynamic programming over the envelope (Ellis 2007): every frame's
+         score is its onset strength plus the best score of a predecessor
+         between half and twice the beat period back, penalised by
+         tightness * log(interval / period)^2. Backtracking from the best
+         frame in the last period gives the beat sequence that hits the
+         most onsets while staying close to the tempo, and it may follow a
+         drifting tempo.
+      2. If the low band (kick, bass) is stronger a quarter, half or three
+         quarters of a beat later than on the beats, the sequence sits on
+         the off-beats (open hi-hats often have more flux than the kick) and
+         is moved there.
+         Each beat is then moved onto the onset peak next to it (parabolic,
+         sub-frame) and converted to seconds.
+      3. Beats are grouped into constant-tempo segments by a running
+         least-squares line: a new segment starts once several beats in a
+         row are further than the tolerance from the line. Quantized
+         tracks end up as a single segment; the grid beats are taken from
+         the lines, not the individual detections.
+      4. Downbeat: the bar phase (of beatsPerBar) whose beats carry the
+         most low-band (kick/bass) and overall onset energy. A heuristic,
+         good for four-to-the-floor material, the user should be able to
+         shift it.
+
+    Allocates, meant for the analysis threads.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "BeatGrid.h"
+#include <vector>
+
+class BeatTracker
+{
+public:
+    struct Options
+    {
+        double tightness = 100.0;           // Strafe für Abweichung vom Tempo
+        double segmentTolerance = 0.025;    // Sekunden Abstand zur Geraden
+        int maxMissedBeats = 4;             // so viele Ausreißer in Folge = neues Segment
+        int beatsPerBar = 4;
+    };
+
+    BeatTracker() = default;
+    explicit BeatTracker(const Options& newOptions) : options(newOptions) {}
+
+    /**
+        Tracks the beats of an onset envelope at the given tempo. The low-band
+        envelope may be empty (then the downbeat uses the full envelope only).
+        Frame f lies at firstFrameTime + f / frameRate seconds.
+    */
+    BeatGrid track(const std::vector<float>& onsetEnvelope, const std::vector<float>& lowBandEnvelope,
+                   double bpm, double frameRate, double firstFrameTime);
+
+private:
+    void findBeatFrames(double period);
+    void alignToLowBand(const std::vector<float>& lowBandEnvelope);
+    void trimSilentEnds();
+    double refineFrame(int frame) const noexcept;
+    void buildSegments(BeatGrid& grid, double beatLength) const;
+    int findFirstDownbeat(const std::vector<float>& lowBandEnvelope) const;
+
+    Options options;
+    double frameRate = 86.0;
+    double firstFrameTime = 0.0;
+
+    std::vector<float> normalised;     // Onset-Kurve / Standardabweichung
+    std::vector<float> cumulativeScore;
+    std::vector<int> backlink;
+    std::vector<int> beatFrames;
+    std::vector<double> beatTimes;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BeatTracker)
+};
@@ -0,0 +1,290 @@
+/*
+  ==============================================================================
+
+    CompactSampleBuffer.cpp
+    Created: 16 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "CompactSampleBuffer.h"
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+ #include <emmintrin.h>
+ #define RADIOBLAST_COMPACT_SSE2 1
+ #if defined(__F16C__)
+  #include <immintrin.h>
+  #define RADIOBLAST_COMPACT_F16C 1
+ #endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+ #include <arm_neon.h>
+ #define RADIOBLAST_COMPACT_NEON 1
+#endif
+
+namespace
+{
+    float halfToFloat(juce::uint16 half) noexcept
+    {
+        const juce::uint32 sign = (juce::uint32)(half & 0x8000) << 16;
+        const juce::uint32 exponent = (half >> 10) & 0x1f;
+        const juce::uint32 mantissa = half & 0x3ff;
+
+        // Subnormal: Mantisse mal 2^-24
+        if (exponent == 0)
+        {
+            const float value = (float)mantissa * 5.9604645e-8f;
+            return sign != 0 ? -value : value;
+        }
+
+        const juce::uint32 bits = exponent == 31 ? (sign | 0x7f800000 | (mantissa << 13))
+                                                 : (sign | ((exponent + 127 - 15) << 23) | (mantissa << 13));
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    juce::uint16 floatToHalf(float value) noexcept
+    {
+        juce::uint32 bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+
+        const auto sign = (juce::uint16)((bits >> 16) & 0x8000);
+        const float magnitude = std::abs(value);
+
+        // Die Blöcke sind auf +-1 normiert, größer (oder NaN) wird auf das Maximum begrenzt
+        if (!(magnitude < 65504.0f))
+            return (juce::uint16)(sign | 0x7bff);
+
+        if (magnitude < 6.1035156e-5f)
+            return (juce::uint16)(sign | (juce::uint16)std::lrint(magnitude * 16777216.0f));
+
+        // Mantisse von 23 auf 10 Bit, round to nearest even
+        const juce::uint32 absolute = bits & 0x7fffffff;
+        const juce::uint32 rounded = absolute + 0xfff + ((absolute >> 13) & 1);
+        return (juce::uint16)(sign | ((rounded >> 13) - ((127 - 15) << 10)));
+    }
+
+    void convertInt16(const juce::int16* source, float* destination, float scale, int count) noexcept
+    {
+        int i = 0;
+
+       #if RADIOBLAST_COMPACT_SSE2
+        const __m128 factor = _mm_set1_ps(scale);
+
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+
+            // Vorzeichenrichtig auf 32 Bit: in die obere Hälfte schieben, arithmetisch zurück
+            const __m128i low = _mm_srai_epi32(_mm_unpacklo_epi16(packed, packed), 16);
+            const __m128i high = _mm_srai_epi32(_mm_unpackhi_epi16(packed, packed), 16);
+
+            _mm_storeu_ps(destination + i, _mm_mul_ps(_mm_cvtepi32_ps(low), factor));
+            _mm_storeu_ps(destination + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(high), factor));
+        }
+       #elif RADIOBLAST_COMPACT_NEON
+        const float32x4_t factor = vdupq_n_f32(scale);
+
+        for (; i + 8 <= count; i += 8)
+        {
+            const int16x8_t packed = vld1q_s16(source + i);
+
+            vst1q_f32(destination + i, vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(packed))), factor));
+            vst1q_f32(destination + i + 4, vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(packed))), factor));
+        }
+       #endif
+
+        for (; i < count; ++i)
+            destination[i] = (float)source[i] * scale;
+    }
+
+    void convertHalf(const juce::uint16* source, float* destination, float scale, int count) noexcept
+    {
+        int i = 0;
+
+       #if RADIOBLAST_COMPACT_F16C
+        const __m128 factor = _mm_set1_ps(scale);
+
+        for (; i + 4 <= count; i += 4)
+        {
+            const __m128i packed = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(source + i));
+            _mm_storeu_ps(destination + i, _mm_mul_ps(_mm_cvtph_ps(packed), factor));
+        }
+       #elif RADIOBLAST_COMPACT_NEON && defined(__aarch64__)
+        const float32x4_t factor = vdupq_n_f32(scale);
+
+        for (; i + 4 <= count; i += 4)
+            vst1q_f32(destination + i, vmulq_f32(vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(source + i))), factor));
+       #endif
+
+        for (; i < count; ++i)
+            destination[i] = halfToFloat(source[i]) * scale;
+    }
+}
+
+CompactSampleBuffer::CompactSampleBuffer(const juce::AudioBuffer<float>& source, SampleStorage storage, double rate)
+    : format(storage == SampleStorage::float32 ? SampleStorage::int16 : storage)
+    , length(source.getNumSamples())
+    , sampleRate(rate)
+{
+    const int numBlocks = (length + blockFrames - 1) / blockFrames;
+
+    for (int channel = 0; channel < 2; ++channel)
+    {
+        samples[channel].resize((size_t)length);
+        scales[channel].resize((size_t)numBlocks);
+
+        if (source.getNumChannels() == 0)
+        {
+            std::fill(samples[channel].begin(), samples[channel].end(), (juce::uint16)0);
+            continue;
+        }
+
+        const float* input = source.getReadPointer(juce::jmin(channel, source.getNumChannels() - 1));
+
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            const int first = block * blockFrames;
+            const int count = juce::jmin(blockFrames, length - first);
+            const auto range = juce::FloatVectorOperations::findMinAndMax(input + first, count);
+            const float peak = juce::jmax(range.getEnd(), -range.getStart());
+
+            // int16: Blockspitze auf 32767; Half: auf 1.0, damit leise Blöcke nicht in den Subnormalbereich fallen
+            const float scale = peak > 0.0f ? (format == SampleStorage::int16 ? peak / 32767.0f : peak) : 0.0f;
+            const float inverse = scale > 0.0f ? 1.0f / scale : 0.0f;
+            scales[channel][(size_t)block] = scale;
+
+            juce::uint16* output = samples[channel].data() + first;
+
+            for (int i = 0; i < count; ++i)
+            {
+                const float normalised = input[first + i] * inverse;
+
+                if (format == SampleStorage::int16)
+                    output[i] = (juce::uint16)(juce::int16)juce::jlimit(-32767L, 32767L, std::lrint(normalised));
+                else
+                    output[i] = floatToHalf(normalised);
+            }
+        }
+    }
+}
+
+size_t CompactSampleBuffer::getSizeInBytes() const noexcept
+{
+    return 2 * (samples[0].size() * sizeof(juce::uint16) + scales[0].size() * sizeof(float));
+}
+
+void CompactSampleBuffer::convert(int channel, long index, int count, float* destination) const noexcept
+{
+    const juce::uint16* source = samples[channel].data();
+
+    // Blockweise, jeder Block hat seinen eigenen Faktor
+    while (count > 0)
+    {
+        const long block = index / blockFrames;
+        const int run = juce::jmin(count, (int)((block + 1) * blockFrames - index));
+        const float scale = scales[channel][(size_t)block];
+
+        if (format == SampleStorage::int16)
+            convertInt16(reinterpret_cast<const juce::int16*>(source + index), destination, scale, run);
+        else
+            convertHalf(source + index, destination, scale, run);
+
+        index += run;
+        destination += run;
+        count -= run;
+    }
+}
+
+void CompactSampleBuffer::read(long first, int count, float* outL, float* outR, long start, long end, bool looping) const noexcept
+{
+    start = juce::jlimit(0L, (long)length, start);
+    end = juce::jlimit(start, (long)length, end);
+
+    int written = 0;
+
+    while (written < count)
+    {
+        long index = first + written;
+        int run = count - written;
+
+        if (index < start || index >= end)
+        {
+            if (looping && end > start)
+            {
+                index = start + ((index - start) % (end - start) + (end - start)) % (end - start);
+            }
+            else
+            {
+                // Außerhalb der Region: Stille bis zum Regionsanfang bzw. bis zum Ende
+                if (index < start)
+                    run = (int)juce::jmin((long)run, start - index);
+
+                juce::FloatVectorOperations::clear(outL + written, run);
+                juce::FloatVectorOperations::clear(outR + written, run);
+                written += run;
+                continue;
+            }
+        }
+
+        run = (int)juce::jmin((long)run, end - index);
+        convert(0, index, run, outL + written);
+        convert(1, index, run, outR + written);
+        written += run;
+    }
+}
+
+void CompactSampleBuffer::toFloat(juce::AudioBuffer<float>& destination) const
+{
+    destination.setSize(2, juce::jmax(1, length), false, false, true);
+
+    if (length > 0)
+        read(0, length, destination.getWritePointer(0), destination.getWritePointer(1), 0, length, false);
+}
+
+CompactSampleBuffer::Accuracy CompactSampleBuffer::measureAccuracy(const juce::AudioBuffer<float>& reference) const
+{
+    Accuracy accuracy;
+
+    if (reference.getNumChannels() == 0 || reference.getNumSamples() != length)
+        return accuracy;
+
+    constexpr int chunk = 4096;
+    float decoded[2][chunk];
+    double signalEnergy = 0.0, errorEnergy = 0.0;
+
+    for (int first = 0; first < length; first += chunk)
+    {
+        const int count = juce::jmin(chunk, length - first);
+        read(first, count, decoded[0], decoded[1], 0, length, false);
+
+        for (int channel = 0; channel < 2; ++channel)
+        {
+            const float* original = reference.getReadPointer(juce::jmin(channel, reference.getNumChannels() - 1), first);
+
+            for (int i = 0; i < count; ++i)
+            {
+                const float error = decoded[channel][i] - original[i];
+                accuracy.maxError = juce::jmax(accuracy.maxError, std::abs(error));
+                signalEnergy += (double)original[i] * original[i];
+                errorEnergy += (double)error * error;
+            }
+        }
+    }
+
+    accuracy.signalToErrorDb = errorEnergy > 0.0 ? 10.0 * std::log10(signalEnergy / errorEnergy) : 200.0;
+    return accuracy;
+}
+
+juce::String CompactSampleBuffer::getStorageName(SampleStorage storage)
+{
+    switch (storage)
+    {
+        case SampleStorage::int16:   return "16 Bit Integer";
+        case SampleStorage::float16: return "16 Bit Float";
+        case SampleStorage::float32:
+        default:                     return "32 Bit Float";
+    }
+}
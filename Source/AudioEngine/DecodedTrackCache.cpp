@@ -0,0 +1,247 @@
+/*
+  ==============================================================================
+
+    DecodedTrackCache.cpp
+    Created: 16 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "DecodedTrackCache.h"
+#include "DiskTrackCache.h"
+
+DecodedTrackCache& DecodedTrackCache::getInstance()
+{
+    static DecodedTrackCache cache;
+    return cache;
+}
+
+DecodedTrackCache::DecodedTrackCache()
+{
+    // Der Pool muss vor dem Cache entstehen, damit er beim Beenden nach ihm zerstört wird:
+    // die letzten Tracks geben ihre Blöcke erst im Destruktor des Caches zurück
+    SampleMemoryPool::getInstance();
+
+    formatManager.registerBasicFormats();
+}
+
+juce::String DecodedTrackCache::makeKey(const juce::File& file)
+{
+    if (!file.existsAsFile())
+        return {};
+
+    return file.getFullPathName()
+        + "|" + juce::String(file.getSize())
+        + "|" + juce::String(file.getLastModificationTime().toMilliseconds());
+}
+
+DecodedTrackPtr DecodedTrackCache::decode(juce::AudioFormatReader& reader, const ProgressCallback& progress)
+{
+    const auto length = reader.lengthInSamples;
+    if (length <= 0 || length > std::numeric_limits<int>::max())
+        return nullptr;
+
+    auto track = std::make_shared<DecodedTrack>((int)length, reader.sampleRate);
+
+    // In Blöcken lesen, damit Fortschritt gemeldet und abgebrochen werden kann.
+    // Beide Kanäle anfordern: JUCE verdoppelt Mono-Dateien dabei selbst
+    constexpr int blockSize = 1 << 18;
+
+    for (int done = 0; done < (int)length; done += blockSize)
+    {
+        const int count = juce::jmin(blockSize, (int)length - done);
+
+        if (!reader.read(&track->buffer, done, count, done, true, true))
+            return nullptr;
+
+        if (progress != nullptr && !progress((double)(done + count) / (double)length))
+            return nullptr;
+    }
+
+    return track;
+}
+
+DecodedTrackPtr DecodedTrackCache::getOrDecode(const juce::File& file, const ProgressCallback& progress)
+{
+    const auto key = makeKey(file);
+    if (key.isEmpty())
+        return nullptr;
+
+    {
+        std::unique_lock<std::mutex> guard(lock);
+
+        // Läuft für die Datei schon eine Dekodierung, auf deren Ergebnis warten
+        for (;;)
+        {
+            auto existing = entries.find(key);
+            if (existing == entries.end())
+                break;
+
+            if (!existing->second.decoding)
+            {
+                touch(existing->second, key);
+                return existing->second.track;
+            }
+
+            decodeFinished.wait(guard);
+        }
+
+        auto& entry = entries[key];
+        entry.decoding = true;
+        lru.push_front(key);
+        entry.lruPosition = lru.begin();
+    }
+
+    // Liegt die Datei schon als PCM im Plattencache, wird nur kopiert statt dekodiert
+    DecodedTrackPtr track;
+    auto reader = DiskTrackCache::getInstance().createReader(file);
+    const bool fromDisk = reader != nullptr;
+
+    if (!fromDisk)
+        reader.reset(formatManager.createReaderFor(file));
+
+    if (reader != nullptr)
+        track = decode(*reader, progress);
+
+    if (track != nullptr && !fromDisk)
+        DiskTrackCache::getInstance().store(file, track);
+
+    {
+        const std::lock_guard<std::mutex> guard(lock);
+        auto entry = entries.find(key);
+
+        if (track == nullptr || track->getSizeInBytes() > memoryBudget)
+        {
+            // Nicht lesbar oder größer als das ganze Budget: nur an den Aufrufer geben
+            lru.erase(entry->second.lruPosition);
+            entries.erase(entry);
+        }
+        else
+        {
+            entry->second.track = track;
+            entry->second.decoding = false;
+            cachedBytes += track->getSizeInBytes();
+            durations[key] = track->getDuration();
+            evictToBudget(key);
+        }
+    }
+
+    decodeFinished.notify_all();
+    return track;
+}
+
+DecodedTrackPtr DecodedTrackCache::find(const juce::File& file)
+{
+    const auto key = makeKey(file);
+    const std::lock_guard<std::mutex> guard(lock);
+
+    auto entry = entries.find(key);
+    if (entry == entries.end() || entry->second.decoding)
+        return nullptr;
+
+    touch(entry->second, key);
+    return entry->second.track;
+}
+
+double DecodedTrackCache::getDuration(const juce::File& file)
+{
+    const auto key = makeKey(file);
+    if (key.isEmpty())
+        return 0.0;
+
+    {
+        const std::lock_guard<std::mutex> guard(lock);
+
+        auto known = durations.find(key);
+        if (known != durations.end())
+            return known->second;
+    }
+
+    // Nur den Header lesen, nicht dekodieren
+    std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(file));
+    if (reader == nullptr || reader->lengthInSamples <= 0 || reader->sampleRate <= 0.0)
+        return 0.0;
+
+    const double duration = (double)reader->lengthInSamples / reader->sampleRate;
+
+    const std::lock_guard<std::mutex> guard(lock);
+    durations[key] = duration;
+    return duration;
+}
+
+void DecodedTrackCache::touch(Entry& entry, const juce::String& key)
+{
+    lru.erase(entry.lruPosition);
+    lru.push_front(key);
+    entry.lruPosition = lru.begin();
+}
+
+void DecodedTrackCache::evictToBudget(const juce::String& keep)
+{
+    // Von hinten (am längsten unbenutzt) verwerfen, laufende Dekodierungen bleiben
+    auto position = lru.end();
+
+    while (cachedBytes > memoryBudget && position != lru.begin())
+    {
+        --position;
+        auto entry = entries.find(*position);
+
+        if (entry == entries.end() || entry->second.decoding || *position == keep)
+            continue;
+
+        cachedBytes -= entry->second.track->getSizeInBytes();
+        entries.erase(entry);
+        position = lru.erase(position);
+    }
+}
+
+void DecodedTrackCache::releaseIfUnused(const std::weak_ptr<const DecodedTrack>& track)
+{
+    const std::lock_guard<std::mutex> guard(lock);
+
+    for (auto entry = entries.begin(); entry != entries.end(); ++entry)
+    {
+        const auto& held = entry->second.track;
+
+        if (entry->second.decoding || held.owner_before(track) || track.owner_before(held))
+            continue;
+
+        // Noch von jemand anderem benutzt (Waveform, anderer Deck): im Cache lassen
+        if (held.use_count() == 1)
+        {
+            cachedBytes -= held->getSizeInBytes();
+            lru.erase(entry->second.lruPosition);
+            entries.erase(entry);
+        }
+
+        return;
+    }
+}
+
+void DecodedTrackCache::setMemoryBudget(size_t bytes)
+{
+    const std::lock_guard<std::mutex> guard(lock);
+    memoryBudget = bytes;
+    evictToBudget({});
+}
+
+size_t DecodedTrackCache::getMemoryBudget() const
+{
+    const std::lock_guard<std::mutex> guard(lock);
+    return memoryBudget;
+}
+
+size_t DecodedTrackCache::getCachedBytes() const
+{
+    const std::lock_guard<std::mutex> guard(lock);
+    return cachedBytes;
+}
+
+void DecodedTrackCache::clear()
+{
+    const std::lock_guard<std::mutex> guard(lock);
+    const auto budget = memoryBudget;
+    memoryBudget = 0;
+    evictToBudget({});
+    memoryBudget = budget;
+}
@@ -0,0 +1,104 @@
+/*
+  ==============================================================================
+
+    DecodedTrackCache.h
+    Created: 16 Oct 2026
+
+    Process-wide cache of decoded tracks, so the waveform, the BPM analysis,
+    the sample player and a deck reload all share one decode of a file.
+
+    Entries are keyed by path, file size and modification time, so an edited
+    file is decoded again. Tracks are immutable and reference counted: an
+    entry evicted by the LRU stays alive for as long as somebody still holds
+    it. Two threads asking for the same file at once share one decode.
+
+    Decoding blocks the calling thread; call getOrDecode() from a background
+    thread, find() and getDuration() are cheap enough for the message thread.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "SampleMemoryPool.h"
+#include <condition_variable>
+#include <functional>
+#include <limits>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+
+struct DecodedTrack
+{
+    DecodedTrack(int numSamples, double rate)
+        : buffer(2, juce::jmax(1, numSamples)), sampleRate(rate) {}
+
+    double getDuration() const noexcept { return sampleRate > 0.0 ? buffer.getNumSamples() / sampleRate : 0.0; }
+    size_t getSizeInBytes() const noexcept { return (size_t)buffer.getNumChannels() * (size_t)buffer.getNumSamples() * sizeof(float); }
+
+    PooledSampleBuffer buffer;     // immer Stereo, Mono-Dateien auf beiden Kanälen, Originalrate (im Cache)
+    double sampleRate;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DecodedTrack)
+};
+
+using DecodedTrackPtr = std::shared_ptr<const DecodedTrack>;
+
+class DecodedTrackCache
+{
+public:
+    /** Called between decode blocks with the fraction done; returning false cancels the decode. */
+    using ProgressCallback = std::function<bool(double)>;
+
+    static DecodedTrackCache& getInstance();
+
+    /** Returns the decoded file, decoding it first if needed. Blocks; nullptr if the file cannot be read or the decode was cancelled. */
+    DecodedTrackPtr getOrDecode(const juce::File& file, const ProgressCallback& progress = nullptr);
+
+    /** Returns the decoded file only if it is already cached, never decodes. */
+    DecodedTrackPtr find(const juce::File& file);
+
+    /** Length in seconds, from the cache if possible, otherwise from the file header. */
+    double getDuration(const juce::File& file);
+
+    /** Decodes one stream without caching it, e.g. for data that has no file. */
+    static DecodedTrackPtr decode(juce::AudioFormatReader& reader, const ProgressCallback& progress = nullptr);
+
+    /** Drops the entry holding track if only the cache still uses it, e.g. once a deck plays a compact copy. */
+    void releaseIfUnused(const std::weak_ptr<const DecodedTrack>& track);
+
+    void setMemoryBudget(size_t bytes);
+    size_t getMemoryBudget() const;
+    size_t getCachedBytes() const;
+
+    void clear();
+
+private:
+    DecodedTrackCache();
+
+    struct Entry
+    {
+        DecodedTrackPtr track;
+        bool decoding = false;
+        std::list<juce::String>::iterator lruPosition;
+    };
+
+    static juce::String makeKey(const juce::File& file);
+
+    void touch(Entry& entry, const juce::String& key);
+    void evictToBudget(const juce::String& keep);
+
+    juce::AudioFormatManager formatManager;
+
+    mutable std::mutex lock;
+    std::condition_variable decodeFinished;
+    std::map<juce::String, Entry> entries;
+    std::list<juce::String> lru;                  // vorne = zuletzt benutzt
+    std::map<juce::String, double> durations;     // nur Header gelesen
+    size_t cachedBytes = 0;
+    size_t memoryBudget = (size_t)512 * 1024 * 1024;
+
+    JUCE_DECLARE_NON_COPYABLE(DecodedTrackCache)
+};
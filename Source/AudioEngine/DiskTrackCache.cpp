@@ -0,0 +1,249 @@
+/*
+  ==============================================================================
+
+    DiskTrackCache.cpp
+    Created: 16 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "DiskTrackCache.h"
+#include <algorithm>
+#include <vector>
+
+DiskTrackCache& DiskTrackCache::getInstance()
+{
+    static DiskTrackCache cache;
+    return cache;
+}
+
+DiskTrackCache::DiskTrackCache()
+    : juce::Thread("Disk Track Cache")
+    , directory(juce::File::getSpecialLocation(juce::File::userHomeDirectory).getChildFile(".RadioBlast/cache"))
+{
+    // Vor dem Cache anlegen, damit der Pool ihn überlebt (siehe DecodedTrackCache)
+    SampleMemoryPool::getInstance();
+
+    startThread(juce::Thread::Priority::low);
+}
+
+DiskTrackCache::~DiskTrackCache()
+{
+    stopThread(4000);
+}
+
+bool DiskTrackCache::shouldCache(const juce::File& source)
+{
+    // WAV und AIFF sind schon PCM, da wäre der Cache nur eine Kopie
+    return source.existsAsFile() && source.hasFileExtension("mp3;ogg;flac;m4a;aac;wma");
+}
+
+juce::File DiskTrackCache::getDataFile(const juce::File& source) const
+{
+    return directory.getChildFile(juce::String::toHexString(source.getFullPathName().hashCode64()) + ".wav");
+}
+
+juce::File DiskTrackCache::getHeaderFile(const juce::File& source) const
+{
+    return getDataFile(source).withFileExtension("xml");
+}
+
+bool DiskTrackCache::isValid(const juce::File& source, const juce::File& header) const
+{
+    auto xml = juce::XmlDocument::parse(header);
+
+    // Pfad mitvergleichen, zwei Dateien können denselben Hash haben
+    return xml != nullptr
+        && xml->hasTagName("DECODEDTRACK")
+        && xml->getStringAttribute("source") == source.getFullPathName()
+        && xml->getStringAttribute("size").getLargeIntValue() == source.getSize()
+        && xml->getStringAttribute("modified").getLargeIntValue() == source.getLastModificationTime().toMilliseconds();
+}
+
+std::unique_ptr<juce::AudioFormatReader> DiskTrackCache::createReader(const juce::File& source)
+{
+    if (!shouldCache(source))
+        return nullptr;
+
+    const auto data = getDataFile(source);
+    const auto header = getHeaderFile(source);
+
+    if (!data.existsAsFile() || !isValid(source, header))
+        return nullptr;
+
+    juce::WavAudioFormat wavFormat;
+    std::unique_ptr<juce::MemoryMappedAudioFormatReader> reader(wavFormat.createMemoryMappedReader(data));
+
+    if (reader == nullptr || reader->lengthInSamples <= 0 || !reader->mapEntireFile())
+        return nullptr;
+
+    // Zugriffszeit ist die Reihenfolge für die Eviction
+    header.setLastAccessTime(juce::Time::getCurrentTime());
+
+    return reader;
+}
+
+void DiskTrackCache::store(const juce::File& source, DecodedTrackPtr track)
+{
+    if (track == nullptr || !shouldCache(source))
+        return;
+
+    {
+        const std::lock_guard<std::mutex> guard(lock);
+        pending.push_back({ source, std::move(track) });
+    }
+
+    notify();
+}
+
+void DiskTrackCache::setSizeLimit(juce::int64 bytes)
+{
+    {
+        const std::lock_guard<std::mutex> guard(lock);
+        sizeLimit = bytes;
+        evictionNeeded = true;
+    }
+
+    notify();
+}
+
+juce::int64 DiskTrackCache::getSizeLimit() const
+{
+    const std::lock_guard<std::mutex> guard(lock);
+    return sizeLimit;
+}
+
+void DiskTrackCache::run()
+{
+    while (!threadShouldExit())
+    {
+        Job job;
+        bool evict = false;
+
+        {
+            const std::lock_guard<std::mutex> guard(lock);
+
+            if (!pending.empty())
+            {
+                job = std::move(pending.front());
+                pending.pop_front();
+            }
+            else if (evictionNeeded)
+            {
+                evict = true;
+                evictionNeeded = false;
+            }
+        }
+
+        if (job.track != nullptr)
+            write(job);
+        else if (evict)
+            evictToLimit();
+        else
+            wait(-1);
+    }
+}
+
+void DiskTrackCache::write(const Job& job)
+{
+    const auto data = getDataFile(job.source);
+    const auto header = getHeaderFile(job.source);
+
+    if (data.existsAsFile() && isValid(job.source, header))
+        return;
+
+    if (directory.createDirectory().failed())
+        return;
+
+    // Header zuerst weg, damit während des Schreibens niemand alte Daten für gültig hält
+    header.deleteFile();
+
+    const auto& track = *job.track;
+    juce::TemporaryFile temp(data);
+
+    {
+        auto output = std::make_unique<juce::FileOutputStream>(temp.getFile());
+        if (output->failedToOpen())
+            return;
+
+        // 32 Bit schreibt JUCE als Float-WAV, also ohne Rundung gegenüber dem Decode
+        juce::WavAudioFormat wavFormat;
+        std::unique_ptr<juce::AudioFormatWriter> writer(
+            wavFormat.createWriterFor(output.get(), track.sampleRate, (unsigned int)track.buffer.getNumChannels(), 32, {}, 0));
+
+        if (writer == nullptr)
+            return;
+
+        output.release(); // gehört jetzt dem Writer
+
+        if (!writer->writeFromAudioSampleBuffer(track.buffer, 0, track.buffer.getNumSamples()))
+            return;
+    }
+
+    if (!temp.overwriteTargetFileWithTemporary())
+        return;
+
+    juce::XmlElement xml("DECODEDTRACK");
+    xml.setAttribute("source", job.source.getFullPathName());
+    xml.setAttribute("size", juce::String(job.source.getSize()));
+    xml.setAttribute("modified", juce::String(job.source.getLastModificationTime().toMilliseconds()));
+    xml.setAttribute("sampleRate", track.sampleRate);
+    xml.setAttribute("length", track.buffer.getNumSamples());
+
+    if (!xml.writeTo(header, juce::XmlElement::TextFormat().singleLine()))
+    {
+        data.deleteFile();
+        return;
+    }
+
+    const std::lock_guard<std::mutex> guard(lock);
+    evictionNeeded = true;
+}
+
+void DiskTrackCache::evictToLimit()
+{
+    struct CachedFile
+    {
+        juce::File data;
+        juce::File header;
+        juce::int64 size;
+        juce::Time lastAccess;
+    };
+
+    std::vector<CachedFile> files;
+    juce::int64 totalSize = 0;
+
+    for (const auto& entry : juce::RangedDirectoryIterator(directory, false, "*.wav", juce::File::findFiles))
+    {
+        const auto data = entry.getFile();
+        const auto header = data.withFileExtension("xml");
+
+        // Ohne Header (abgebrochener Schreibvorgang) ist der Eintrag wertlos
+        if (!header.existsAsFile())
+        {
+            data.deleteFile();
+            continue;
+        }
+
+        files.push_back({ data, header, data.getSize(), header.getLastAccessTime() });
+        totalSize += files.back().size;
+    }
+
+    const auto limit = getSizeLimit();
+    if (totalSize <= limit)
+        return;
+
+    std::sort(files.begin(), files.end(), [](const CachedFile& a, const CachedFile& b) { return a.lastAccess < b.lastAccess; });
+
+    for (const auto& file : files)
+    {
+        if (totalSize <= limit || threadShouldExit())
+            break;
+
+        // Unter Windows schlägt das Löschen fehl, solange ein Deck die Datei gemappt hat
+        file.header.deleteFile();
+
+        if (file.data.deleteFile())
+            totalSize -= file.size;
+    }
+}
@@ -0,0 +1,77 @@
+/*
+  ==============================================================================
+
+    DiskTrackCache.h
+    Created: 16 Oct 2026
+
+    Persistent PCM cache under ~/.RadioBlast/cache for compressed files
+    (MP3, OGG, FLAC, M4A). After the first decode a track is written as a
+    32 bit float WAV next to a small XML header holding the source path,
+    size, modification time and sample rate. The next load opens that file
+    through a MemoryMappedAudioFormatReader, so it costs an mmap instead of
+    a decode. Tracks are stored at their own rate; the deck bridges to the
+    device rate while rendering, so one entry serves every device setup.
+
+    Writing and eviction run on a background thread. When the directory
+    grows past the size limit, the least recently opened entries are
+    deleted first.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "DecodedTrackCache.h"
+#include <deque>
+#include <memory>
+#include <mutex>
+
+class DiskTrackCache : private juce::Thread
+{
+public:
+    static DiskTrackCache& getInstance();
+
+    ~DiskTrackCache() override;
+
+    /** True for formats that are slow enough to decode that caching them pays off. */
+    static bool shouldCache(const juce::File& source);
+
+    /** Opens the cached PCM for source as a fully mapped reader, nullptr if there is no valid entry. */
+    std::unique_ptr<juce::AudioFormatReader> createReader(const juce::File& source);
+
+    /** Queues a decoded track for writing; returns immediately. */
+    void store(const juce::File& source, DecodedTrackPtr track);
+
+    void setSizeLimit(juce::int64 bytes);
+    juce::int64 getSizeLimit() const;
+
+    juce::File getDirectory() const { return directory; }
+
+private:
+    DiskTrackCache();
+
+    struct Job
+    {
+        juce::File source;
+        DecodedTrackPtr track;
+    };
+
+    void run() override;
+
+    void write(const Job& job);
+    void evictToLimit();
+    bool isValid(const juce::File& source, const juce::File& header) const;
+
+    juce::File getDataFile(const juce::File& source) const;
+    juce::File getHeaderFile(const juce::File& source) const;
+
+    const juce::File directory;
+
+    mutable std::mutex lock;
+    std::deque<Job> pending;
+    juce::int64 sizeLimit = (juce::int64)4 * 1024 * 1024 * 1024;
+    bool evictionNeeded = true;                 // beim Start einmal aufräumen
+
+    JUCE_DECLARE_NON_COPYABLE(DiskTrackCache)
+};
@@ -0,0 +1,154 @@
+/*
+  ==============================================================================
+
+    DspLoadMonitor.cpp
+    Created: 16 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "DspLoadMonitor.h"
+#include <algorithm>
+#include <cmath>
+
+DspLoadMonitor::DspLoadMonitor()
+    : history((size_t)historySize)
+    , sortScratch((size_t)historySize)
+{
+}
+
+void DspLoadMonitor::beginBlock(int numSamples) noexcept
+{
+    current.ticks.fill(0);
+    current.numSamples = numSamples;
+    current.sampleRate = sampleRate.load(std::memory_order_relaxed);
+    blockStart = juce::Time::getHighResolutionTicks();
+}
+
+void DspLoadMonitor::endBlock() noexcept
+{
+    current.totalTicks = juce::Time::getHighResolutionTicks() - blockStart;
+
+    // Voller Ring: lieber den Messwert verlieren als auf die UI warten
+    int start1, size1, start2, size2;
+    fifo.prepareToWrite(1, start1, size1, start2, size2);
+
+    if (size1 == 0)
+    {
+        droppedBlocks.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    ring[(size_t)start1] = current;
+    fifo.finishedWrite(1);
+}
+
+DspLoadMonitor::Snapshot DspLoadMonitor::collect()
+{
+    const double msPerTick = 1000.0 / (double)juce::Time::getHighResolutionTicksPerSecond();
+
+    int start1, size1, start2, size2;
+    fifo.prepareToRead(fifo.getNumReady(), start1, size1, start2, size2);
+
+    auto consume = [this, msPerTick](const BlockRecord& record)
+    {
+        auto& entry = history[(size_t)historyWrite];
+
+        for (int stage = 0; stage < numStages; ++stage)
+            entry[(size_t)stage] = (float)((double)record.ticks[(size_t)stage] * msPerTick);
+
+        const double budgetMs = record.sampleRate > 0.0 ? 1000.0 * record.numSamples / record.sampleRate : 0.0;
+        entry[numStages] = (float)((double)record.totalTicks * msPerTick);
+        entry[numStages + 1] = (float)budgetMs;
+
+        if (budgetMs > 0.0 && entry[numStages] > budgetMs)
+            ++deadlineMisses;
+
+        historyWrite = (historyWrite + 1) % historySize;
+        historyCount = juce::jmin(historyCount + 1, historySize);
+    };
+
+    for (int i = 0; i < size1; ++i)
+        consume(ring[(size_t)(start1 + i)]);
+
+    for (int i = 0; i < size2; ++i)
+        consume(ring[(size_t)(start2 + i)]);
+
+    fifo.finishedRead(size1 + size2);
+
+    Snapshot snapshot;
+    snapshot.numBlocks = historyCount;
+    snapshot.deadlineMisses = deadlineMisses;
+    snapshot.droppedBlocks = droppedBlocks.load(std::memory_order_relaxed) - droppedAtReset;
+
+    if (historyCount == 0)
+        return snapshot;
+
+    auto statsFor = [this](int column)
+    {
+        StageStats stats;
+        double sum = 0.0;
+
+        for (int i = 0; i < historyCount; ++i)
+        {
+            sortScratch[(size_t)i] = history[(size_t)i][(size_t)column];
+            sum += sortScratch[(size_t)i];
+        }
+
+        const auto first = sortScratch.begin();
+        const auto last = first + historyCount;
+        const auto p99 = first + juce::jmin(historyCount - 1, (int)std::ceil(0.99 * historyCount) - 1);
+
+        std::nth_element(first, p99, last);
+        stats.p99Ms = *p99;
+
+        const auto range = std::minmax_element(first, last);
+        stats.minMs = *range.first;
+        stats.maxMs = *range.second;
+        stats.meanMs = sum / historyCount;
+        return stats;
+    };
+
+    for (int stage = 0; stage < numStages; ++stage)
+        snapshot.stages[(size_t)stage] = statsFor(stage);
+
+    snapshot.callback = statsFor(numStages);
+
+    const double meanBudget = statsFor(numStages + 1).meanMs;
+    const int newest = (historyWrite + historySize - 1) % historySize;
+    snapshot.budgetMs = history[(size_t)newest][numStages + 1];
+    snapshot.loadPercent = meanBudget > 0.0 ? 100.0 * snapshot.callback.meanMs / meanBudget : 0.0;
+
+    return snapshot;
+}
+
+void DspLoadMonitor::reset()
+{
+    collect();
+
+    historyWrite = 0;
+    historyCount = 0;
+    deadlineMisses = 0;
+    droppedAtReset = droppedBlocks.load(std::memory_order_relaxed);
+}
+
+juce::String DspLoadMonitor::getStageName(Stage stage)
+{
+    switch (stage)
+    {
+        case deckA:         return "Deck A";
+        case deckB:         return "Deck B";
+        case samplePlayer:  return "Sample Player";
+        case routing:       return "Routing";
+        case fxFilter:      return "FX Filter";
+        case fxEQ:          return "FX EQ";
+        case fxChorus:      return "FX Chorus";
+        case fxReverb:      return "FX Reverb";
+        case fxMasterGain:  return "FX Master Gain";
+        case stutter:       return "Stutter";
+        case lineInputs:    return "Line Inputs";
+        case metering:      return "Metering";
+        case numStages:
+        default:            return {};
+    }
+}
@@ -0,0 +1,149 @@
+/*
+  ==============================================================================
+
+    DspLoadMonitor.h
+    Created: 16 Oct 2026
+
+    Per-stage timing of the audio callback. The audio thread brackets the
+    callback with a ScopedBlock and each stage with a ScopedStage; the
+    durations (high resolution ticks, summed over the slices of one
+    callback) go into one record per callback, which is pushed into a
+    lock-free single producer / single consumer ring. Nothing is allocated
+    or locked on the audio thread; when the ring is full the record is
+    dropped and counted.
+
+    The message thread drains the ring with collect() and gets min, mean,
+    99th percentile and max per stage over the last historySize callbacks,
+    plus the number of callbacks that took longer than their own duration
+    (deadline misses).
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <vector>
+
+class DspLoadMonitor
+{
+public:
+    enum Stage
+    {
+        deckA = 0,
+        deckB,
+        samplePlayer,
+        routing,
+        fxFilter,
+        fxEQ,
+        fxChorus,
+        fxReverb,
+        fxMasterGain,
+        stutter,
+        lineInputs,
+        metering,
+        numStages
+    };
+
+    struct StageStats
+    {
+        double minMs = 0.0;
+        double meanMs = 0.0;
+        double p99Ms = 0.0;
+        double maxMs = 0.0;
+    };
+
+    struct Snapshot
+    {
+        std::array<StageStats, numStages> stages;
+        StageStats callback;                // ganzer Callback inklusive allem, was keiner Stage gehört
+        double budgetMs = 0.0;              // Dauer des letzten Blocks in Echtzeit
+        double loadPercent = 0.0;           // mittlere Callback-Zeit / mittlere Blockdauer
+        int numBlocks = 0;                  // Callbacks im Fenster
+        juce::int64 deadlineMisses = 0;     // seit dem letzten reset()
+        juce::int64 droppedBlocks = 0;
+    };
+
+    static constexpr int ringSize = 1024;
+    static constexpr int historySize = 2048;
+
+    DspLoadMonitor();
+
+    /** Call from prepareToPlay, before the callbacks for the new rate start. */
+    void prepare(double newSampleRate) noexcept { sampleRate = newSampleRate; }
+
+    //==============================================================================
+    // Audio thread
+
+    class ScopedBlock
+    {
+    public:
+        ScopedBlock(DspLoadMonitor& monitorToUse, int numSamples) noexcept : monitor(monitorToUse) { monitor.beginBlock(numSamples); }
+        ~ScopedBlock() noexcept { monitor.endBlock(); }
+
+    private:
+        DspLoadMonitor& monitor;
+        JUCE_DECLARE_NON_COPYABLE(ScopedBlock)
+    };
+
+    class ScopedStage
+    {
+    public:
+        ScopedStage(DspLoadMonitor& monitorToUse, Stage stageToMeasure) noexcept
+            : monitor(monitorToUse), stage(stageToMeasure), start(juce::Time::getHighResolutionTicks()) {}
+
+        ~ScopedStage() noexcept { monitor.current.ticks[(size_t)stage] += juce::Time::getHighResolutionTicks() - start; }
+
+    private:
+        DspLoadMonitor& monitor;
+        const Stage stage;
+        const juce::int64 start;
+        JUCE_DECLARE_NON_COPYABLE(ScopedStage)
+    };
+
+    //==============================================================================
+    // Message thread
+
+    /** Drains the ring and returns the statistics over the current window. */
+    Snapshot collect();
+
+    /** Clears the window and the counters; the ring is drained, not reset. */
+    void reset();
+
+    static juce::String getStageName(Stage stage);
+
+private:
+    struct BlockRecord
+    {
+        std::array<juce::int64, numStages> ticks {};
+        juce::int64 totalTicks = 0;
+        int numSamples = 0;
+        double sampleRate = 0.0;
+    };
+
+    void beginBlock(int numSamples) noexcept;
+    void endBlock() noexcept;
+
+    std::atomic<double> sampleRate { 44100.0 };
+
+    // Audio Thread
+    BlockRecord current;
+    juce::int64 blockStart = 0;
+
+    // SPSC Ring, Audio Thread -> Message Thread
+    std::array<BlockRecord, ringSize> ring;
+    juce::AbstractFifo fifo { ringSize };
+    std::atomic<juce::int64> droppedBlocks { 0 };
+
+    // Message Thread: Fenster der letzten Callbacks, in ms
+    std::vector<std::array<float, numStages + 2>> history;  // Stages, Callback, Blockdauer
+    int historyWrite = 0;
+    int historyCount = 0;
+    juce::int64 deadlineMisses = 0;
+    juce::int64 droppedAtReset = 0;
+    std::vector<float> sortScratch;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DspLoadMonitor)
+};
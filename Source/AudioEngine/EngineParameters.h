@@ -0,0 +1,154 @@
+/*
+  ==============================================================================
+
+    EngineParameters.h
+    Created: 16 Oct 2026
+
+    Plain snapshot of every control the mixer callback needs, plus the
+    triple buffer that hands it from the message thread to the audio thread.
+    The UI fills a snapshot and publishes it whenever a widget changes; the
+    audio thread picks up the newest one once per block and never touches a
+    Slider or ComboBox.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+
+struct EngineParameters
+{
+    // Wohin ein Deck geroutet wird (Output-ComboBox im Mixer)
+    enum class OutputDestination
+    {
+        MasterLeft,
+        MasterRight,
+        CueLeft,
+        CueRight,
+        Muted
+    };
+
+    struct Deck
+    {
+        float channelGain = 1.0f;   // Kanal-Fader
+        float masterGain = 1.0f;    // Kanal-Fader * Crossfader
+        double pitch = 1.0;         // Abspielrate, 1.0 = Original
+        bool keyLock = false;       // pitch ändert nur das Tempo (TimeStretcher)
+        OutputDestination destination = OutputDestination::MasterLeft;
+        bool routedToMaster = true;
+        bool routedToCue = false;
+    };
+
+    struct Filter
+    {
+        float cutoff = 1000.0f;
+        float resonance = 0.7f;
+        float drive = 1.0f;
+        int type = 0;               // 0 = LP, 1 = HP, 2 = BP
+        bool bypass = false;
+    };
+
+    struct EQ
+    {
+        float lowGainDb = 0.0f;
+        float midGainDb = 0.0f;
+        float highGainDb = 0.0f;
+        float lowFreq = 200.0f;
+        float highFreq = 8000.0f;
+        bool bypass = false;
+
+        // Vom Message Thread vorberechnet (MasterEQ::computeCoefficients), gültig für coefficientSampleRate
+        std::array<float, 6> lowShelfCoefficients {};
+        std::array<float, 6> peakCoefficients {};
+        std::array<float, 6> highShelfCoefficients {};
+        double coefficientSampleRate = 0.0;
+    };
+
+    struct Chorus
+    {
+        float rate = 2.0f;
+        float depth = 0.5f;
+        float feedback = 0.3f;
+        float mix = 0.4f;
+        bool bypass = false;
+    };
+
+    struct Reverb
+    {
+        float roomSize = 0.5f;
+        float damping = 0.5f;
+        float wetLevel = 0.3f;
+        float dryLevel = 1.0f;
+        float width = 1.0f;
+        bool bypass = false;
+    };
+
+    static bool sameSettings(const Filter& a, const Filter& b) noexcept
+    {
+        return a.cutoff == b.cutoff && a.resonance == b.resonance && a.drive == b.drive && a.type == b.type;
+    }
+
+    static bool sameSettings(const Chorus& a, const Chorus& b) noexcept
+    {
+        return a.rate == b.rate && a.depth == b.depth && a.feedback == b.feedback && a.mix == b.mix;
+    }
+
+    static bool sameSettings(const Reverb& a, const Reverb& b) noexcept
+    {
+        return a.roomSize == b.roomSize && a.damping == b.damping && a.wetLevel == b.wetLevel
+            && a.dryLevel == b.dryLevel && a.width == b.width;
+    }
+
+    std::array<Deck, 2> decks;      // 0 = Deck A (links), 1 = Deck B (rechts)
+    Filter filter;
+    EQ eq;
+    Chorus chorus;
+    Reverb reverb;
+    float masterVolumeDb = 0.0f;
+};
+
+//==============================================================================
+/**
+    Single-producer / single-consumer triple buffer for EngineParameters.
+
+    publish() is called from the message thread only, acquire() from the audio
+    thread only. Neither side ever waits or allocates: the writer fills its
+    private back slot and swaps it with the shared middle slot, the reader swaps
+    the middle slot into its front slot when the dirty flag is set. The
+    reference returned by acquire() stays valid until the next acquire().
+*/
+class EngineParameterStore
+{
+public:
+    EngineParameterStore() = default;
+
+    /** Message thread: makes a complete snapshot visible to the audio thread. */
+    void publish(const EngineParameters& newParameters) noexcept
+    {
+        slots[(size_t)backIndex] = newParameters;
+        backIndex = middle.exchange(backIndex | dirtyFlag, std::memory_order_acq_rel) & indexMask;
+    }
+
+    /** Audio thread: the newest published snapshot (or the previous one if nothing changed). */
+    const EngineParameters& acquire() noexcept
+    {
+        if ((middle.load(std::memory_order_relaxed) & dirtyFlag) != 0)
+            frontIndex = middle.exchange(frontIndex, std::memory_order_acq_rel) & indexMask;
+
+        return slots[(size_t)frontIndex];
+    }
+
+private:
+    static constexpr int dirtyFlag = 4;
+    static constexpr int indexMask = 3;
+
+    std::array<EngineParameters, 3> slots;
+    std::atomic<int> middle { 1 };
+    int backIndex = 2;   // nur Message Thread
+    int frontIndex = 0;  // nur Audio Thread
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EngineParameterStore)
+};
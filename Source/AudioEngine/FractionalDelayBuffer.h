@@ -9,7 +9,7 @@
 #ifndef FRACTIONALDELAYBUFFER_H_INCLUDED
 #define FRACTIONALDELAYBUFFER_H_INCLUDED
 
-#include "../JuceLibraryCode/JuceHeader.h"
+#include <JuceHeader.h>
 #include <iostream>
 
 class FractionalDelayBuffer
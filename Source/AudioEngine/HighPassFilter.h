@@ -14,7 +14,7 @@
 #include "Modulator.h"
 #include "ModTarget.h"
 
-#include "../JuceLibraryCode/JuceHeader.h"
+#include <JuceHeader.h>
 
 class HighPassFilter : public Filter, public ModTarget {
     
@@ -0,0 +1,117 @@
+/*
+  ==============================================================================
+
+    LevelMeterSource.h
+    Created: 16 Oct 2026
+
+    Stereo peak / RMS accumulator between the audio thread and a meter.
+    The audio thread adds every block it renders, the meter's timer polls a
+    channel and gets peak and RMS since its previous poll. Both sides only
+    touch atomics, so nothing is posted to the message queue and nothing
+    allocates or locks on the audio thread.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <cmath>
+
+class LevelMeterSource
+{
+public:
+    static constexpr int numChannels = 2;
+
+    struct Reading
+    {
+        float peak = 0.0f;
+        float rms = 0.0f;
+    };
+
+    LevelMeterSource() = default;
+
+    //==============================================================================
+    // Audio thread
+
+    void addBlock(const float* left, const float* right, int numSamples) noexcept
+    {
+        if (numSamples <= 0)
+            return;
+
+        addChannel(channels[0], left, numSamples);
+        addChannel(channels[1], right, numSamples);
+    }
+
+    //==============================================================================
+    // Message thread
+
+    /** Peak and RMS of one channel since the previous poll of that channel, then starts over. */
+    Reading poll(int channel) noexcept
+    {
+        auto& accumulator = channels[(size_t)channel];
+
+        Reading reading;
+        reading.peak = accumulator.peak.exchange(0.0f, std::memory_order_relaxed);
+
+        const auto sumOfSquares = accumulator.sumOfSquares.exchange(0.0, std::memory_order_relaxed);
+        const auto numSamples = accumulator.numSamples.exchange(0, std::memory_order_relaxed);
+
+        if (numSamples > 0)
+            reading.rms = (float)std::sqrt(sumOfSquares / (double)numSamples);
+
+        return reading;
+    }
+
+    /** Both channels together: the larger peak and the larger RMS. */
+    Reading pollBoth() noexcept
+    {
+        const auto left = poll(0);
+        const auto right = poll(1);
+        return { juce::jmax(left.peak, right.peak), juce::jmax(left.rms, right.rms) };
+    }
+
+    void reset() noexcept
+    {
+        for (int channel = 0; channel < numChannels; ++channel)
+            poll(channel);
+    }
+
+private:
+    struct Accumulator
+    {
+        std::atomic<float> peak { 0.0f };
+        std::atomic<double> sumOfSquares { 0.0 };
+        std::atomic<juce::int64> numSamples { 0 };
+    };
+
+    static void addChannel(Accumulator& accumulator, const float* data, int numSamples) noexcept
+    {
+        float blockPeak = 0.0f;
+        double blockSum = 0.0;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float sample = data[i];
+            blockPeak = juce::jmax(blockPeak, std::abs(sample));
+            blockSum += (double)(sample * sample);
+        }
+
+        // CAS statt load/store, sonst überschreibt der Audio-Thread ein gleichzeitiges poll().
+        // Summe und Anzahl werden getrennt getauscht; ein Block kann so einmal zur Hälfte
+        // in den nächsten Messwert rutschen, für ein Meter egal.
+        auto peak = accumulator.peak.load(std::memory_order_relaxed);
+        while (blockPeak > peak && !accumulator.peak.compare_exchange_weak(peak, blockPeak, std::memory_order_relaxed)) {}
+
+        auto sum = accumulator.sumOfSquares.load(std::memory_order_relaxed);
+        while (!accumulator.sumOfSquares.compare_exchange_weak(sum, sum + blockSum, std::memory_order_relaxed)) {}
+
+        accumulator.numSamples.fetch_add(numSamples, std::memory_order_relaxed);
+    }
+
+    std::array<Accumulator, numChannels> channels;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LevelMeterSource)
+};
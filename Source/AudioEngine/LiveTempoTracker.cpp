@@ -0,0 +1,190 @@
+/*
+  ==============================================================================
+
+    LiveTempoTracker.cpp
+    Created: 16 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "LiveTempoTracker.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    constexpr int maxCandidates = 5;
+    constexpr double minWindowShare = 0.5;  // erste Schätzung, sobald der Ring halb voll ist
+}
+
+//==============================================================================
+void LiveTempoTracker::prepare(double sampleRate, int maximumBlockSize, const Options& newOptions)
+{
+    const std::lock_guard<std::mutex> guard(estimateLock);
+
+    options = newOptions;
+    maxBlockSize = juce::jmax(1, maximumBlockSize);
+
+    onsetDetector.prepare(sampleRate);
+    onsetDetector.reset();
+
+    const double frameRate = onsetDetector.getFrameRate();
+    windowFrames = juce::jmax(16, juce::roundToInt(options.windowSeconds * frameRate));
+    hopFrames = juce::jmax(1, juce::roundToInt(options.hopSeconds * frameRate));
+    minFrames = juce::jmin(windowFrames, juce::roundToInt(minWindowShare * windowFrames));
+
+    TempoEstimator::Options tempoOptions;
+    tempoOptions.minBPM = options.minBPM;
+    tempoOptions.maxBPM = options.maxBPM;
+    tempoEstimator.prepare(windowFrames, frameRate, tempoOptions);
+
+    blockFrames.assign((size_t)onsetDetector.getMaxFramesForSamples(maxBlockSize), 0.0f);
+
+    // Ein ganzes Fenster Vorrat, falls update() einmal länger ausbleibt
+    fifoFrames.assign((size_t)windowFrames + 1, 0.0f);
+    fifo.setTotalSize(windowFrames + 1);
+    fifo.reset();
+
+    ring.assign((size_t)windowFrames, 0.0f);
+    window.assign((size_t)windowFrames, 0.0f);
+    candidates.assign((size_t)maxCandidates, {});
+
+    ringPosition = 0;
+    framesInRing = 0;
+    framesSinceEstimate = 0;
+
+    currentBPM = 0.0;
+    pendingBPM = 0.0;
+    pendingHops = 0;
+
+    publishedBPM.store(0.0, std::memory_order_relaxed);
+    publishedConfidence.store(0.0, std::memory_order_relaxed);
+}
+
+//==============================================================================
+void LiveTempoTracker::process(const float* const* channels, int numChannels, int numSamples) noexcept
+{
+    if (fifoFrames.empty() || numChannels <= 0)
+        return;
+
+    numChannels = juce::jmin(numChannels, maxChannels);
+
+    // Größere Blöcke als vorbereitet in Stücken, der Onset-Puffer ist auf maxBlockSize bemessen
+    for (int start = 0; start < numSamples; start += maxBlockSize)
+    {
+        const int count = juce::jmin(maxBlockSize, numSamples - start);
+        const float* chunk[maxChannels];
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            chunk[channel] = channels[channel] + start;
+
+        const int numFrames = onsetDetector.process(chunk, numChannels, count, blockFrames.data(), (int)blockFrames.size());
+
+        // Voller FIFO: lieber die neuesten Frames verlieren als auf update() warten
+        int start1, size1, start2, size2;
+        fifo.prepareToWrite(numFrames, start1, size1, start2, size2);
+
+        std::copy(blockFrames.data(), blockFrames.data() + size1, fifoFrames.data() + start1);
+        std::copy(blockFrames.data() + size1, blockFrames.data() + size1 + size2, fifoFrames.data() + start2);
+        fifo.finishedWrite(size1 + size2);
+    }
+}
+
+void LiveTempoTracker::update()
+{
+    const std::lock_guard<std::mutex> guard(estimateLock);
+
+    if (ring.empty())
+        return;
+
+    int start1, size1, start2, size2;
+    fifo.prepareToRead(fifo.getNumReady(), start1, size1, start2, size2);
+
+    auto append = [this](int start, int size)
+    {
+        for (int i = start; i < start + size; ++i)
+        {
+            ring[(size_t)ringPosition] = fifoFrames[(size_t)i];
+            ringPosition = (ringPosition + 1) % windowFrames;
+        }
+    };
+
+    append(start1, size1);
+    append(start2, size2);
+
+    fifo.finishedRead(size1 + size2);
+
+    framesInRing = juce::jmin(framesInRing + size1 + size2, windowFrames);
+    framesSinceEstimate += size1 + size2;
+
+    // Auch nach einer längeren Pause nur eine Schätzung über das jüngste Fenster
+    if (framesSinceEstimate >= hopFrames && framesInRing >= minFrames)
+    {
+        framesSinceEstimate = 0;
+        updateEstimate();
+    }
+}
+
+bool LiveTempoTracker::isSameTempo(double a, double b) const noexcept
+{
+    return a > 0.0 && b > 0.0 && std::abs(a / b - 1.0) <= options.tolerance;
+}
+
+void LiveTempoTracker::updateEstimate() noexcept
+{
+    // Ältester Frame zuerst; solange der Ring nicht voll ist, beginnt er bei 0
+    const int oldest = framesInRing < windowFrames ? 0 : ringPosition;
+
+    for (int i = 0; i < framesInRing; ++i)
+        window[(size_t)i] = ring[(size_t)((oldest + i) % windowFrames)];
+
+    const int found = tempoEstimator.estimate(window.data(), framesInRing, candidates.data(), (int)candidates.size());
+
+    if (found == 0 || candidates[0].confidence < options.minConfidence)
+        return;
+
+    double estimate = candidates[0].bpm;
+
+    if (currentBPM > 0.0)
+    {
+        // Dasselbe Tempo eine Oktave daneben: in die bisherige zurückfalten
+        if (isSameTempo(estimate, 2.0 * currentBPM))
+            estimate *= 0.5;
+        else if (isSameTempo(estimate, 0.5 * currentBPM))
+            estimate *= 2.0;
+    }
+
+    if (currentBPM <= 0.0)
+    {
+        currentBPM = estimate;
+        pendingHops = 0;
+    }
+    else if (isSameTempo(estimate, currentBPM))
+    {
+        currentBPM += options.smoothing * (estimate - currentBPM);
+        pendingHops = 0;
+    }
+    else
+    {
+        // Neues Tempo erst übernehmen, wenn es mehrere Hops in Folge hält
+        if (pendingHops > 0 && isSameTempo(estimate, pendingBPM))
+        {
+            pendingBPM += 0.5 * (estimate - pendingBPM);
+            ++pendingHops;
+        }
+        else
+        {
+            pendingBPM = estimate;
+            pendingHops = 1;
+        }
+
+        if (pendingHops < options.hopsToConfirmChange)
+            return;
+
+        currentBPM = pendingBPM;
+        pendingHops = 0;
+    }
+
+    publishedBPM.store(currentBPM, std::memory_order_relaxed);
+    publishedConfidence.store(candidates[0].confidence, std::memory_order_relaxed);
+}
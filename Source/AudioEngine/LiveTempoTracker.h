@@ -0,0 +1,116 @@
+/*
+  ==============================================================================
+
+    LiveTempoTracker.h
+    Created: 16 Oct 2026
+
+    Continuous tempo of a live signal (line inputs, turntables, an external
+    mixer). On the audio thread the incoming audio only runs through an
+    OnsetDetector, whose frames are pushed into a lock-free single producer
+    / single consumer FIFO. update(), called regularly from another thread
+    (a UI timer), drains the FIFO into a fixed ring holding the last few
+    seconds; once per hop the ring is handed to the TempoEstimator, and the
+    result updates the published tempo:
+
+      - within a few percent of the current tempo: smoothed into it,
+      - about double or half of it: folded back (the same tempo, counted
+        in another octave),
+      - anything else: taken over only after it held for several hops in
+        a row, so a single break or fill does not move the display.
+
+    Windows without clear periodicity (silence, beatless intros) keep the
+    last tempo.
+
+    Everything is allocated in prepare(); process() neither allocates nor
+    locks and is meant to be called from the audio callback. If update()
+    falls behind by more than a window, the newest frames are dropped. The
+    tempo can be read from any thread.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "OnsetDetector.h"
+#include "TempoEstimator.h"
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+class LiveTempoTracker
+{
+public:
+    struct Options
+    {
+        double windowSeconds = 8.0;         // Länge des Rings
+        double hopSeconds = 0.5;            // so oft wird neu geschätzt (höchstens einmal pro update())
+        double minBPM = 70.0;
+        double maxBPM = 180.0;
+        double minConfidence = 0.2;         // darunter zählt ein Fenster nicht
+        double smoothing = 0.3;             // Anteil einer neuen Schätzung am Tempo
+        double tolerance = 0.04;            // relative Abweichung, die noch dasselbe Tempo ist
+        int hopsToConfirmChange = 3;
+    };
+
+    static constexpr int maxChannels = 8;
+
+    LiveTempoTracker() = default;
+
+    /** Not real-time safe; the audio thread must not be in process(). Clears the tempo. */
+    void prepare(double sampleRate, int maximumBlockSize, const Options& newOptions);
+    void prepare(double sampleRate, int maximumBlockSize) { prepare(sampleRate, maximumBlockSize, Options()); }
+
+    /** Adds a block; channels are averaged. Blocks of any length are fine. Audio thread. */
+    void process(const float* const* channels, int numChannels, int numSamples) noexcept;
+
+    /** Takes over the frames process() produced and re-estimates once a hop is due. One non-audio thread. */
+    void update();
+
+    /** Current tempo, 0 until the first confident estimate. Any thread. */
+    double getBPM() const noexcept { return publishedBPM.load(std::memory_order_relaxed); }
+
+    /** Confidence of the latest estimate that counted, 0..1. Any thread. */
+    double getConfidence() const noexcept { return publishedConfidence.load(std::memory_order_relaxed); }
+
+    bool hasTempo() const noexcept { return getBPM() > 0.0; }
+
+private:
+    void updateEstimate() noexcept;
+    bool isSameTempo(double a, double b) const noexcept;
+
+    Options options;
+    int maxBlockSize = 0;
+    int windowFrames = 0;
+    int hopFrames = 0;
+    int minFrames = 0;
+
+    OnsetDetector onsetDetector;
+    TempoEstimator tempoEstimator;
+
+    // Audio Thread
+    std::vector<float> blockFrames;     // Onsets eines Blocks
+
+    // SPSC, Audio Thread -> update()
+    std::vector<float> fifoFrames;
+    juce::AbstractFifo fifo { 1 };
+
+    // update(); prepare() nimmt denselben Lock, weil es auf einem anderen Thread laufen kann
+    std::mutex estimateLock;
+    std::vector<float> ring;            // letzte windowFrames Onsets
+    std::vector<float> window;          // Ring in zeitlicher Reihenfolge für den Estimator
+    std::vector<TempoEstimator::Candidate> candidates;
+
+    int ringPosition = 0;
+    int framesInRing = 0;
+    int framesSinceEstimate = 0;
+
+    double currentBPM = 0.0;
+    double pendingBPM = 0.0;            // abweichende Schätzung, noch nicht bestätigt
+    int pendingHops = 0;
+
+    std::atomic<double> publishedBPM { 0.0 };
+    std::atomic<double> publishedConfidence { 0.0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LiveTempoTracker)
+};
@@ -0,0 +1,140 @@
+/*
+  ==============================================================================
+
+    LoudnessMeter.cpp
+    Created: 16 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "LoudnessMeter.h"
+#include <cmath>
+#include <limits>
+
+namespace
+{
+    constexpr double absoluteGate = -70.0;
+    constexpr double relativeGate = -10.0;
+
+    double energyToLoudness(double energy) noexcept
+    {
+        return energy > 0.0 ? -0.691 + 10.0 * std::log10(energy) : -std::numeric_limits<double>::infinity();
+    }
+}
+
+//==============================================================================
+void LoudnessMeter::prepare(double sampleRate)
+{
+    // Analoge Parameter der K-Filter aus BS.1770, für jede Rate bilinear transformiert
+    {
+        const double f0 = 1681.974450955533, gainDb = 3.999843853973347, q = 0.7071752369554196;
+        const double k = std::tan(juce::MathConstants<double>::pi * f0 / sampleRate);
+        const double vh = std::pow(10.0, gainDb / 20.0);
+        const double vb = std::pow(vh, 0.4996667741545416);
+        const double a0 = 1.0 + k / q + k * k;
+
+        for (auto& filter : shelf)
+        {
+            filter.b0 = (vh + vb * k / q + k * k) / a0;
+            filter.b1 = 2.0 * (k * k - vh) / a0;
+            filter.b2 = (vh - vb * k / q + k * k) / a0;
+            filter.a1 = 2.0 * (k * k - 1.0) / a0;
+            filter.a2 = (1.0 - k / q + k * k) / a0;
+        }
+    }
+
+    {
+        const double f0 = 38.13547087602444, q = 0.5003270373238773;
+        const double k = std::tan(juce::MathConstants<double>::pi * f0 / sampleRate);
+        const double a0 = 1.0 + k / q + k * k;
+
+        for (auto& filter : highPass)
+        {
+            filter.b0 = 1.0;
+            filter.b1 = -2.0;
+            filter.b2 = 1.0;
+            filter.a1 = 2.0 * (k * k - 1.0) / a0;
+            filter.a2 = (1.0 - k / q + k * k) / a0;
+        }
+    }
+
+    subBlockLength = juce::jmax(1, juce::roundToInt(0.1 * sampleRate));
+    reset();
+}
+
+void LoudnessMeter::reset()
+{
+    for (int channel = 0; channel < maxChannels; ++channel)
+    {
+        shelf[channel].z1 = shelf[channel].z2 = 0.0;
+        highPass[channel].z1 = highPass[channel].z2 = 0.0;
+    }
+
+    subBlockPosition = 0;
+    subBlockEnergy = 0.0;
+    numSubBlocks = 0;
+    blockEnergies.clear();
+    peak = 0.0f;
+}
+
+void LoudnessMeter::process(const float* const* channels, int numChannels, int numSamples)
+{
+    numChannels = juce::jmin(numChannels, maxChannels);
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            const float sample = channels[channel][i];
+            peak = juce::jmax(peak, std::abs(sample));
+
+            const double weighted = highPass[channel].process(shelf[channel].process(sample));
+            subBlockEnergy += weighted * weighted;
+        }
+
+        if (++subBlockPosition < subBlockLength)
+            continue;
+
+        recentSubBlocks[numSubBlocks % 4] = subBlockEnergy / subBlockLength;
+        ++numSubBlocks;
+        subBlockPosition = 0;
+        subBlockEnergy = 0.0;
+
+        // Jeder 400-ms-Block besteht aus den letzten vier 100-ms-Stücken
+        if (numSubBlocks >= 4)
+            blockEnergies.push_back(0.25 * (recentSubBlocks[0] + recentSubBlocks[1] + recentSubBlocks[2] + recentSubBlocks[3]));
+    }
+}
+
+double LoudnessMeter::getIntegratedLoudness() const
+{
+    double sum = 0.0;
+    int count = 0;
+
+    for (auto energy : blockEnergies)
+    {
+        if (energyToLoudness(energy) > absoluteGate)
+        {
+            sum += energy;
+            ++count;
+        }
+    }
+
+    if (count == 0)
+        return silence;
+
+    const double threshold = energyToLoudness(sum / count) + relativeGate;
+    sum = 0.0;
+    count = 0;
+
+    for (auto energy : blockEnergies)
+    {
+        if (energyToLoudness(energy) > threshold && energyToLoudness(energy) > absoluteGate)
+        {
+            sum += energy;
+            ++count;
+        }
+    }
+
+    return count > 0 ? juce::jmax(silence, energyToLoudness(sum / count)) : silence;
+}
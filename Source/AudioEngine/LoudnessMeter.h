@@ -0,0 +1,70 @@
+/*
+  ==============================================================================
+
+    LoudnessMeter.h
+    Created: 16 Oct 2026
+
+    Integrated loudness of a whole track after ITU-R BS.1770-4 / EBU R128:
+    K-weighting (high shelf + high pass, coefficients derived for any rate),
+    mean square per 100 ms, 400 ms gating blocks with 75 % overlap, the
+    absolute gate at -70 LUFS and the relative gate 10 LU below the
+    ungated mean. Also keeps the sample peak.
+
+    Streaming for the analysis threads: feed any block size. The gating
+    blocks are kept (ten per second) until the result is read.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+
+class LoudnessMeter
+{
+public:
+    static constexpr int maxChannels = 2;
+    static constexpr double silence = -70.0;    // LUFS, auch das Ergebnis für stille Tracks
+
+    LoudnessMeter() = default;
+
+    void prepare(double sampleRate);
+    void reset();
+
+    /** Channels beyond maxChannels are ignored; mono counts once (BS.1770 weights 1.0 for L/R/C). */
+    void process(const float* const* channels, int numChannels, int numSamples);
+
+    /** Gated integrated loudness in LUFS, silence if nothing passed the gates. */
+    double getIntegratedLoudness() const;
+
+    float getPeak() const noexcept { return peak; }
+
+private:
+    struct Biquad
+    {
+        double b0 = 1.0, b1 = 0.0, b2 = 0.0, a1 = 0.0, a2 = 0.0;
+        double z1 = 0.0, z2 = 0.0;
+
+        double process(double x) noexcept
+        {
+            const double y = b0 * x + z1;
+            z1 = b1 * x - a1 * y + z2;
+            z2 = b2 * x - a2 * y;
+            return y;
+        }
+    };
+
+    Biquad shelf[maxChannels], highPass[maxChannels];
+
+    int subBlockLength = 4800;      // 100 ms
+    int subBlockPosition = 0;
+    double subBlockEnergy = 0.0;
+    double recentSubBlocks[4] = {}; // die letzten 400 ms
+    int numSubBlocks = 0;
+
+    std::vector<double> blockEnergies;  // je 400-ms-Block, alle 100 ms einer
+    float peak = 0.0f;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LoudnessMeter)
+};
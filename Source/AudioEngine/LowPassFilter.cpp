@@ -70,7 +70,6 @@ void LowPassFilter::process(float *in, float *out, int numSamples) {
             // f =  this->frequency * modulator->getOutput() * this->modAmount;
             f =  this->frequency + (modulator->getOutput() * this->modAmount * 1000);
             // f = this->frequency * modulator->getOutput();
-            cout << f << endl;
         }
 
         if (f <= 0) {
@@ -0,0 +1,207 @@
+/*
+  ==============================================================================
+
+    MasterEQ.cpp
+    Created: 16 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "MasterEQ.h"
+
+namespace
+{
+    using ArrayCoefficients = juce::dsp::IIR::ArrayCoefficients<float>;
+
+    bool sameParameters(const EngineParameters::EQ& a, const EngineParameters::EQ& b) noexcept
+    {
+        return a.lowGainDb == b.lowGainDb
+            && a.midGainDb == b.midGainDb
+            && a.highGainDb == b.highGainDb
+            && a.lowFreq == b.lowFreq
+            && a.highFreq == b.highFreq;
+    }
+
+    // Auf a0 = 1 bringen, damit sich zwei Sätze Wert für Wert überblenden lassen
+    std::array<float, 6> normalise(std::array<float, 6> values) noexcept
+    {
+        const float a0 = values[3];
+
+        if (a0 != 0.0f)
+            for (auto& value : values)
+                value /= a0;
+
+        return values;
+    }
+}
+
+void MasterEQ::computeCoefficients(EngineParameters::EQ& eq, double sampleRate)
+{
+    if (sampleRate <= 0.0)
+    {
+        eq.coefficientSampleRate = 0.0;
+        return;
+    }
+
+    eq.lowShelfCoefficients = normalise(ArrayCoefficients::makeLowShelf(sampleRate, eq.lowFreq, shelfQ,
+        juce::Decibels::decibelsToGain(eq.lowGainDb)));
+    eq.peakCoefficients = normalise(ArrayCoefficients::makePeakFilter(sampleRate, peakFrequency, peakQ,
+        juce::Decibels::decibelsToGain(eq.midGainDb)));
+    eq.highShelfCoefficients = normalise(ArrayCoefficients::makeHighShelf(sampleRate, eq.highFreq, shelfQ,
+        juce::Decibels::decibelsToGain(eq.highGainDb)));
+    eq.coefficientSampleRate = sampleRate;
+}
+
+void MasterEQ::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    sampleRate = spec.sampleRate;
+    numChannels = juce::jmin(maxChannels, (int)spec.numChannels);
+
+    // Koeffizienten-Objekte einmalig anlegen, danach werden sie nur noch in place überschrieben.
+    // Beide Kanäle teilen sich dieselben Koeffizienten, nur der Filterzustand ist getrennt.
+    EngineParameters::EQ flat;
+    computeCoefficients(flat, sampleRate);
+    currentSet = getCoefficientSet(flat);
+
+    for (int band = 0; band < numBands; ++band)
+        coefficients[(size_t)band] = new juce::dsp::IIR::Coefficients<float>(currentSet[(size_t)band]);
+
+    const juce::dsp::ProcessSpec monoSpec { spec.sampleRate, spec.maximumBlockSize, 1 };
+
+    for (auto& channelFilters : filters)
+    {
+        for (int band = 0; band < numBands; ++band)
+        {
+            channelFilters[(size_t)band].coefficients = coefficients[(size_t)band];
+            channelFilters[(size_t)band].prepare(monoSpec);
+        }
+    }
+
+    rampLength = juce::jmax(1, juce::roundToInt(rampSeconds * sampleRate));
+    rampPosition = rampLength;
+
+    // Der erste Snapshot nach prepare() wird ohne Rampe übernommen
+    hasTarget = false;
+}
+
+void MasterEQ::reset()
+{
+    for (auto& channelFilters : filters)
+        for (auto& filter : channelFilters)
+            filter.reset();
+
+    finishRamp();
+}
+
+void MasterEQ::setParameters(const EngineParameters::EQ& eq)
+{
+    bypassed = eq.bypass;
+
+    if (hasTarget && sameParameters(eq, target))
+        return;
+
+    const bool firstTarget = !hasTarget;
+    target = eq;
+    hasTarget = true;
+
+    // Snapshot noch für die alte Rate (kurz nach prepare()): einmal selbst rechnen, die
+    // Neuveröffentlichung vom Message Thread folgt gleich
+    if (target.coefficientSampleRate != sampleRate)
+        computeCoefficients(target, sampleRate);
+
+    // Von dort, wo die Filter gerade stehen (auch mitten in einer Rampe), zum neuen Ziel
+    rampStart = currentSet;
+    rampEnd = getCoefficientSet(target);
+    rampPosition = 0;
+
+    if (firstTarget)
+        finishRamp();
+}
+
+void MasterEQ::process(const juce::dsp::AudioBlock<float>& block)
+{
+    if (coefficients[LowShelf] == nullptr)
+        return;
+
+    if (bypassed)
+    {
+        // Während Bypass hört niemand die Rampe, also direkt auf das Ziel springen
+        if (isRamping())
+            finishRamp();
+        return;
+    }
+
+    if (!isRamping())
+    {
+        processBands(block);
+        return;
+    }
+
+    const size_t numSamples = block.getNumSamples();
+
+    for (size_t position = 0; position < numSamples; position += controlInterval)
+    {
+        const size_t length = juce::jmin(controlInterval, numSamples - position);
+
+        advanceRamp((int)length);
+        processBands(block.getSubBlock(position, length));
+    }
+}
+
+MasterEQ::CoefficientSet MasterEQ::getCoefficientSet(const EngineParameters::EQ& eq) noexcept
+{
+    return { eq.lowShelfCoefficients, eq.peakCoefficients, eq.highShelfCoefficients };
+}
+
+void MasterEQ::finishRamp() noexcept
+{
+    rampPosition = rampLength;
+
+    if (hasTarget)
+        applyCoefficients(rampEnd);
+}
+
+void MasterEQ::advanceRamp(int numSamples) noexcept
+{
+    rampPosition = juce::jmin(rampLength, rampPosition + numSamples);
+
+    if (!isRamping())
+    {
+        applyCoefficients(rampEnd);
+        return;
+    }
+
+    // Nur Multiplikationen und Additionen, die Endpunkte kommen vom Message Thread
+    const float amount = (float)rampPosition / (float)rampLength;
+    CoefficientSet blended;
+
+    for (size_t band = 0; band < (size_t)numBands; ++band)
+        for (size_t i = 0; i < blended[band].size(); ++i)
+            blended[band][i] = rampStart[band][i] + amount * (rampEnd[band][i] - rampStart[band][i]);
+
+    applyCoefficients(blended);
+}
+
+void MasterEQ::applyCoefficients(const CoefficientSet& set) noexcept
+{
+    // Die Zuweisung eines std::array nutzt den in prepare() reservierten Speicher
+    currentSet = set;
+
+    for (size_t band = 0; band < (size_t)numBands; ++band)
+        *coefficients[band] = set[band];
+}
+
+void MasterEQ::processBands(const juce::dsp::AudioBlock<float>& block) noexcept
+{
+    const int channelsToProcess = juce::jmin(numChannels, (int)block.getNumChannels());
+
+    for (int channel = 0; channel < channelsToProcess; ++channel)
+    {
+        auto channelBlock = block.getSingleChannelBlock((size_t)channel);
+        juce::dsp::ProcessContextReplacing<float> context(channelBlock);
+
+        // Chain: Low -> Peak -> High
+        for (auto& filter : filters[(size_t)channel])
+            filter.process(context);
+    }
+}
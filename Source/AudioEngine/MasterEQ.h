@@ -0,0 +1,82 @@
+/*
+  ==============================================================================
+
+    MasterEQ.h
+    Created: 16 Oct 2026
+
+    Three-band master EQ (low shelf, 1 kHz peak, high shelf) with a
+    change-driven coefficient cache. Coefficients are only computed when a
+    parameter moves, on the message thread together with the parameter
+    snapshot. A new snapshot starts a ramp on the audio thread from the
+    coefficients in use to the precomputed ones: every controlInterval
+    samples the two (normalised) sets are blended linearly and written into
+    the existing coefficient objects. A blend of two stable biquads is
+    stable, and the audio thread does no trig and never touches the heap.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "EngineParameters.h"
+
+class MasterEQ
+{
+public:
+    MasterEQ() = default;
+
+    /** Message thread: fills the precomputed (normalised) coefficient fields of an EQ snapshot. */
+    static void computeCoefficients(EngineParameters::EQ& eq, double sampleRate);
+
+    /** Allocates the coefficient objects. Not real-time safe. */
+    void prepare(const juce::dsp::ProcessSpec& spec);
+    void reset();
+
+    /** Audio thread, once per block. Cheap if nothing changed since the last call. */
+    void setParameters(const EngineParameters::EQ& eq);
+
+    bool isBypassed() const noexcept { return bypassed; }
+
+    /** Processes up to two channels in place. */
+    void process(const juce::dsp::AudioBlock<float>& block);
+
+private:
+    enum Band { LowShelf = 0, Peak, HighShelf, numBands };
+
+    using CoefficientSet = std::array<std::array<float, 6>, numBands>;
+
+    static constexpr int maxChannels = 2;
+    static constexpr size_t controlInterval = 32;   // Samples zwischen zwei Überblendschritten
+    static constexpr double rampSeconds = 0.05;
+    static constexpr float peakFrequency = 1000.0f;
+    static constexpr float peakQ = 1.0f;
+    static constexpr float shelfQ = 0.707f;
+
+    static CoefficientSet getCoefficientSet(const EngineParameters::EQ& eq) noexcept;
+
+    bool isRamping() const noexcept { return rampPosition < rampLength; }
+    void finishRamp() noexcept;
+    void advanceRamp(int numSamples) noexcept;
+    void applyCoefficients(const CoefficientSet& set) noexcept;
+    void processBands(const juce::dsp::AudioBlock<float>& block) noexcept;
+
+    double sampleRate = 44100.0;
+    int numChannels = 0;
+
+    std::array<juce::dsp::IIR::Coefficients<float>::Ptr, numBands> coefficients;
+    std::array<std::array<juce::dsp::IIR::Filter<float>, numBands>, maxChannels> filters;
+
+    // Audio Thread: Koeffizienten in Gebrauch und die laufende Überblendung
+    CoefficientSet currentSet {};
+    CoefficientSet rampStart {};
+    CoefficientSet rampEnd {};
+    int rampLength = 0;
+    int rampPosition = 0;
+
+    EngineParameters::EQ target;
+    bool hasTarget = false;
+    bool bypassed = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MasterEQ)
+};
@@ -0,0 +1,98 @@
+/*
+  ==============================================================================
+
+    MixBusArena.h
+    Created: 16 Oct 2026
+
+    One preallocated block of stereo buses for the mixer callback. It is sized
+    once in prepareToPlay() and handed out as raw channel pointers, AudioBuffer
+    views or dsp::AudioBlocks, none of which touch the heap.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+class MixBusArena
+{
+public:
+    enum Bus
+    {
+        DeckA = 0,
+        DeckB,
+        SamplePlayer,
+        Master,
+        Cue,
+        Scratch,
+        numBuses
+    };
+
+    static constexpr int channelsPerBus = 2;
+
+    MixBusArena() = default;
+
+    /** Allocates every bus for blocks of up to maximumBlockSize samples. Not real-time safe. */
+    void prepare(int maximumBlockSize)
+    {
+        maxBlockSize = juce::jmax(1, maximumBlockSize);
+        storage.setSize(numBuses * channelsPerBus, maxBlockSize, false, true, false);
+    }
+
+    void release()
+    {
+        storage.setSize(0, 0);
+        maxBlockSize = 0;
+    }
+
+    int getMaximumBlockSize() const noexcept { return maxBlockSize; }
+    bool isPrepared() const noexcept { return maxBlockSize > 0; }
+
+    void clear(int numSamples) noexcept
+    {
+        jassert(numSamples <= maxBlockSize);
+        storage.clear(0, juce::jmin(numSamples, maxBlockSize));
+    }
+
+    void clear(Bus bus, int numSamples) noexcept
+    {
+        jassert(numSamples <= maxBlockSize);
+        for (int ch = 0; ch < channelsPerBus; ++ch)
+            storage.clear(bus * channelsPerBus + ch, 0, juce::jmin(numSamples, maxBlockSize));
+    }
+
+    float* getWritePointer(Bus bus, int channel) noexcept
+    {
+        jassert(juce::isPositiveAndBelow(channel, channelsPerBus));
+        return storage.getWritePointer(bus * channelsPerBus + channel);
+    }
+
+    const float* getReadPointer(Bus bus, int channel) const noexcept
+    {
+        jassert(juce::isPositiveAndBelow(channel, channelsPerBus));
+        return storage.getReadPointer(bus * channelsPerBus + channel);
+    }
+
+    /** A non-owning AudioBuffer over one bus. Uses the buffer's inline channel table, so no allocation. */
+    juce::AudioBuffer<float> getBuffer(Bus bus, int numSamples) noexcept
+    {
+        jassert(numSamples <= maxBlockSize);
+        return juce::AudioBuffer<float>(storage.getArrayOfWritePointers() + bus * channelsPerBus,
+                                        channelsPerBus, juce::jmin(numSamples, maxBlockSize));
+    }
+
+    juce::dsp::AudioBlock<float> getBlock(Bus bus, int numSamples) noexcept
+    {
+        jassert(numSamples <= maxBlockSize);
+        return juce::dsp::AudioBlock<float>(storage)
+            .getSubsetChannelBlock((size_t)(bus * channelsPerBus), (size_t)channelsPerBus)
+            .getSubBlock(0, (size_t)juce::jmin(numSamples, maxBlockSize));
+    }
+
+private:
+    juce::AudioBuffer<float> storage;
+    int maxBlockSize = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MixBusArena)
+};
@@ -0,0 +1,406 @@
+/*
+  ==============================================================================
+
+    MixEngine.cpp
+    Created: 16 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "MixEngine.h"
+#include "AllocationGuard.h"
+#include "RealtimeSanitizer.h"
+#include <cmath>
+
+//==============================================================================
+void MixEngine::prepareToPlay(double sampleRate, int maximumBlockSize)
+{
+    currentSampleRate = sampleRate;
+    dspLoad.prepare(sampleRate);
+
+    juce::dsp::ProcessSpec spec;
+    spec.sampleRate = sampleRate;
+    spec.maximumBlockSize = (juce::uint32)maximumBlockSize;
+    spec.numChannels = 2; // Stereo
+
+    masterFX.prepare(spec);
+
+    // Alle Mix-Busse einmalig anlegen, im Callback wird nichts mehr allokiert
+    mixBuses.prepare(maximumBlockSize);
+
+    for (auto& stretcher : keyLockStretchers)
+        stretcher.prepare();
+
+    // Decks auf die Geräterate umstellen, die Konvertierung läuft im Hintergrund
+    for (auto* sampler : decks)
+        if (sampler != nullptr)
+            sampler->prepareToPlay(sampleRate, maximumBlockSize);
+
+    // Prepare stutter effect
+    if (stutter != nullptr)
+        stutter->prepareToPlay(sampleRate, maximumBlockSize);
+
+    for (auto& tracker : lineInputTempo)
+        tracker.prepare(sampleRate, maximumBlockSize);
+}
+
+void MixEngine::releaseResources()
+{
+    mixBuses.release();
+}
+
+void MixEngine::publishParameters(EngineParameters params)
+{
+    // EQ-Zielkoeffizienten hier berechnen, damit der Audio Thread sie nur noch kopieren muss
+    MasterEQ::computeCoefficients(params.eq, currentSampleRate);
+
+    engineParameters.publish(params);
+}
+
+void MixEngine::setKeyLockMode(TimeStretcher::Mode mode)
+{
+    for (auto& stretcher : keyLockStretchers)
+        stretcher.setMode(mode);
+}
+
+void MixEngine::updateLineInputTempo()
+{
+    for (auto& tracker : lineInputTempo)
+        tracker.update();
+}
+
+double MixEngine::getLineInputBPM(int input) const
+{
+    return juce::isPositiveAndBelow(input, (int)lineInputTempo.size()) ? lineInputTempo[(size_t)input].getBPM() : 0.0;
+}
+
+void MixEngine::process(float* const* outputData, int numOutputChannels, int startSample, int numSamples,
+                        int numInputChannels)
+{
+    // Ganzer Aufruf als ein Messwert, die Stages darin einzeln
+    const DspLoadMonitor::ScopedBlock measuredBlock(dspLoad, numSamples);
+
+    // Mit RADIOBLAST_RT_SANITIZER: Heap, Locks und Syscalls in diesem Aufruf melden
+    const RealtimeSanitizer::ScopedRealtimeRegion realtimeRegion;
+
+    // Neuesten Parameter-Snapshot einmal pro Block holen
+    const auto& params = engineParameters.acquire();
+
+    if (outputData != nullptr && numInputChannels > 0)
+        processLineInputs(outputData, numOutputChannels, juce::jmin(numInputChannels, numOutputChannels), startSample, numSamples);
+
+    if (outputData == nullptr || numOutputChannels < 2 || !mixBuses.isPrepared())
+        return;
+
+    {
+        // Ab hier darf nichts mehr allokieren (mit RADIOBLAST_CHECK_AUDIO_ALLOCATIONS geprüft)
+        AllocationGuard::ScopedNoAllocation noAllocation;
+
+        // === FX PARAMETER UPDATE === (nur bei Änderungen, ohne Allokation)
+        updateFXParameters(params);
+
+        // Das Device darf größere Blöcke liefern als angekündigt, also in Arena-Größe abarbeiten
+        const int maxBlock = mixBuses.getMaximumBlockSize();
+
+        for (int offset = 0; offset < numSamples; offset += maxBlock)
+        {
+            const int blockSize = juce::jmin(maxBlock, numSamples - offset);
+            renderMixBlock(params, outputData, numOutputChannels, startSample + offset, blockSize);
+        }
+    }
+}
+
+void MixEngine::processLineInputs(float* const* data, int numChannels, int numInputChannels, int startSample, int numSamples) noexcept
+{
+    {
+        // Nur die Onsets, die Tempo-Schätzung läuft in updateLineInputTempo()
+        const DspLoadMonitor::ScopedStage measured(dspLoad, DspLoadMonitor::lineInputs);
+
+        for (int input = 0; input < (int)lineInputTempo.size() && 2 * input < numInputChannels; ++input)
+        {
+            const float* channels[2];
+            const int numInputPairChannels = juce::jmin(2, numInputChannels - 2 * input);
+
+            for (int channel = 0; channel < numInputPairChannels; ++channel)
+                channels[channel] = data[2 * input + channel] + startSample;
+
+            lineInputTempo[(size_t)input].process(channels, numInputPairChannels, numSamples);
+        }
+    }
+
+    // Die Eingänge selbst gehen nicht in den Mix
+    for (int channel = 0; channel < numChannels; ++channel)
+        juce::FloatVectorOperations::clear(data[channel] + startSample, numSamples);
+}
+
+void MixEngine::renderMixBlock(const EngineParameters& params, float* const* outputData, int outNumChans, int startSample, int numSamples)
+{
+    Sampler* leftSampler = decks[0];
+    Sampler* rightSampler = decks[1];
+
+    const auto& deckA = params.decks[0];
+    const auto& deckB = params.decks[1];
+
+    mixBuses.clear(numSamples);
+
+    // Stereo Busse für beide Sampler (mit Pitch-Shifting)
+    float* leftSamplerL = mixBuses.getWritePointer(MixBusArena::DeckA, 0);
+    float* leftSamplerR = mixBuses.getWritePointer(MixBusArena::DeckA, 1);
+    float* rightSamplerL = mixBuses.getWritePointer(MixBusArena::DeckB, 0);
+    float* rightSamplerR = mixBuses.getWritePointer(MixBusArena::DeckB, 1);
+
+    // Sample Player Bus
+    float* samplePlayerL = mixBuses.getWritePointer(MixBusArena::SamplePlayer, 0);
+    float* samplePlayerR = mixBuses.getWritePointer(MixBusArena::SamplePlayer, 1);
+
+    // Master Mix Bus für FX Processing
+    float* masterMixL = mixBuses.getWritePointer(MixBusArena::Master, 0);
+    float* masterMixR = mixBuses.getWritePointer(MixBusArena::Master, 1);
+
+    // Cue Bus (ohne FX)
+    float* cueL = mixBuses.getWritePointer(MixBusArena::Cue, 0);
+    float* cueR = mixBuses.getWritePointer(MixBusArena::Cue, 1);
+
+    // Generate sampler outputs (Buffer, Grenzen und Hüllkurve einmal pro Block)
+    {
+        const DspLoadMonitor::ScopedStage measured(dspLoad, DspLoadMonitor::deckA);
+        renderDeck(leftSampler, keyLockStretchers[0], deckA, leftSamplerL, leftSamplerR, numSamples);
+    }
+
+    {
+        const DspLoadMonitor::ScopedStage measured(dspLoad, DspLoadMonitor::deckB);
+        renderDeck(rightSampler, keyLockStretchers[1], deckB, rightSamplerL, rightSamplerR, numSamples);
+    }
+
+    // Sample Player Output generieren
+    if (sampleSlots != nullptr && sampleSlots->isAnySamplePlaying()) {
+        const DspLoadMonitor::ScopedStage measured(dspLoad, DspLoadMonitor::samplePlayer);
+        sampleSlots->generateSampleOutput(samplePlayerL, samplePlayerR,
+            numSamples, 1.0f);
+    }
+
+    // Deck-Pegel vor dem Routing (für die Deck-Meter)
+    {
+        const DspLoadMonitor::ScopedStage measured(dspLoad, DspLoadMonitor::metering);
+
+        meters.deckA.addBlock(leftSamplerL, leftSamplerR, numSamples);
+        meters.deckB.addBlock(rightSamplerL, rightSamplerR, numSamples);
+    }
+
+    // === AUDIO ROUTING ZUM MASTER MIX ===
+    {
+        const DspLoadMonitor::ScopedStage measured(dspLoad, DspLoadMonitor::routing);
+
+        // Routing steht für den ganzen Block fest, also pro Bus statt pro Sample mischen
+        routeDeckToMaster(deckA, EngineParameters::OutputDestination::MasterLeft, leftSamplerL, leftSamplerR, masterMixL, masterMixR, numSamples);
+        routeDeckToMaster(deckB, EngineParameters::OutputDestination::MasterRight, rightSamplerL, rightSamplerR, masterMixL, masterMixR, numSamples);
+
+        // === Sample Player zum Master Mix hinzufügen ===
+        juce::FloatVectorOperations::add(masterMixL, samplePlayerL, numSamples);
+        juce::FloatVectorOperations::add(masterMixR, samplePlayerR, numSamples);
+
+        // === CUE ROUTING (bypassed FX) ===
+        if (deckA.routedToCue) {
+            juce::FloatVectorOperations::add(cueL, leftSamplerL, numSamples);
+            juce::FloatVectorOperations::add(cueR, leftSamplerR, numSamples);
+        }
+
+        if (deckB.routedToCue) {
+            juce::FloatVectorOperations::add(cueL, rightSamplerL, numSamples);
+            juce::FloatVectorOperations::add(cueR, rightSamplerR, numSamples);
+        }
+    }
+
+    // === MASTER FX PROCESSING (in place auf dem Master Bus) ===
+    processFXChain(masterFX, mixBuses.getBlock(MixBusArena::Master, numSamples));
+
+    // Wende Stutter-Effekt direkt auf den Master Bus an
+    if (stutter != nullptr) {
+        const DspLoadMonitor::ScopedStage measured(dspLoad, DspLoadMonitor::stutter);
+        auto masterBus = mixBuses.getBuffer(MixBusArena::Master, numSamples);
+        stutter->processAudioBuffer(masterBus);
+    }
+
+    // === Final Output zu Hardware (mit Stutter-Effekt) ===
+    {
+        const DspLoadMonitor::ScopedStage measured(dspLoad, DspLoadMonitor::routing);
+
+        juce::FloatVectorOperations::copy(outputData[0] + startSample, masterMixL, numSamples);
+        juce::FloatVectorOperations::copy(outputData[1] + startSample, masterMixR, numSamples);
+
+        if (outNumChans > 2) juce::FloatVectorOperations::add(outputData[2] + startSample, cueL, numSamples);
+        if (outNumChans > 3) juce::FloatVectorOperations::add(outputData[3] + startSample, cueR, numSamples);
+    }
+
+    {
+        const DspLoadMonitor::ScopedStage measured(dspLoad, DspLoadMonitor::metering);
+
+        meters.master.addBlock(masterMixL, masterMixR, numSamples);
+    }
+}
+
+void MixEngine::renderDeck(Sampler* sampler, TimeStretcher& stretcher, const EngineParameters::Deck& deck,
+    float* deckL, float* deckR, int numSamples)
+{
+    if (sampler == nullptr || !sampler->isPlaying()) {
+        // Beim nächsten Start nicht mit altem Material aus dem Stretcher weitermachen
+        if (stretcher.isActive())
+            stretcher.reset();
+        return;
+    }
+
+    // Key Lock: der Sampler läuft mit Rate 1, der Pitch-Fader bestimmt nur das Tempo
+    if (deck.keyLock) {
+        stretcher.process(*sampler, deckL, deckR, numSamples, deck.pitch, deck.channelGain);
+        return;
+    }
+
+    if (stretcher.isActive())
+        stretcher.reset();
+
+    sampler->renderBlock(deckL, deckR, numSamples, deck.pitch, deck.channelGain);
+}
+
+void MixEngine::routeDeckToMaster(const EngineParameters::Deck& deck, EngineParameters::OutputDestination stereoDestination,
+    const float* deckL, const float* deckR, float* masterL, float* masterR, int numSamples)
+{
+    if (!deck.routedToMaster)
+        return;
+
+    if (deck.destination == stereoDestination) {
+        // Deck liegt auf "seiner" Seite: Stereo in den Master
+        juce::FloatVectorOperations::addWithMultiply(masterL, deckL, deck.masterGain, numSamples);
+        juce::FloatVectorOperations::addWithMultiply(masterR, deckR, deck.masterGain, numSamples);
+    }
+    else if (deck.destination == EngineParameters::OutputDestination::MasterLeft
+        || deck.destination == EngineParameters::OutputDestination::MasterRight) {
+        // Auf die andere Seite nur als Mono-Summe
+        float* target = deck.destination == EngineParameters::OutputDestination::MasterLeft ? masterL : masterR;
+        const float monoGain = deck.masterGain * 0.5f;
+        juce::FloatVectorOperations::addWithMultiply(target, deckL, monoGain, numSamples);
+        juce::FloatVectorOperations::addWithMultiply(target, deckR, monoGain, numSamples);
+    }
+}
+
+void MixEngine::updateFXParameters(const EngineParameters& params)
+{
+    // Parameter kommen aus dem Snapshot, nicht mehr direkt von den UI-Komponenten
+    updateFilterParameters(masterFX, params.filter);
+    updateEQParameters(masterFX, params.eq);
+    updateChorusParameters(masterFX, params.chorus);
+    updateReverbParameters(masterFX, params.reverb);
+
+    masterFX.masterVolume = params.masterVolumeDb;
+    masterFX.settingsApplied = true;
+}
+
+void MixEngine::updateFilterParameters(FXChain& fx, const EngineParameters::Filter& filterParams)
+{
+    fx.filterBypass = filterParams.bypass;
+
+    // setCutoffFrequency() rechnet tan() neu, also nur bei Änderungen
+    if (fx.settingsApplied && EngineParameters::sameSettings(filterParams, fx.appliedFilter))
+        return;
+
+    fx.appliedFilter = filterParams;
+
+    for (auto& filter : fx.filters)
+    {
+        filter.setCutoffFrequency(filterParams.cutoff);
+        filter.setResonance(filterParams.resonance);
+
+        switch (filterParams.type)
+        {
+        case 0: filter.setType(juce::dsp::StateVariableTPTFilterType::lowpass); break;
+        case 1: filter.setType(juce::dsp::StateVariableTPTFilterType::highpass); break;
+        case 2: filter.setType(juce::dsp::StateVariableTPTFilterType::bandpass); break;
+        // case 3: filter.setType(juce::dsp::StateVariableTPTFilterType::notch); break;
+        default: filter.setType(juce::dsp::StateVariableTPTFilterType::lowpass); break;
+        }
+    }
+}
+
+void MixEngine::updateEQParameters(FXChain& fx, const EngineParameters::EQ& eqParams)
+{
+    // MasterEQ vergleicht selbst mit dem letzten Ziel und startet bei Änderungen eine Rampe
+    fx.eq.setParameters(eqParams);
+}
+
+void MixEngine::updateChorusParameters(FXChain& fx, const EngineParameters::Chorus& chorusParams)
+{
+    fx.chorusBypass = chorusParams.bypass;
+
+    if (fx.settingsApplied && EngineParameters::sameSettings(chorusParams, fx.appliedChorus))
+        return;
+
+    fx.appliedChorus = chorusParams;
+
+    fx.chorus.setRate(chorusParams.rate);
+    fx.chorus.setDepth(chorusParams.depth);
+    fx.chorus.setFeedback(chorusParams.feedback);
+    fx.chorus.setMix(chorusParams.mix);
+    fx.chorus.setCentreDelay(7.0f);
+}
+
+void MixEngine::updateReverbParameters(FXChain& fx, const EngineParameters::Reverb& reverbParamsIn)
+{
+    fx.reverbBypass = reverbParamsIn.bypass;
+
+    // Reverb::setParameters() glättet selbst, muss aber nicht jeden Block neu angestoßen werden
+    if (fx.settingsApplied && EngineParameters::sameSettings(reverbParamsIn, fx.appliedReverb))
+        return;
+
+    fx.appliedReverb = reverbParamsIn;
+
+    juce::dsp::Reverb::Parameters reverbParams;
+    reverbParams.roomSize = reverbParamsIn.roomSize;
+    reverbParams.damping = reverbParamsIn.damping;
+    reverbParams.wetLevel = reverbParamsIn.wetLevel;
+    reverbParams.dryLevel = reverbParamsIn.dryLevel;
+    reverbParams.width = reverbParamsIn.width;
+    reverbParams.freezeMode = 0.0f;
+
+    fx.reverb.setParameters(reverbParams);
+}
+
+void MixEngine::processFXChain(FXChain& fx, juce::dsp::AudioBlock<float> block)
+{
+    // Process FX Chain direkt auf dem Block, keine Kopie
+    juce::dsp::ProcessContextReplacing<float> context(block);
+
+    // Filter (bereits Stereo-fähig)
+    if (!fx.filterBypass)
+    {
+        const DspLoadMonitor::ScopedStage measured(dspLoad, DspLoadMonitor::fxFilter);
+
+        for (auto& filter : fx.filters)
+            filter.process(context);
+    }
+
+    // EQ - Stereo Processing (Bypass wird in MasterEQ behandelt)
+    {
+        const DspLoadMonitor::ScopedStage measured(dspLoad, DspLoadMonitor::fxEQ);
+        fx.eq.process(block);
+    }
+
+    // Chorus (bereits Stereo-fähig)
+    if (!fx.chorusBypass)
+    {
+        const DspLoadMonitor::ScopedStage measured(dspLoad, DspLoadMonitor::fxChorus);
+        fx.chorus.process(context);
+    }
+
+    // Reverb (bereits Stereo-fähig)
+    if (!fx.reverbBypass)
+    {
+        const DspLoadMonitor::ScopedStage measured(dspLoad, DspLoadMonitor::fxReverb);
+        fx.reverb.process(context);
+    }
+
+    // Master Volume
+    const DspLoadMonitor::ScopedStage measured(dspLoad, DspLoadMonitor::fxMasterGain);
+
+    auto masterGain = juce::Decibels::decibelsToGain(fx.masterVolume);
+    if (masterGain != 1.0f)
+        block.multiplyBy(masterGain);
+}
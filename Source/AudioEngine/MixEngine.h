@@ -0,0 +1,195 @@
+/*
+  ==============================================================================
+
+    MixEngine.h
+    Created: 16 Oct 2026
+
+    The mixing core without any UI: both decks (with key lock), the sample
+    slots, deck routing to master and cue, the master FX chain (filter, EQ,
+    chorus, reverb, master gain), the stutter and the tempo of the line
+    inputs. MainComponent feeds it from the audio device, the offline
+    renderer feeds it block by block; both publish their controls as
+    EngineParameters snapshots.
+
+    The decks, sample slots and stutter are owned elsewhere (file browsers,
+    SamplePlayer, StutterEffectComponent, or the renderer) and attached by
+    pointer; a null pointer simply leaves that part of the mix silent.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include "Sampler.h"
+#include "SampleSlotBank.h"
+#include "StutterProcessor.h"
+#include "MixBusArena.h"
+#include "DspLoadMonitor.h"
+#include "LevelMeterSource.h"
+#include "EngineParameters.h"
+#include "MasterEQ.h"
+#include "TimeStretcher.h"
+#include "LiveTempoTracker.h"
+
+class MixEngine
+{
+public:
+    // === FX DSP CHAIN ===
+    struct FXChain
+    {
+        // Filter
+        std::array<juce::dsp::StateVariableTPTFilter<float>, 2> filters;
+        bool filterBypass = false;
+
+        // EQ - Koeffizienten werden nur bei Änderungen neu berechnet
+        MasterEQ eq;
+
+        // Chorus
+        juce::dsp::Chorus<float> chorus;
+        bool chorusBypass = false;
+
+        // Reverb
+        juce::dsp::Reverb reverb;
+        bool reverbBypass = false;
+
+        // Master Volume
+        float masterVolume = 0.0f; // dB
+
+        // Zuletzt angewendete Einstellungen, nur bei Änderungen werden Filter/Chorus/Reverb neu gesetzt
+        EngineParameters::Filter appliedFilter;
+        EngineParameters::Chorus appliedChorus;
+        EngineParameters::Reverb appliedReverb;
+        bool settingsApplied = false;
+
+        void prepare(const juce::dsp::ProcessSpec& spec)
+        {
+            for (auto& filter : filters)
+            {
+                filter.prepare(spec);
+                filter.reset();
+            }
+
+            eq.prepare(spec);
+
+            chorus.prepare(spec);
+            reverb.prepare(spec);
+
+            // Nach prepare() alles einmal neu anwenden
+            settingsApplied = false;
+        }
+
+        void reset()
+        {
+            for (auto& filter : filters)
+                filter.reset();
+
+            eq.reset();
+
+            chorus.reset();
+            reverb.reset();
+        }
+    };
+
+    // Pegel für die Meter, vom Audio-Thread geschrieben und von den LevelMeter-Timern abgefragt
+    struct Meters
+    {
+        LevelMeterSource deckA;     // vor dem Routing, also unabhängig von Fader und Crossfader
+        LevelMeterSource deckB;
+        LevelMeterSource master;    // nach FX und Stutter
+    };
+
+    MixEngine() = default;
+
+    //==============================================================================
+    // Message thread, before the audio starts or while it is stopped
+
+    void setDeck(int deck, Sampler* sampler) { decks[(size_t)deck] = sampler; }
+    void setSampleSlots(SampleSlotBank* bank) { sampleSlots = bank; }
+    void setStutter(StutterProcessor* processor) { stutter = processor; }
+
+    /** Allocates every bus and prepares the FX, the decks and the stutter. Not real-time safe. */
+    void prepareToPlay(double sampleRate, int maximumBlockSize);
+    void releaseResources();
+
+    double getSampleRate() const noexcept { return currentSampleRate; }
+
+    //==============================================================================
+    // Message thread
+
+    /** Computes the EQ coefficients for the current rate and hands the snapshot to the audio thread. */
+    void publishParameters(EngineParameters params);
+
+    void setKeyLockMode(TimeStretcher::Mode mode);
+    TimeStretcher::Mode getKeyLockMode() const { return keyLockStretchers[0].getMode(); }
+
+    DspLoadMonitor& getDspLoadMonitor() noexcept { return dspLoad; }
+    Meters& getMeters() noexcept { return meters; }
+
+    /** Estimates the line-input tempo from the onsets collected since the last call; call regularly (a UI timer). */
+    void updateLineInputTempo();
+
+    /** Running tempo at line input 0 (channels 1/2) or 1 (3/4), 0 without a signal. Any thread. */
+    double getLineInputBPM(int input) const;
+
+    //==============================================================================
+    // Audio thread
+
+    /**
+        Renders numSamples into outputData starting at startSample: the master
+        on channels 0/1 (overwritten), the cue on 2/3 (added, if present).
+        Blocks larger than the prepared size are rendered in pieces and the
+        levels go to getMeters(). Does not allocate or lock.
+
+        If the first numInputChannels channels still hold the device inputs,
+        each pair (a line input) goes through its tempo tracker's onset
+        detection and all channels are cleared before the mix is rendered.
+    */
+    void process(float* const* outputData, int numOutputChannels, int startSample, int numSamples,
+                 int numInputChannels = 0);
+
+private:
+    void processLineInputs(float* const* data, int numChannels, int numInputChannels, int startSample, int numSamples) noexcept;
+    void renderMixBlock(const EngineParameters& params, float* const* outputData, int outNumChans, int startSample, int numSamples);
+    void renderDeck(Sampler* sampler, TimeStretcher& stretcher, const EngineParameters::Deck& deck,
+        float* deckL, float* deckR, int numSamples);
+    void routeDeckToMaster(const EngineParameters::Deck& deck, EngineParameters::OutputDestination stereoDestination,
+        const float* deckL, const float* deckR, float* masterL, float* masterR, int numSamples);
+
+    void updateFXParameters(const EngineParameters& params);
+    void processFXChain(FXChain& fx, juce::dsp::AudioBlock<float> block);
+    void updateFilterParameters(FXChain& fx, const EngineParameters::Filter& filterParams);
+    void updateEQParameters(FXChain& fx, const EngineParameters::EQ& eqParams);
+    void updateChorusParameters(FXChain& fx, const EngineParameters::Chorus& chorusParams);
+    void updateReverbParameters(FXChain& fx, const EngineParameters::Reverb& reverbParamsIn);
+
+    // Quellen, gehören dem Aufrufer
+    std::array<Sampler*, 2> decks { nullptr, nullptr };
+    SampleSlotBank* sampleSlots = nullptr;
+    StutterProcessor* stutter = nullptr;
+
+    // Every deck, sample player, master, cue and scratch bus, sized in prepareToPlay
+    MixBusArena mixBuses;
+
+    // Key Lock je Deck (0 = A, 1 = B), zwischen Sampler und Deck-Bus
+    std::array<TimeStretcher, 2> keyLockStretchers;
+
+    // UI -> Audio Thread, veröffentlicht von publishParameters()
+    EngineParameterStore engineParameters;
+
+    FXChain masterFX; // Master FX Chain für alle Signale
+
+    // Zeitmessung je Stage, angezeigt im "DSP Load" Panel bzw. vom Offline-Renderer
+    DspLoadMonitor dspLoad;
+
+    Meters meters;
+
+    // Tempo der Line-Eingänge: Onsets im Audio Thread, Schätzung in updateLineInputTempo()
+    std::array<LiveTempoTracker, 2> lineInputTempo;
+
+    std::atomic<double> currentSampleRate { 44100.0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MixEngine)
+};
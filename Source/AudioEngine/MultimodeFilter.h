@@ -16,7 +16,7 @@
 #include "StereoEffect.h"
 #include "ModTarget.h"
 
-#include "../JuceLibraryCode/JuceHeader.h"
+#include <JuceHeader.h>
 
 class MultimodeFilter : public Filter, public StereoEffect, public ModTarget {
 
@@ -8,13 +8,13 @@
   ==============================================================================
 */
 #pragma once
-#include "../JuceLibraryCode/JuceHeader.h"
+#include <JuceHeader.h>
 
 struct OfflinePlayHead : public juce::AudioPlayHead
 {
     juce::AudioPlayHead::PositionInfo info;
 
-    virtual Optional<PositionInfo> getPosition() const
+    juce::Optional<PositionInfo> getPosition() const override
     {
         return info;
     }
@@ -27,7 +27,7 @@ struct OfflinePlayHead : public juce::AudioPlayHead
         info.setTimeInSamples(samplePos);
         info.setTimeInSeconds(samplePos / sampleRate);
         info.setBpm(bpm);
-		info.setTimeSignature(TimeSignature(4, 4)); // Default time signature
+		info.setTimeSignature(juce::AudioPlayHead::TimeSignature { 4, 4 }); // Default time signature
 
         info.setPpqPosition(ppq);
         info.setPpqPositionOfLastBarStart(0.0);
@@ -0,0 +1,144 @@
+/*
+  ==============================================================================
+
+    OnsetDetector.cpp
+    Created: 16 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "OnsetDetector.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // log(1 + compression * |X|): leise Anteile zählen mit, laute dominieren nicht
+    constexpr float logCompression = 1000.0f;
+    constexpr double lowBandLimit = 200.0;
+}
+
+//==============================================================================
+void OnsetDetector::prepare(double sampleRate)
+{
+    decimation = juce::jmax(1, juce::roundToInt(sampleRate / targetAnalysisRate));
+    analysisRate = sampleRate / decimation;
+    lowBandBins = juce::jmax(1, (int)(lowBandLimit * fftSize / analysisRate));
+
+    fft = std::make_unique<juce::dsp::FFT>(fftOrder);
+
+    window.resize((size_t)fftSize);
+    for (int i = 0; i < fftSize; ++i)
+        window[(size_t)i] = 0.5f - 0.5f * std::cos(juce::MathConstants<float>::twoPi * (float)i / (float)fftSize);
+
+    ring.assign((size_t)fftSize, 0.0f);
+    fftData.assign((size_t)(2 * fftSize), 0.0f);
+    previousSpectrum.assign((size_t)(fftSize / 2 + 1), 0.0f);
+
+    reset();
+}
+
+void OnsetDetector::reset() noexcept
+{
+    std::fill(ring.begin(), ring.end(), 0.0f);
+    std::fill(previousSpectrum.begin(), previousSpectrum.end(), 0.0f);
+
+    ringPosition = 0;
+    samplesInRing = 0;
+    samplesSinceFrame = 0;
+    havePreviousSpectrum = false;
+
+    decimationSum = 0.0f;
+    decimationCount = 0;
+}
+
+int OnsetDetector::getMaxFramesForSamples(juce::int64 numSamples) const noexcept
+{
+    return (int)(numSamples / getSamplesPerFrame()) + 1;
+}
+
+int OnsetDetector::process(const float* const* channels, int numChannels, int numSamples, float* onsetOut, int maxFrames,
+                           float* lowBandOut) noexcept
+{
+    if (fft == nullptr || numChannels <= 0)
+        return 0;
+
+    const float channelGain = 1.0f / (float)(numChannels * decimation);
+    int numFrames = 0;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        float mono = 0.0f;
+        for (int channel = 0; channel < numChannels; ++channel)
+            mono += channels[channel][i];
+
+        decimationSum += mono;
+
+        if (++decimationCount < decimation)
+            continue;
+
+        // Mittelwert über decimation Samples: grober Tiefpass, reicht für Onsets
+        ring[(size_t)ringPosition] = decimationSum * channelGain;
+        ringPosition = (ringPosition + 1) & (fftSize - 1);
+        samplesInRing = juce::jmin(fftSize, samplesInRing + 1);
+        decimationSum = 0.0f;
+        decimationCount = 0;
+
+        if (++samplesSinceFrame < hopSize)
+            continue;
+
+        samplesSinceFrame = 0;
+
+        if (samplesInRing < fftSize)
+            continue;
+
+        float flux = 0.0f, lowBandFlux = 0.0f;
+        computeFrame(flux, lowBandFlux);
+
+        if (numFrames < maxFrames)
+        {
+            onsetOut[numFrames] = flux;
+
+            if (lowBandOut != nullptr)
+                lowBandOut[numFrames] = lowBandFlux;
+
+            ++numFrames;
+        }
+    }
+
+    return numFrames;
+}
+
+void OnsetDetector::computeFrame(float& flux, float& lowBandFlux) noexcept
+{
+    // Ältestes Sample liegt an ringPosition
+    for (int i = 0; i < fftSize; ++i)
+        fftData[(size_t)i] = ring[(size_t)((ringPosition + i) & (fftSize - 1))] * window[(size_t)i];
+
+    std::fill(fftData.begin() + fftSize, fftData.end(), 0.0f);
+    fft->performFrequencyOnlyForwardTransform(fftData.data(), true);
+
+    const float normalisation = 2.0f / (float)fftSize;
+    flux = 0.0f;
+    lowBandFlux = 0.0f;
+
+    for (int bin = 1; bin <= fftSize / 2; ++bin)
+    {
+        const float magnitude = std::log1p(logCompression * fftData[(size_t)bin] * normalisation);
+        const float rise = juce::jmax(0.0f, magnitude - previousSpectrum[(size_t)bin]);
+        previousSpectrum[(size_t)bin] = magnitude;
+
+        flux += rise;
+
+        if (bin <= lowBandBins)
+            lowBandFlux += rise;
+    }
+
+    // Der erste Frame hätte keinen Vorgänger und wäre ein riesiger Scheinonset
+    if (!havePreviousSpectrum)
+    {
+        havePreviousSpectrum = true;
+        flux = 0.0f;
+        lowBandFlux = 0.0f;
+    }
+}
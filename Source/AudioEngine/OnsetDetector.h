@@ -0,0 +1,93 @@
+/*
+  ==============================================================================
+
+    OnsetDetector.h
+    Created: 16 Oct 2026
+
+    Spectral-flux onset envelope for tempo and beat analysis. The input is
+    mixed to mono and decimated by averaging to about 11 kHz, then analysed
+    with 512-point Hann frames (JUCE FFT) every 128 samples, i.e. roughly
+    86 onset frames per second at any device rate. Each frame's value is the
+    half-wave rectified rise of the log-compressed magnitude spectrum over
+    the previous frame, so kicks, snares and hats all count, not just loud
+    passages. A second envelope holds the flux below ~200 Hz only (kick and
+    bass), for downbeat detection.
+
+    Streaming: feed any block size, get the finished frames back. Everything
+    is allocated in prepare(); process() neither allocates nor locks.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <memory>
+#include <vector>
+
+class OnsetDetector
+{
+public:
+    static constexpr int fftOrder = 9;
+    static constexpr int fftSize = 1 << fftOrder;
+    static constexpr int hopSize = 128;
+    static constexpr double targetAnalysisRate = 11025.0;
+
+    OnsetDetector() = default;
+
+    /** Not real-time safe. */
+    void prepare(double sampleRate);
+    void reset() noexcept;
+
+    /** Onset frames per second. */
+    double getFrameRate() const noexcept { return analysisRate / hopSize; }
+
+    /** Upper bound for the frames process() can return for numSamples input samples. */
+    int getMaxFramesForSamples(juce::int64 numSamples) const noexcept;
+
+    /** Input samples (at the prepared rate) per onset frame. */
+    int getSamplesPerFrame() const noexcept { return hopSize * decimation; }
+
+    /**
+        Time in seconds from the start of the input at which an onset
+        peaking in the given (fractional) frame happened. Accounts for the
+        window: the flux rises most while a new event crosses the steepest
+        part of the Hann window, a quarter window before its end.
+    */
+    double getFrameTime(double frame) const noexcept
+    {
+        return ((double)(fftSize - fftSize / 4) + frame * hopSize) / analysisRate;
+    }
+
+    /**
+        Adds numSamples of audio (channels are averaged) and writes one flux
+        value per completed frame to onsetOut, at most maxFrames, and the
+        low-band flux to lowBandOut if given. Returns the number of frames
+        written.
+    */
+    int process(const float* const* channels, int numChannels, int numSamples, float* onsetOut, int maxFrames,
+                float* lowBandOut = nullptr) noexcept;
+
+private:
+    void computeFrame(float& flux, float& lowBandFlux) noexcept;
+
+    double analysisRate = targetAnalysisRate;
+    int decimation = 1;
+    int lowBandBins = 1;
+
+    std::unique_ptr<juce::dsp::FFT> fft;
+    std::vector<float> window;
+    std::vector<float> ring;            // letzte fftSize dezimierte Samples
+    std::vector<float> fftData;         // 2 * fftSize
+    std::vector<float> previousSpectrum;
+
+    int ringPosition = 0;
+    int samplesInRing = 0;
+    int samplesSinceFrame = 0;
+    bool havePreviousSpectrum = false;
+
+    float decimationSum = 0.0f;
+    int decimationCount = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OnsetDetector)
+};
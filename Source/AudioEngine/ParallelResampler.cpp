@@ -0,0 +1,119 @@
+/*
+  ==============================================================================
+
+    ParallelResampler.cpp
+    Created: 16 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "ParallelResampler.h"
+#include <atomic>
+#include <cmath>
+
+juce::ThreadPool& ParallelResampler::getThreadPool()
+{
+    static juce::ThreadPool pool(juce::jmax(1, juce::SystemStats::getNumCpus() - 1));
+    return pool;
+}
+
+int ParallelResampler::getOutputLength(int numInputFrames, double fromRate, double toRate) noexcept
+{
+    if (numInputFrames <= 0 || fromRate <= 0.0 || toRate <= 0.0)
+        return 0;
+
+    return (int)std::ceil((double)numInputFrames * toRate / fromRate);
+}
+
+void ParallelResampler::convertChunk(const Resampler& resampler, const float* srcL, const float* srcR,
+                                     float* outL, float* outR, int inputLength, int firstFrame, int numFrames,
+                                     double step) noexcept
+{
+    for (int i = 0; i < numFrames; ++i)
+    {
+        // Position direkt aus dem Index, damit das Ergebnis nicht von der Aufteilung abhängt
+        const double exact = (double)(firstFrame + i) * step;
+        const long position = (long)exact;
+        const float fraction = (float)(exact - (double)position);
+
+        float left, right;
+        resampler.readFrame(srcL, srcR, position, fraction, step, 0, inputLength, false, left, right);
+
+        outL[i] = left;
+        if (outR != nullptr)
+            outR[i] = right;
+    }
+}
+
+void ParallelResampler::process(const juce::AudioBuffer<float>& input, juce::AudioBuffer<float>& output,
+                                double fromRate, double toRate, Resampler::Quality quality, bool serial)
+{
+    const int numChannels = input.getNumChannels();
+    const int inputLength = input.getNumSamples();
+    const int outputLength = getOutputLength(inputLength, fromRate, toRate);
+
+    output.setSize(numChannels, juce::jmax(0, outputLength));
+
+    if (numChannels == 0 || outputLength <= 0)
+        return;
+
+    const double step = fromRate / toRate;
+
+    // readFrame ist const und zustandslos, ein Resampler genügt für alle Jobs
+    Resampler resampler;
+    resampler.setQuality(quality);
+
+    // Ein Job je Kanalpaar und Chunk; ein ungerader letzter Kanal läuft als Mono (links = rechts)
+    struct Job
+    {
+        int channel;
+        bool stereo;
+        int firstFrame;
+        int numFrames;
+    };
+
+    juce::Array<Job> jobs;
+
+    for (int channel = 0; channel < numChannels; channel += 2)
+        for (int first = 0; first < outputLength; first += chunkFrames)
+            jobs.add({ channel, channel + 1 < numChannels, first, juce::jmin(chunkFrames, outputLength - first) });
+
+    // Zeiger einmal hier holen: getWritePointer() setzt das isClear-Flag des Buffers,
+    // das dürfen die Pool-Threads nicht gleichzeitig anfassen
+    const float* const* sources = input.getArrayOfReadPointers();
+    float* const* destinations = output.getArrayOfWritePointers();
+
+    auto runJob = [&](const Job& job)
+    {
+        const float* srcL = sources[job.channel];
+        const float* srcR = sources[job.stereo ? job.channel + 1 : job.channel];
+        float* outL = destinations[job.channel] + job.firstFrame;
+        float* outR = job.stereo ? destinations[job.channel + 1] + job.firstFrame : nullptr;
+
+        convertChunk(resampler, srcL, srcR, outL, outR, inputLength, job.firstFrame, job.numFrames, step);
+    };
+
+    if (serial || jobs.size() == 1)
+    {
+        for (const auto& job : jobs)
+            runJob(job);
+
+        return;
+    }
+
+    std::atomic<int> remaining { jobs.size() };
+    juce::WaitableEvent finished;
+
+    for (const auto& job : jobs)
+    {
+        getThreadPool().addJob([&runJob, &remaining, &finished, job]
+        {
+            runJob(job);
+
+            if (--remaining == 0)
+                finished.signal();
+        });
+    }
+
+    finished.wait();
+}
@@ -0,0 +1,55 @@
+/*
+  ==============================================================================
+
+    ParallelResampler.h
+    Created: 16 Oct 2026
+
+    Offline sample-rate conversion of a whole buffer, spread over a thread
+    pool. The output is cut into chunks of chunkFrames frames and every
+    chunk/channel pair is converted by its own job.
+
+    Each output frame is computed from its own index through
+    Resampler::readFrame (source position = index * step, no running
+    accumulator), and every job reads the complete, shared input. The
+    filter's guard region around a chunk is therefore simply the
+    neighbouring input: nothing is copied, and a chunk's frames are the
+    same bits whichever thread computes them. Any chunking, including a
+    single serial run, gives an identical result.
+
+    Blocks the calling thread until all chunks are done; call it from a
+    loader thread, not from the audio or message thread.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Resampler.h"
+
+class ParallelResampler
+{
+public:
+    static constexpr int chunkFrames = 65536;
+
+    /**
+        Converts input from fromRate to toRate with the given quality. Mono
+        channels and channel pairs are converted independently. With serial
+        set, everything runs on the calling thread (reference for tests and
+        small buffers).
+    */
+    static void process(const juce::AudioBuffer<float>& input, juce::AudioBuffer<float>& output,
+                        double fromRate, double toRate,
+                        Resampler::Quality quality = Resampler::Quality::WindowedSinc,
+                        bool serial = false);
+
+    /** Number of output frames for numInputFrames converted from fromRate to toRate. */
+    static int getOutputLength(int numInputFrames, double fromRate, double toRate) noexcept;
+
+private:
+    static juce::ThreadPool& getThreadPool();
+
+    static void convertChunk(const Resampler& resampler, const float* srcL, const float* srcR,
+                             float* outL, float* outR, int inputLength, int firstFrame, int numFrames,
+                             double step) noexcept;
+};
@@ -13,7 +13,7 @@
 #include <math.h>
 #include <iostream>
 
-#include "../JuceLibraryCode/JuceHeader.h"
+#include <JuceHeader.h>
 
 Pulse::Pulse(float sampleRate, int buffersize) : Oszillator(sampleRate) {
     this->volume = 1.0f;
@@ -0,0 +1,271 @@
+/*
+  ==============================================================================
+
+    RealtimeSanitizer.cpp
+    Created: 16 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "RealtimeSanitizer.h"
+
+#if RADIOBLAST_RT_SANITIZER
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#if JUCE_LINUX || JUCE_BSD || JUCE_MAC
+ #include <cxxabi.h>
+ #include <dlfcn.h>
+ #include <execinfo.h>
+ #define RADIOBLAST_RTSAN_BACKTRACE 1
+#else
+ #define RADIOBLAST_RTSAN_BACKTRACE 0
+#endif
+
+namespace
+{
+    constexpr int maxFrames = 32;
+    constexpr int skippedFrames = 2;    // record() und radioblast_rtsan_check()
+    constexpr int tableSize = 1024;     // Zweierpotenz, offene Adressierung
+
+    struct CallSite
+    {
+        std::atomic<juce::uint64> key { 0 };        // 0 = frei
+        std::atomic<bool> ready { false };          // Frames geschrieben
+        std::atomic<juce::int64> count { 0 };
+        const char* function = nullptr;
+        int numFrames = 0;
+        void* frames[maxFrames] {};
+    };
+
+    // Feste Tabelle, damit das Aufzeichnen selbst nichts allokiert
+    CallSite callSites[tableSize];
+
+    std::atomic<juce::int64> violations { 0 };
+    std::atomic<juce::int64> droppedCallSites { 0 };
+    std::atomic<bool> hooksSeen { false };
+
+    thread_local int regionDepth = 0;
+    thread_local bool insideCheck = false;
+
+    const bool haltOnViolation = std::getenv("RADIOBLAST_RTSAN_HALT") != nullptr;
+
+    juce::String describeFrame(void* address)
+    {
+       #if RADIOBLAST_RTSAN_BACKTRACE
+        Dl_info info {};
+
+        if (dladdr(address, &info) != 0)
+        {
+            const auto module = info.dli_fname != nullptr ? juce::File(info.dli_fname).getFileName() : juce::String("?");
+            const auto base = (juce::pointer_sized_uint)info.dli_fbase;
+            const auto moduleOffset = (juce::pointer_sized_uint)address - base;
+
+            if (info.dli_sname != nullptr)
+            {
+                int status = 0;
+                char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+                const juce::String name = status == 0 && demangled != nullptr ? juce::String(demangled) : juce::String(info.dli_sname);
+                std::free(demangled);
+
+                const auto symbolOffset = (juce::pointer_sized_uint)address - (juce::pointer_sized_uint)info.dli_saddr;
+                return name + " +0x" + juce::String::toHexString((juce::int64)symbolOffset)
+                     + "  (" + module + " +0x" + juce::String::toHexString((juce::int64)moduleOffset) + ")";
+            }
+
+            // Ohne Symbol (statische Funktion, kein -rdynamic): Modul + Offset für addr2line
+            return module + " +0x" + juce::String::toHexString((juce::int64)moduleOffset);
+        }
+       #endif
+
+        return "0x" + juce::String::toHexString((juce::int64)(juce::pointer_sized_uint)address);
+    }
+
+    void record(const char* function)
+    {
+        void* frames[maxFrames + skippedFrames];
+        int numCaptured = 0;
+
+       #if RADIOBLAST_RTSAN_BACKTRACE
+        numCaptured = ::backtrace(frames, maxFrames + skippedFrames);
+       #endif
+
+        const int first = juce::jmin(skippedFrames, numCaptured);
+        const int numFrames = numCaptured - first;
+
+        // FNV-1a über Funktion und Rücksprungadressen: gleicher Pfad, gleiche Aufrufstelle
+        juce::uint64 hash = 14695981039346656037ull;
+        auto mix = [&hash](juce::uint64 value) { hash = (hash ^ value) * 1099511628211ull; };
+
+        mix((juce::uint64)(juce::pointer_sized_uint)function);
+
+        for (int i = 0; i < numFrames; ++i)
+            mix((juce::uint64)(juce::pointer_sized_uint)frames[first + i]);
+
+        if (hash == 0)
+            hash = 1;
+
+        violations.fetch_add(1, std::memory_order_relaxed);
+
+        for (int probe = 0; probe < tableSize; ++probe)
+        {
+            auto& site = callSites[(hash + (juce::uint64)probe) & (tableSize - 1)];
+            auto key = site.key.load(std::memory_order_acquire);
+
+            if (key == 0)
+            {
+                if (site.key.compare_exchange_strong(key, hash, std::memory_order_acq_rel))
+                {
+                    site.function = function;
+                    site.numFrames = numFrames;
+                    std::copy(frames + first, frames + first + numFrames, site.frames);
+                    site.ready.store(true, std::memory_order_release);
+                    site.count.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+
+                // Ein anderer Thread war schneller, key enthält jetzt dessen Hash
+            }
+
+            if (key == hash)
+            {
+                site.count.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+        }
+
+        droppedCallSites.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    struct ReportAtExit
+    {
+        ~ReportAtExit()
+        {
+            if (violations.load() == 0)
+                return;
+
+            const auto report = RealtimeSanitizer::createReport();
+            std::fputs(report.toRawUTF8(), stderr);
+
+            if (const char* path = std::getenv("RADIOBLAST_RTSAN_REPORT"))
+            {
+                if (auto* file = std::fopen(path, "w"))
+                {
+                    std::fputs(report.toRawUTF8(), file);
+                    std::fclose(file);
+                }
+            }
+        }
+    };
+
+    ReportAtExit reportAtExit;
+}
+
+//==============================================================================
+// Von den Hooks in RealtimeSanitizerHooks.c vor jedem abgefangenen Aufruf gerufen
+extern "C" void radioblast_rtsan_check(const char* function)
+{
+    if (regionDepth <= 0 || insideCheck)
+        return;
+
+    // Alles, was record() und der Report selbst aufrufen, nicht noch einmal melden
+    insideCheck = true;
+    record(function);
+
+    if (haltOnViolation)
+    {
+        std::fputs(RealtimeSanitizer::createReport().toRawUTF8(), stderr);
+        std::abort();
+    }
+
+    insideCheck = false;
+}
+
+// Vom Konstruktor der Hooks gerufen, sobald sie geladen sind
+extern "C" void radioblast_rtsan_hooks_loaded()
+{
+    hooksSeen.store(true, std::memory_order_relaxed);
+}
+
+//==============================================================================
+void RealtimeSanitizer::enterRegion() noexcept
+{
+    ++regionDepth;
+}
+
+void RealtimeSanitizer::leaveRegion() noexcept
+{
+    --regionDepth;
+}
+
+bool RealtimeSanitizer::isInterposing() noexcept
+{
+    return hooksSeen.load(std::memory_order_relaxed);
+}
+
+juce::int64 RealtimeSanitizer::getViolationCount() noexcept
+{
+    return violations.load(std::memory_order_relaxed);
+}
+
+int RealtimeSanitizer::getNumCallSites() noexcept
+{
+    int numSites = 0;
+
+    for (const auto& site : callSites)
+        if (site.ready.load(std::memory_order_acquire) && site.count.load(std::memory_order_relaxed) > 0)
+            ++numSites;
+
+    return numSites;
+}
+
+juce::String RealtimeSanitizer::createReport(int maxCallSites)
+{
+    std::vector<const CallSite*> sites;
+
+    for (const auto& site : callSites)
+        if (site.ready.load(std::memory_order_acquire) && site.count.load(std::memory_order_relaxed) > 0)
+            sites.push_back(&site);
+
+    std::sort(sites.begin(), sites.end(), [](const CallSite* a, const CallSite* b)
+              { return a->count.load(std::memory_order_relaxed) > b->count.load(std::memory_order_relaxed); });
+
+    juce::String report;
+    report << "RealtimeSanitizer: " << getViolationCount() << " violation(s) at " << (int)sites.size()
+           << " call site(s) inside real-time regions\n";
+
+    if (!isInterposing())
+        report << "  (no libc hooks active - RealtimeSanitizerHooks.c not linked or platform not supported)\n";
+
+    for (int i = 0; i < juce::jmin(maxCallSites, (int)sites.size()); ++i)
+    {
+        const auto& site = *sites[(size_t)i];
+        report << "\n" << site.count.load(std::memory_order_relaxed) << " x " << site.function << "\n";
+
+        for (int frame = 0; frame < site.numFrames; ++frame)
+            report << "    #" << frame << "  " << describeFrame(site.frames[frame]) << "\n";
+    }
+
+    if (maxCallSites < (int)sites.size())
+        report << "\n... " << ((int)sites.size() - maxCallSites) << " more call site(s)\n";
+
+    if (const auto dropped = droppedCallSites.load(std::memory_order_relaxed); dropped > 0)
+        report << "\n" << dropped << " violation(s) not attributed, call site table full\n";
+
+    return report;
+}
+
+void RealtimeSanitizer::reset() noexcept
+{
+    violations.store(0, std::memory_order_relaxed);
+    droppedCallSites.store(0, std::memory_order_relaxed);
+
+    for (auto& site : callSites)
+        site.count.store(0, std::memory_order_relaxed);
+}
+
+#endif
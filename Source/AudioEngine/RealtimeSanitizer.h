@@ -0,0 +1,83 @@
+/*
+  ==============================================================================
+
+    RealtimeSanitizer.h
+    Created: 16 Oct 2026
+
+    Finds non real-time work on the audio thread. While a
+    ScopedRealtimeRegion is alive on a thread, every call that thread makes
+    to the heap (malloc, calloc, realloc, free, aligned allocation), to a
+    blocking lock (pthread mutex and rwlock) or to a blocking syscall / stdio
+    function (read, write, open, close, mmap, munmap, sleeps, fwrite,
+    printf, ...) is recorded with its backtrace. Identical backtraces are
+    one call site with a counter, so a report lists every offending path
+    once, most frequent first.
+
+    Build with RADIOBLAST_RT_SANITIZER=1 and add RealtimeSanitizerHooks.c to
+    the executable (the CMake option of the same name does both). The hooks
+    interpose the libc symbols and are only implemented for Linux / glibc;
+    elsewhere the regions compile but nothing is intercepted. With the flag
+    off everything here compiles to nothing.
+
+    Recording does not allocate or lock: call sites live in a fixed table,
+    and symbols are only resolved when a report is created. At exit a
+    report is printed to stderr if anything was caught, and written to the
+    file named by RADIOBLAST_RTSAN_REPORT if set. RADIOBLAST_RTSAN_HALT=1
+    aborts with a report on the first violation.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#ifndef RADIOBLAST_RT_SANITIZER
+ #define RADIOBLAST_RT_SANITIZER 0
+#endif
+
+namespace RealtimeSanitizer
+{
+   #if RADIOBLAST_RT_SANITIZER
+    void enterRegion() noexcept;
+    void leaveRegion() noexcept;
+
+    /** True when the libc hooks are linked in and active on this platform. */
+    bool isInterposing() noexcept;
+
+    /** Violations caught since startup or the last reset(). */
+    juce::int64 getViolationCount() noexcept;
+
+    /** Number of distinct call sites (function + backtrace) caught. */
+    int getNumCallSites() noexcept;
+
+    /** Symbolized report of the call sites, most frequent first. Allocates, not for the audio thread. */
+    juce::String createReport(int maxCallSites = 32);
+
+    /** Clears the counters; call sites stay in the table but are not reported until hit again. */
+    void reset() noexcept;
+
+    class ScopedRealtimeRegion
+    {
+    public:
+        ScopedRealtimeRegion() noexcept  { enterRegion(); }
+        ~ScopedRealtimeRegion() noexcept { leaveRegion(); }
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedRealtimeRegion)
+    };
+   #else
+    inline bool isInterposing() noexcept { return false; }
+    inline juce::int64 getViolationCount() noexcept { return 0; }
+    inline int getNumCallSites() noexcept { return 0; }
+    inline juce::String createReport(int = 32) { return {}; }
+    inline void reset() noexcept {}
+
+    class ScopedRealtimeRegion
+    {
+    public:
+        ScopedRealtimeRegion() noexcept {}
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedRealtimeRegion)
+    };
+   #endif
+}
@@ -0,0 +1,322 @@
+/*
+  ==============================================================================
+
+    RealtimeSanitizerHooks.c
+    Created: 16 Oct 2026
+
+    libc interposers for the RealtimeSanitizer (see RealtimeSanitizer.h).
+    Linked into the executable, these definitions take precedence over the
+    ones in libc; each reports itself to radioblast_rtsan_check() and then
+    forwards to the real implementation. The heap goes to glibc's
+    __libc_* entry points, everything else is looked up with
+    dlsym(RTLD_NEXT) once at load time.
+
+    Written in C so the definitions need not match the C++ exception
+    specifications of the libc headers. Linux / glibc only.
+
+  ==============================================================================
+*/
+
+#if defined (RADIOBLAST_RT_SANITIZER) && RADIOBLAST_RT_SANITIZER && defined (__linux__)
+
+#ifndef _GNU_SOURCE
+ #define _GNU_SOURCE
+#endif
+
+/* Fortify would turn printf, open, ... into inline wrappers we cannot redefine */
+#undef _FORTIFY_SOURCE
+
+#include <dlfcn.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+#if defined (__GLIBC__)
+
+/* RealtimeSanitizer.cpp */
+void radioblast_rtsan_check (const char* function);
+void radioblast_rtsan_hooks_loaded (void);
+
+/* glibc's own allocator entry points, no dlsym needed (dlsym itself allocates) */
+extern void* __libc_malloc (size_t);
+extern void* __libc_calloc (size_t, size_t);
+extern void* __libc_realloc (void*, size_t);
+extern void  __libc_free (void*);
+extern void* __libc_memalign (size_t, size_t);
+
+/*==============================================================================
+    Heap
+*/
+void* malloc (size_t size)
+{
+    radioblast_rtsan_check ("malloc");
+    return __libc_malloc (size);
+}
+
+void* calloc (size_t count, size_t size)
+{
+    radioblast_rtsan_check ("calloc");
+    return __libc_calloc (count, size);
+}
+
+void* realloc (void* ptr, size_t size)
+{
+    radioblast_rtsan_check ("realloc");
+    return __libc_realloc (ptr, size);
+}
+
+void free (void* ptr)
+{
+    if (ptr != NULL)
+        radioblast_rtsan_check ("free");
+
+    __libc_free (ptr);
+}
+
+void* memalign (size_t alignment, size_t size)
+{
+    radioblast_rtsan_check ("memalign");
+    return __libc_memalign (alignment, size);
+}
+
+void* aligned_alloc (size_t alignment, size_t size)
+{
+    radioblast_rtsan_check ("aligned_alloc");
+    return __libc_memalign (alignment, size);
+}
+
+int posix_memalign (void** result, size_t alignment, size_t size)
+{
+    void* ptr;
+
+    radioblast_rtsan_check ("posix_memalign");
+
+    if (alignment % sizeof (void*) != 0 || (alignment & (alignment - 1)) != 0)
+        return EINVAL;
+
+    ptr = __libc_memalign (alignment, size);
+
+    if (ptr == NULL)
+        return ENOMEM;
+
+    *result = ptr;
+    return 0;
+}
+
+/*==============================================================================
+    Locks, syscalls and stdio - the real functions are resolved at load time
+*/
+static int   (*real_pthread_mutex_lock) (pthread_mutex_t*);
+static int   (*real_pthread_rwlock_rdlock) (pthread_rwlock_t*);
+static int   (*real_pthread_rwlock_wrlock) (pthread_rwlock_t*);
+static ssize_t (*real_read) (int, void*, size_t);
+static ssize_t (*real_write) (int, const void*, size_t);
+static int   (*real_open) (const char*, int, ...);
+static int   (*real_close) (int);
+static void* (*real_mmap) (void*, size_t, int, int, int, off_t);
+static int   (*real_munmap) (void*, size_t);
+static int   (*real_nanosleep) (const struct timespec*, struct timespec*);
+static int   (*real_usleep) (useconds_t);
+static int   (*real_sched_yield) (void);
+static size_t (*real_fwrite) (const void*, size_t, size_t, FILE*);
+static int   (*real_fputs) (const char*, FILE*);
+static int   (*real_fputc) (int, FILE*);
+static int   (*real_puts) (const char*);
+static int   (*real_fflush) (FILE*);
+static int   (*real_vfprintf) (FILE*, const char*, va_list);
+
+#define RTSAN_RESOLVE(name) \
+    if (real_##name == NULL) \
+        *(void**) (&real_##name) = dlsym (RTLD_NEXT, #name)
+
+__attribute__ ((constructor)) static void radioblast_rtsan_resolve (void)
+{
+    RTSAN_RESOLVE (pthread_mutex_lock);
+    RTSAN_RESOLVE (pthread_rwlock_rdlock);
+    RTSAN_RESOLVE (pthread_rwlock_wrlock);
+    RTSAN_RESOLVE (read);
+    RTSAN_RESOLVE (write);
+    RTSAN_RESOLVE (open);
+    RTSAN_RESOLVE (close);
+    RTSAN_RESOLVE (mmap);
+    RTSAN_RESOLVE (munmap);
+    RTSAN_RESOLVE (nanosleep);
+    RTSAN_RESOLVE (usleep);
+    RTSAN_RESOLVE (sched_yield);
+    RTSAN_RESOLVE (fwrite);
+    RTSAN_RESOLVE (fputs);
+    RTSAN_RESOLVE (fputc);
+    RTSAN_RESOLVE (puts);
+    RTSAN_RESOLVE (fflush);
+    RTSAN_RESOLVE (vfprintf);
+
+    radioblast_rtsan_hooks_loaded();
+}
+
+int pthread_mutex_lock (pthread_mutex_t* mutex)
+{
+    radioblast_rtsan_check ("pthread_mutex_lock");
+    RTSAN_RESOLVE (pthread_mutex_lock);
+    return real_pthread_mutex_lock (mutex);
+}
+
+int pthread_rwlock_rdlock (pthread_rwlock_t* lock)
+{
+    radioblast_rtsan_check ("pthread_rwlock_rdlock");
+    RTSAN_RESOLVE (pthread_rwlock_rdlock);
+    return real_pthread_rwlock_rdlock (lock);
+}
+
+int pthread_rwlock_wrlock (pthread_rwlock_t* lock)
+{
+    radioblast_rtsan_check ("pthread_rwlock_wrlock");
+    RTSAN_RESOLVE (pthread_rwlock_wrlock);
+    return real_pthread_rwlock_wrlock (lock);
+}
+
+ssize_t read (int fd, void* buffer, size_t size)
+{
+    radioblast_rtsan_check ("read");
+    RTSAN_RESOLVE (read);
+    return real_read (fd, buffer, size);
+}
+
+ssize_t write (int fd, const void* buffer, size_t size)
+{
+    radioblast_rtsan_check ("write");
+    RTSAN_RESOLVE (write);
+    return real_write (fd, buffer, size);
+}
+
+int open (const char* path, int flags, ...)
+{
+    mode_t mode = 0;
+
+    if ((flags & O_CREAT) != 0 || (flags & O_TMPFILE) == O_TMPFILE)
+    {
+        va_list args;
+        va_start (args, flags);
+        mode = (mode_t) va_arg (args, int);
+        va_end (args);
+    }
+
+    radioblast_rtsan_check ("open");
+    RTSAN_RESOLVE (open);
+    return real_open (path, flags, mode);
+}
+
+int close (int fd)
+{
+    radioblast_rtsan_check ("close");
+    RTSAN_RESOLVE (close);
+    return real_close (fd);
+}
+
+void* mmap (void* address, size_t length, int protection, int flags, int fd, off_t offset)
+{
+    radioblast_rtsan_check ("mmap");
+    RTSAN_RESOLVE (mmap);
+    return real_mmap (address, length, protection, flags, fd, offset);
+}
+
+int munmap (void* address, size_t length)
+{
+    radioblast_rtsan_check ("munmap");
+    RTSAN_RESOLVE (munmap);
+    return real_munmap (address, length);
+}
+
+int nanosleep (const struct timespec* duration, struct timespec* remaining)
+{
+    radioblast_rtsan_check ("nanosleep");
+    RTSAN_RESOLVE (nanosleep);
+    return real_nanosleep (duration, remaining);
+}
+
+int usleep (useconds_t microseconds)
+{
+    radioblast_rtsan_check ("usleep");
+    RTSAN_RESOLVE (usleep);
+    return real_usleep (microseconds);
+}
+
+int sched_yield (void)
+{
+    radioblast_rtsan_check ("sched_yield");
+    RTSAN_RESOLVE (sched_yield);
+    return real_sched_yield();
+}
+
+/* std::cout und printf landen hier, glibc ruft intern nicht das exportierte write() */
+size_t fwrite (const void* data, size_t size, size_t count, FILE* stream)
+{
+    radioblast_rtsan_check ("fwrite");
+    RTSAN_RESOLVE (fwrite);
+    return real_fwrite (data, size, count, stream);
+}
+
+int fputs (const char* text, FILE* stream)
+{
+    radioblast_rtsan_check ("fputs");
+    RTSAN_RESOLVE (fputs);
+    return real_fputs (text, stream);
+}
+
+int fputc (int character, FILE* stream)
+{
+    radioblast_rtsan_check ("fputc");
+    RTSAN_RESOLVE (fputc);
+    return real_fputc (character, stream);
+}
+
+int puts (const char* text)
+{
+    radioblast_rtsan_check ("puts");
+    RTSAN_RESOLVE (puts);
+    return real_puts (text);
+}
+
+int fflush (FILE* stream)
+{
+    radioblast_rtsan_check ("fflush");
+    RTSAN_RESOLVE (fflush);
+    return real_fflush (stream);
+}
+
+int printf (const char* format, ...)
+{
+    va_list args;
+    int result;
+
+    radioblast_rtsan_check ("printf");
+    RTSAN_RESOLVE (vfprintf);
+
+    va_start (args, format);
+    result = real_vfprintf (stdout, format, args);
+    va_end (args);
+    return result;
+}
+
+int fprintf (FILE* stream, const char* format, ...)
+{
+    va_list args;
+    int result;
+
+    radioblast_rtsan_check ("fprintf");
+    RTSAN_RESOLVE (vfprintf);
+
+    va_start (args, format);
+    result = real_vfprintf (stream, format, args);
+    va_end (args);
+    return result;
+}
+
+#endif /* __GLIBC__ */
+#endif
@@ -0,0 +1,310 @@
+/*
+  ==============================================================================
+
+    Resampler.cpp
+    Created: 16 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "Resampler.h"
+#include <cmath>
+#include <cstdint>
+
+namespace
+{
+    constexpr int halfTaps = Resampler::numTaps / 2;
+    constexpr double baseCutoff = 0.95;     // Anteil der Nyquist-Frequenz bei Rate <= 1
+
+    // Raten-Stufen für die Sinc-Tabellen, die Grenzfrequenz sinkt mit 1 / maxRate
+    constexpr double tableMaxRates[] = { 1.0, 1.1, 1.25, 1.5, 2.0, 3.0, 4.0 };
+
+    inline float sampleAt(const float* src, long index, long start, long end, bool looping) noexcept
+    {
+        if (index >= start && index < end)
+            return src[index];
+
+        if (!looping)
+            return 0.0f;
+
+        const long length = end - start;
+        long wrapped = (index - start) % length;
+        if (wrapped < 0)
+            wrapped += length;
+
+        return src[start + wrapped];
+    }
+
+    inline double windowedSinc(double t, double cutoff) noexcept
+    {
+        // Blackman-Harris über [-halfTaps, halfTaps]
+        const double x = (t + halfTaps) / (2.0 * halfTaps);
+        if (x <= 0.0 || x >= 1.0)
+            return 0.0;
+
+        const double twoPi = juce::MathConstants<double>::twoPi;
+        const double window = 0.35875
+                            - 0.48829 * std::cos(twoPi * x)
+                            + 0.14128 * std::cos(2.0 * twoPi * x)
+                            - 0.01168 * std::cos(3.0 * twoPi * x);
+
+        const double arg = juce::MathConstants<double>::pi * cutoff * t;
+        const double sinc = std::abs(arg) < 1.0e-9 ? 1.0 : std::sin(arg) / arg;
+
+        return cutoff * sinc * window;
+    }
+}
+
+Resampler::Resampler()
+{
+    // Tabellen hier anlegen, damit der Audio Thread sie nie bauen muss
+    getSincTables();
+}
+
+juce::String Resampler::getQualityName(Quality q)
+{
+    switch (q)
+    {
+    case Quality::Linear:       return "Linear";
+    case Quality::CubicHermite: return "Cubic Hermite";
+    case Quality::WindowedSinc: return "Windowed Sinc";
+    }
+
+    return {};
+}
+
+const std::vector<Resampler::SincTable>& Resampler::getSincTables()
+{
+    static const std::vector<SincTable> tables = []
+    {
+        std::vector<SincTable> result(std::size(tableMaxRates));
+
+        for (size_t i = 0; i < result.size(); ++i)
+            buildSincTable(result[i], tableMaxRates[i]);
+
+        return result;
+    }();
+
+    return tables;
+}
+
+const Resampler::SincTable& Resampler::getSincTableForRate(double rate) noexcept
+{
+    const auto& tables = getSincTables();
+
+    for (const auto& table : tables)
+        if (rate <= table.maxRate)
+            return table;
+
+    return tables.back();
+}
+
+void Resampler::buildSincTable(SincTable& table, double maxRate)
+{
+    table.maxRate = maxRate;
+    table.storage.assign((size_t)(numPhases + 1) * numTaps + 4, 0.0f);
+
+    // Zeilen auf 16 Byte ausrichten
+    const auto address = reinterpret_cast<std::uintptr_t>(table.storage.data());
+    auto* rows = reinterpret_cast<float*>((address + 15) & ~static_cast<std::uintptr_t>(15));
+    table.rows = rows;
+
+    const double cutoff = baseCutoff / juce::jmax(1.0, maxRate);
+
+    for (int phase = 0; phase <= numPhases; ++phase)
+    {
+        const double fraction = (double)phase / numPhases;
+        float* row = rows + (size_t)phase * numTaps;
+        double sum = 0.0;
+
+        // Tap k liegt bei Quellindex position - (halfTaps - 1) + k
+        for (int k = 0; k < numTaps; ++k)
+        {
+            const double t = (double)(k - (halfTaps - 1)) - fraction;
+            const double h = windowedSinc(t, cutoff);
+            row[k] = (float)h;
+            sum += h;
+        }
+
+        // DC-Verstärkung jeder Phase auf 1 normieren
+        if (sum != 0.0)
+            for (int k = 0; k < numTaps; ++k)
+                row[k] = (float)(row[k] / sum);
+    }
+}
+
+long Resampler::process(const float* srcL, const float* srcR, float* outL, float* outR,
+                        int numSamples, long position, double& fraction, double rate,
+                        long start, long end, bool looping, bool& finished) const noexcept
+{
+    switch (quality.load())
+    {
+    case Quality::Linear:
+        return run<Quality::Linear>(srcL, srcR, outL, outR, numSamples, position, fraction, rate, start, end, looping, finished);
+    case Quality::CubicHermite:
+        return run<Quality::CubicHermite>(srcL, srcR, outL, outR, numSamples, position, fraction, rate, start, end, looping, finished);
+    case Quality::WindowedSinc:
+    default:
+        return run<Quality::WindowedSinc>(srcL, srcR, outL, outR, numSamples, position, fraction, rate, start, end, looping, finished);
+    }
+}
+
+void Resampler::readFrame(const float* srcL, const float* srcR, long position, float fraction, double rate,
+                          long start, long end, bool looping, float& outL, float& outR) const noexcept
+{
+    const auto& table = getSincTableForRate(rate);
+
+    switch (quality.load())
+    {
+    case Quality::Linear:
+        readFrameWith<Quality::Linear>(srcL, srcR, position, fraction, table, start, end, looping, outL, outR);
+        break;
+    case Quality::CubicHermite:
+        readFrameWith<Quality::CubicHermite>(srcL, srcR, position, fraction, table, start, end, looping, outL, outR);
+        break;
+    case Quality::WindowedSinc:
+    default:
+        readFrameWith<Quality::WindowedSinc>(srcL, srcR, position, fraction, table, start, end, looping, outL, outR);
+        break;
+    }
+}
+
+template <Resampler::Quality mode>
+long Resampler::run(const float* srcL, const float* srcR, float* outL, float* outR,
+                    int numSamples, long position, double& fraction, double rate,
+                    long start, long end, bool looping, bool& finished) const noexcept
+{
+    const auto& table = getSincTableForRate(rate);
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        readFrameWith<mode>(srcL, srcR, position, (float)fraction, table, start, end, looping, outL[i], outR[i]);
+
+        fraction += rate;
+        const long advance = (long)fraction;
+        fraction -= (double)advance;
+        position += advance;
+
+        if (position >= end)
+        {
+            if (!looping)
+            {
+                finished = true;
+                return start;
+            }
+
+            position = start + (position - end) % (end - start);
+        }
+    }
+
+    return position;
+}
+
+template <Resampler::Quality mode>
+void Resampler::readFrameWith(const float* srcL, const float* srcR, long position, float fraction,
+                              const SincTable& table, long start, long end, bool looping,
+                              float& outL, float& outR) noexcept
+{
+    if constexpr (mode == Quality::Linear)
+    {
+        float l0, l1, r0, r1;
+
+        if (position >= start && position + 1 < end)
+        {
+            l0 = srcL[position]; l1 = srcL[position + 1];
+            r0 = srcR[position]; r1 = srcR[position + 1];
+        }
+        else
+        {
+            l0 = sampleAt(srcL, position, start, end, looping);
+            l1 = sampleAt(srcL, position + 1, start, end, looping);
+            r0 = sampleAt(srcR, position, start, end, looping);
+            r1 = sampleAt(srcR, position + 1, start, end, looping);
+        }
+
+        outL = l0 + fraction * (l1 - l0);
+        outR = r0 + fraction * (r1 - r0);
+    }
+    else if constexpr (mode == Quality::CubicHermite)
+    {
+        float l[4], r[4];
+
+        if (position - 1 >= start && position + 2 < end)
+        {
+            for (int k = 0; k < 4; ++k)
+            {
+                l[k] = srcL[position - 1 + k];
+                r[k] = srcR[position - 1 + k];
+            }
+        }
+        else
+        {
+            for (int k = 0; k < 4; ++k)
+            {
+                l[k] = sampleAt(srcL, position - 1 + k, start, end, looping);
+                r[k] = sampleAt(srcR, position - 1 + k, start, end, looping);
+            }
+        }
+
+        auto hermite = [fraction](const float* x) noexcept
+        {
+            const float c1 = 0.5f * (x[2] - x[0]);
+            const float c2 = x[0] - 2.5f * x[1] + 2.0f * x[2] - 0.5f * x[3];
+            const float c3 = 0.5f * (x[3] - x[0]) + 1.5f * (x[1] - x[2]);
+            return ((c3 * fraction + c2) * fraction + c1) * fraction + x[1];
+        };
+
+        outL = hermite(l);
+        outR = hermite(r);
+    }
+    else
+    {
+        // Zwischen zwei benachbarten Phasen-Zeilen interpolieren
+        const float phasePosition = fraction * (float)numPhases;
+        const int phase = juce::jlimit(0, numPhases - 1, (int)phasePosition);
+        const float phaseFraction = phasePosition - (float)phase;
+
+        const float* row0 = table.getRow(phase);
+        const float* row1 = table.getRow(phase + 1);
+
+        alignas(16) float taps[numTaps];
+        for (int k = 0; k < numTaps; ++k)
+            taps[k] = row0[k] + phaseFraction * (row1[k] - row0[k]);
+
+        const long first = position - (halfTaps - 1);
+        const float* windowL;
+        const float* windowR;
+        alignas(16) float gatheredL[numTaps];
+        alignas(16) float gatheredR[numTaps];
+
+        if (first >= start && first + numTaps <= end)
+        {
+            windowL = srcL + first;
+            windowR = srcR + first;
+        }
+        else
+        {
+            for (int k = 0; k < numTaps; ++k)
+            {
+                gatheredL[k] = sampleAt(srcL, first + k, start, end, looping);
+                gatheredR[k] = sampleAt(srcR, first + k, start, end, looping);
+            }
+            windowL = gatheredL;
+            windowR = gatheredR;
+        }
+
+        // Vier Teilsummen, damit der Compiler ohne -ffast-math vektorisieren darf
+        float accL[4] = {}, accR[4] = {};
+        for (int k = 0; k < numTaps; k += 4)
+        {
+            for (int j = 0; j < 4; ++j)
+            {
+                accL[j] += taps[k + j] * windowL[k + j];
+                accR[j] += taps[k + j] * windowR[k + j];
+            }
+        }
+
+        outL = (accL[0] + accL[1]) + (accL[2] + accL[3]);
+        outR = (accR[0] + accR[1]) + (accR[2] + accR[3]);
+    }
+}
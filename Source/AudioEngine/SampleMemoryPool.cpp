@@ -0,0 +1,171 @@
+/*
+  ==============================================================================
+
+    SampleMemoryPool.cpp
+    Created: 16 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "SampleMemoryPool.h"
+
+SampleMemoryPool::Block::Block(std::unique_ptr<float[]> memory, size_t numFloats, int classIndex) noexcept
+    : data(std::move(memory))
+    , capacity(numFloats)
+    , sizeClass(classIndex)
+{
+}
+
+SampleMemoryPool::Block::Block(Block&& other) noexcept
+    : data(std::move(other.data))
+    , capacity(std::exchange(other.capacity, 0))
+    , sizeClass(std::exchange(other.sizeClass, -1))
+{
+}
+
+SampleMemoryPool::Block& SampleMemoryPool::Block::operator=(Block&& other) noexcept
+{
+    if (this != &other)
+    {
+        Block previous(std::move(*this));
+        data = std::move(other.data);
+        capacity = std::exchange(other.capacity, 0);
+        sizeClass = std::exchange(other.sizeClass, -1);
+    }
+
+    return *this;
+}
+
+SampleMemoryPool::Block::~Block()
+{
+    if (data != nullptr)
+        SampleMemoryPool::getInstance().release(std::move(data), capacity, sizeClass);
+}
+
+SampleMemoryPool& SampleMemoryPool::getInstance()
+{
+    static SampleMemoryPool pool;
+    return pool;
+}
+
+int SampleMemoryPool::getSizeClass(size_t numFloats) noexcept
+{
+    if (numFloats <= minimumClassSize)
+        return 0;
+
+    // Oktave über der Mindestgröße, dann Viertel innerhalb der Oktave aufrunden
+    int octave = 0;
+    while (octave < numClasses / stepsPerOctave && (minimumClassSize << (octave + 1)) < numFloats)
+        ++octave;
+
+    const size_t base = minimumClassSize << octave;
+    const int step = (int)(((numFloats - base) * stepsPerOctave + base - 1) / base);
+
+    const int sizeClass = octave * stepsPerOctave + step;
+    return sizeClass < numClasses ? sizeClass : -1;
+}
+
+size_t SampleMemoryPool::getClassSize(int sizeClass) noexcept
+{
+    const size_t base = minimumClassSize << (sizeClass / stepsPerOctave);
+    return base + base * (size_t)(sizeClass % stepsPerOctave) / stepsPerOctave;
+}
+
+SampleMemoryPool::Block SampleMemoryPool::allocate(size_t numFloats)
+{
+    const int sizeClass = getSizeClass(numFloats);
+
+    // Größer als jede Klasse: exakt anlegen und beim Freigeben nicht aufheben
+    if (sizeClass < 0)
+        return Block(std::unique_ptr<float[]>(new float[numFloats]), numFloats, -1);
+
+    const size_t classSize = getClassSize(sizeClass);
+
+    {
+        const std::lock_guard<std::mutex> guard(lock);
+        auto& blocks = freeBlocks[(size_t)sizeClass];
+
+        if (!blocks.empty())
+        {
+            auto memory = std::move(blocks.back());
+            blocks.pop_back();
+            retainedBytes -= classSize * sizeof(float);
+            return Block(std::move(memory), classSize, sizeClass);
+        }
+    }
+
+    // Nicht initialisiert, ungenutzte Seiten belegen so keinen physischen Speicher
+    return Block(std::unique_ptr<float[]>(new float[classSize]), classSize, sizeClass);
+}
+
+void SampleMemoryPool::release(std::unique_ptr<float[]> memory, size_t numFloats, int sizeClass)
+{
+    if (sizeClass < 0)
+        return;
+
+    const size_t bytes = numFloats * sizeof(float);
+    const std::lock_guard<std::mutex> guard(lock);
+
+    if (retainedBytes + bytes > retainedLimit)
+        return;
+
+    freeBlocks[(size_t)sizeClass].push_back(std::move(memory));
+    retainedBytes += bytes;
+}
+
+void SampleMemoryPool::setRetainedLimit(size_t bytes)
+{
+    {
+        const std::lock_guard<std::mutex> guard(lock);
+        retainedLimit = bytes;
+
+        if (retainedBytes <= retainedLimit)
+            return;
+    }
+
+    trim();
+}
+
+size_t SampleMemoryPool::getRetainedBytes() const
+{
+    const std::lock_guard<std::mutex> guard(lock);
+    return retainedBytes;
+}
+
+void SampleMemoryPool::trim()
+{
+    std::array<std::vector<std::unique_ptr<float[]>>, numClasses> released;
+
+    {
+        const std::lock_guard<std::mutex> guard(lock);
+        std::swap(released, freeBlocks);
+        retainedBytes = 0;
+    }
+
+    // Freigabe außerhalb des Locks, das kann bei großen Blöcken dauern
+}
+
+//==============================================================================
+PooledSampleBuffer::PooledSampleBuffer(int numChannels, int numSamples)
+    : PooledSampleBuffer(SampleMemoryPool::getInstance().allocate((size_t)juce::jmax(1, numChannels) * (size_t)juce::jmax(1, numSamples)),
+                         numChannels, numSamples)
+{
+}
+
+PooledSampleBuffer::PooledSampleBuffer(SampleMemoryPool::Block memory, int numChannels, int numSamples)
+    : juce::AudioBuffer<float>(getChannelPointers(memory, numChannels, numSamples).data(), numChannels, numSamples)
+    , block(std::move(memory))
+{
+}
+
+std::array<float*, PooledSampleBuffer::maxChannels> PooledSampleBuffer::getChannelPointers(const SampleMemoryPool::Block& memory,
+                                                                                             int numChannels, int numSamples) noexcept
+{
+    jassert(numChannels > 0 && numChannels <= maxChannels);
+
+    std::array<float*, maxChannels> channels {};
+    for (int channel = 0; channel < juce::jmin(numChannels, maxChannels); ++channel)
+        channels[(size_t)channel] = memory.getData() + (size_t)channel * (size_t)numSamples;
+
+    return channels;
+}
@@ -0,0 +1,109 @@
+/*
+  ==============================================================================
+
+    SampleMemoryPool.h
+    Created: 16 Oct 2026
+
+    Shared pool for large sample buffers (deck tracks, streaming caches).
+    Requests are rounded up to size classes of a quarter octave (at most 25%
+    slack) and released blocks are kept per class for the next load, up to a
+    retained limit; everything above the limit goes back to the system.
+    Memory is handed out uninitialised, so untouched pages do not count
+    towards the resident size.
+
+    Allocation and release take a lock, so use the pool from the message
+    thread or a loader thread, never from the audio callback.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <memory>
+#include <utility>
+#include <mutex>
+#include <vector>
+
+class SampleMemoryPool
+{
+public:
+    /** Owns one pooled allocation and hands it back to the pool when destroyed. */
+    class Block
+    {
+    public:
+        Block() = default;
+        Block(Block&& other) noexcept;
+        Block& operator=(Block&& other) noexcept;
+        ~Block();
+
+        float* getData() const noexcept { return data.get(); }
+        size_t getCapacity() const noexcept { return capacity; }
+        bool isValid() const noexcept { return data != nullptr; }
+
+    private:
+        friend class SampleMemoryPool;
+        Block(std::unique_ptr<float[]> memory, size_t numFloats, int classIndex) noexcept;
+
+        std::unique_ptr<float[]> data;
+        size_t capacity = 0;
+        int sizeClass = -1;
+
+        JUCE_DECLARE_NON_COPYABLE(Block)
+    };
+
+    static SampleMemoryPool& getInstance();
+
+    /** Returns a block of at least numFloats floats, reusing a released one of the same class if possible. */
+    Block allocate(size_t numFloats);
+
+    /** Bytes kept for reuse after release; 0 disables retention. */
+    void setRetainedLimit(size_t bytes);
+    size_t getRetainedBytes() const;
+
+    /** Gives every retained block back to the system. */
+    void trim();
+
+private:
+    SampleMemoryPool() = default;
+
+    static constexpr size_t minimumClassSize = 1 << 16;    // 256 KB
+    static constexpr int stepsPerOctave = 4;
+    static constexpr int numClasses = 16 * stepsPerOctave;  // bis 2^31 Floats, darüber ohne Klasse
+
+    static int getSizeClass(size_t numFloats) noexcept;
+    static size_t getClassSize(int sizeClass) noexcept;
+
+    void release(std::unique_ptr<float[]> memory, size_t numFloats, int sizeClass);
+
+    mutable std::mutex lock;
+    std::array<std::vector<std::unique_ptr<float[]>>, numClasses> freeBlocks;
+    size_t retainedBytes = 0;
+    size_t retainedLimit = (size_t)64 * 1024 * 1024;
+
+    JUCE_DECLARE_NON_COPYABLE(SampleMemoryPool)
+};
+
+//==============================================================================
+/**
+    AudioBuffer whose channels live in one block from the SampleMemoryPool.
+    Used like any AudioSampleBuffer, but cannot be resized.
+*/
+class PooledSampleBuffer : public juce::AudioBuffer<float>
+{
+public:
+    static constexpr int maxChannels = 2;
+
+    PooledSampleBuffer(int numChannels, int numSamples);
+
+private:
+    PooledSampleBuffer(SampleMemoryPool::Block memory, int numChannels, int numSamples);
+
+    static std::array<float*, maxChannels> getChannelPointers(const SampleMemoryPool::Block& memory,
+                                                              int numChannels, int numSamples) noexcept;
+
+    SampleMemoryPool::Block block;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PooledSampleBuffer)
+};
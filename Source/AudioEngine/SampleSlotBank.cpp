@@ -0,0 +1,301 @@
+/*
+  ==============================================================================
+
+    SampleSlotBank.cpp
+    Created: 16 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "SampleSlotBank.h"
+#include <algorithm>
+
+SampleSlotBank::SampleSlotBank()
+{
+    sampleSlots.resize(numSlots);
+
+    for (auto& live : liveData)
+        live.store(nullptr);
+}
+
+void SampleSlotBank::generateSampleOutput(float* leftOut, float* rightOut, int numSamples, float gain)
+{
+    // Ungerade für die Dauer des Blocks, siehe releaseRetiredData()
+    renderEpoch.fetch_add(1);
+
+    // Initialize outputs with zeros
+    juce::FloatVectorOperations::clear(leftOut, numSamples);
+    juce::FloatVectorOperations::clear(rightOut, numSamples);
+
+    for (size_t i = 0; i < sampleSlots.size(); ++i)
+    {
+        auto& slot = sampleSlots[i];
+
+        // Einmal je Block lesen, die Daten bleiben bis zum Blockende gültig
+        const auto* data = liveData[i].load();
+
+        if (!slot.isPlaying || data == nullptr || data->getNumFrames() == 0)
+            continue;
+
+        processSampleSlot(slot, *data, leftOut, rightOut, numSamples, gain);
+    }
+
+    renderEpoch.fetch_add(1);
+}
+
+bool SampleSlotBank::isAnySamplePlaying() const
+{
+    for (const auto& slot : sampleSlots)
+    {
+        if (slot.isPlaying) return true;
+    }
+    return false;
+}
+
+void SampleSlotBank::stopAllSamples()
+{
+    for (auto& slot : sampleSlots)
+    {
+        slot.stop();
+    }
+}
+
+void SampleSlotBank::setSampleGain(int slotIndex, float gain)
+{
+    if (slotIndex >= 0 && slotIndex < (int)sampleSlots.size())
+    {
+        sampleSlots[(size_t)slotIndex].gain = juce::jlimit(0.0f, 2.0f, gain);
+    }
+}
+
+void SampleSlotBank::triggerSample(int slotIndex)
+{
+    if (slotIndex >= 0 && slotIndex < (int)sampleSlots.size())
+    {
+        auto& slot = sampleSlots[(size_t)slotIndex];
+        if (!slot.isEmpty())
+        {
+            slot.isPlaying = true;
+            slot.currentPosition = 0;
+        }
+    }
+}
+
+void SampleSlotBank::setSampleStorage(SampleStorage storage)
+{
+    if (storage == sampleStorage)
+        return;
+
+    sampleStorage = storage;
+
+    // Gleiche Länge in jedem Format: laufende Slots spielen an ihrer Position mit den neuen Daten weiter
+    for (int i = 0; i < numSlots; ++i)
+    {
+        const auto current = sampleSlots[(size_t)i].data;
+
+        if (current == nullptr || current->getNumFrames() == 0)
+            continue;
+
+        if (current->compact != nullptr)
+        {
+            juce::AudioBuffer<float> expanded;
+            current->compact->toFloat(expanded);
+            setSlotData(i, makeSlotData(expanded, current->sampleRate));
+        }
+        else
+        {
+            setSlotData(i, makeSlotData(current->buffer, current->sampleRate));
+        }
+    }
+}
+
+SampleSlotBank::SampleDataPtr SampleSlotBank::makeSlotData(const juce::AudioBuffer<float>& source, double sampleRate) const
+{
+    auto data = std::make_shared<SampleData>();
+    data->sampleRate = sampleRate;
+
+    if (sampleStorage == SampleStorage::float32)
+        data->buffer.makeCopyOf(source);
+    else
+        data->compact = std::make_shared<const CompactSampleBuffer>(source, sampleStorage, sampleRate);
+
+    return data;
+}
+
+void SampleSlotBank::setSlotData(int slotIndex, SampleDataPtr data)
+{
+    if (slotIndex < 0 || slotIndex >= numSlots)
+        return;
+
+    auto previous = std::move(sampleSlots[(size_t)slotIndex].data);
+    sampleSlots[(size_t)slotIndex].data = std::move(data);
+    publish(slotIndex);
+
+    // Erst nach dem Veröffentlichen die Epoche lesen: ist sie gerade, sieht der Audio Thread schon die neuen Daten
+    if (previous != nullptr)
+        retiredData.push_back({ std::move(previous), renderEpoch.load() });
+
+    releaseRetiredData();
+}
+
+void SampleSlotBank::swapSlots(int slot1, int slot2)
+{
+    if (slot1 < 0 || slot1 >= numSlots || slot2 < 0 || slot2 >= numSlots || slot1 == slot2)
+        return;
+
+    // Nur den Inhalt tauschen, Position und Wiedergabe gehören dem Audio Thread.
+    // Beide Daten bleiben im Besitz der Slots, es wird nichts frei
+    auto& first = sampleSlots[(size_t)slot1];
+    auto& second = sampleSlots[(size_t)slot2];
+
+    std::swap(first.data, second.data);
+    std::swap(first.fileName, second.fileName);
+    std::swap(first.playMode, second.playMode);
+    std::swap(first.gain, second.gain);
+    publish(slot1);
+    publish(slot2);
+}
+
+void SampleSlotBank::publish(int slotIndex)
+{
+    liveData[(size_t)slotIndex].store(sampleSlots[(size_t)slotIndex].data.get());
+}
+
+void SampleSlotBank::releaseRetiredData()
+{
+    // Frei sind Daten, wenn beim Tausch kein Block lief oder dieser Block inzwischen vorbei ist
+    const auto epoch = renderEpoch.load();
+
+    retiredData.erase(std::remove_if(retiredData.begin(), retiredData.end(),
+                                     [epoch](const RetiredData& retired)
+                                     {
+                                         return (retired.epoch & 1) == 0 || retired.epoch != epoch;
+                                     }),
+                      retiredData.end());
+}
+
+void SampleSlotBank::processSampleSlot(SampleSlot& slot, const SampleData& data, float* leftOut, float* rightOut, int numSamples, float masterGain)
+{
+    if (data.compact != nullptr)
+    {
+        processCompactSlot(slot, data, leftOut, rightOut, numSamples, masterGain);
+        return;
+    }
+
+    const int sampleLength = data.buffer.getNumSamples();
+    const int numChannels = data.buffer.getNumChannels();
+
+    for (int sample = 0; sample < numSamples; ++sample)
+    {
+        if (!slot.isPlaying)
+            break;
+
+        // Handle different play modes
+        int readPosition = slot.currentPosition;
+
+        if (slot.playMode == PlayMode::LoopBackward)
+        {
+            readPosition = sampleLength - 1 - slot.currentPosition;
+        }
+
+        // Bounds check
+        if (readPosition < 0 || readPosition >= sampleLength)
+        {
+            if (slot.playMode == PlayMode::OneShot)
+            {
+                slot.stop();
+                break;
+            }
+            else // Loop modes
+            {
+                slot.currentPosition = 0;
+                readPosition = slot.playMode == PlayMode::LoopBackward ?
+                    sampleLength - 1 : 0;
+            }
+        }
+
+        // Get sample values
+        float leftSample = 0.0f;
+        float rightSample = 0.0f;
+
+        if (numChannels >= 1)
+        {
+            leftSample = data.buffer.getSample(0, readPosition);
+        }
+
+        if (numChannels >= 2)
+        {
+            rightSample = data.buffer.getSample(1, readPosition);
+        }
+        else
+        {
+            rightSample = leftSample; // Mono zu Stereo
+        }
+
+        // Apply gains and mix to output
+        float finalGain = slot.gain * masterGain;
+        leftOut[sample] += leftSample * finalGain;
+        rightOut[sample] += rightSample * finalGain;
+
+        // Advance position
+        if (slot.playMode == PlayMode::LoopBackward)
+        {
+            slot.currentPosition++;
+            if (slot.currentPosition >= sampleLength)
+                slot.currentPosition = 0;
+        }
+        else
+        {
+            slot.currentPosition++;
+            if (slot.currentPosition >= sampleLength && slot.playMode != PlayMode::OneShot)
+                slot.currentPosition = 0;
+        }
+    }
+}
+
+void SampleSlotBank::processCompactSlot(SampleSlot& slot, const SampleData& data, float* leftOut, float* rightOut, int numSamples, float masterGain)
+{
+    // In kurzen Stücken nach Float wandeln, Play Modes wie in processSampleSlot
+    const auto& compact = *data.compact;
+    const int sampleLength = compact.getNumSamples();
+    const float finalGain = slot.gain * masterGain;
+    int sample = 0;
+
+    while (sample < numSamples && slot.isPlaying)
+    {
+        if (slot.currentPosition >= sampleLength)
+        {
+            if (slot.playMode == PlayMode::OneShot)
+            {
+                slot.stop();
+                break;
+            }
+
+            slot.currentPosition = 0;
+        }
+
+        const int run = juce::jmin(numSamples - sample, sampleLength - slot.currentPosition, compactChunk);
+
+        if (slot.playMode == PlayMode::LoopBackward)
+        {
+            // Gespiegeltes Fenster holen und von hinten lesen
+            const int first = sampleLength - slot.currentPosition - run;
+            compact.read(first, run, compactScratchL.data(), compactScratchR.data(), 0, sampleLength, false);
+
+            for (int i = 0; i < run; ++i)
+            {
+                leftOut[sample + i] += compactScratchL[(size_t)(run - 1 - i)] * finalGain;
+                rightOut[sample + i] += compactScratchR[(size_t)(run - 1 - i)] * finalGain;
+            }
+        }
+        else
+        {
+            compact.read(slot.currentPosition, run, compactScratchL.data(), compactScratchR.data(), 0, sampleLength, false);
+            juce::FloatVectorOperations::addWithMultiply(leftOut + sample, compactScratchL.data(), finalGain, run);
+            juce::FloatVectorOperations::addWithMultiply(rightOut + sample, compactScratchR.data(), finalGain, run);
+        }
+
+        sample += run;
+        slot.currentPosition += run;
+    }
+}
@@ -0,0 +1,146 @@
+/*
+  ==============================================================================
+
+    SampleSlotBank.h
+    Created: 16 Oct 2026
+
+    The eight sample slots of the sample player and their voice rendering
+    (one shot, loop forward, loop backward; float or 16-bit storage),
+    without any UI. SamplePlayer is the editor for a bank; the mixer core
+    only needs the bank, so it can run headless.
+
+    Slot data is changed on the message thread, rendering happens on the
+    audio thread through generateSampleOutput(), which does not allocate.
+    Loaded sample data is never changed in place: a new SampleData is built
+    on the message thread and published per slot with an atomic pointer swap,
+    the replaced one is freed once the audio thread has left the block that
+    may still read it (same scheme as Sampler::Source).
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "CompactSampleBuffer.h"
+
+class SampleSlotBank
+{
+public:
+    static constexpr int numSlots = 8;
+
+    enum class PlayMode
+    {
+        OneShot,
+        LoopForward,
+        LoopBackward
+    };
+
+    // Geladenes Sample, nach dem Veröffentlichen unveränderlich
+    struct SampleData
+    {
+        juce::AudioBuffer<float> buffer;
+        std::shared_ptr<const CompactSampleBuffer> compact;   // statt buffer bei 16-Bit-Speicherung
+        double sampleRate = 0.0;
+
+        int getNumFrames() const
+        {
+            return compact != nullptr ? compact->getNumSamples() : buffer.getNumSamples();
+        }
+    };
+
+    using SampleDataPtr = std::shared_ptr<const SampleData>;
+
+    struct SampleSlot
+    {
+        SampleDataPtr data;     // Besitzer, Message Thread; der Audio Thread liest über die Bank
+        juce::String fileName;
+        int currentPosition = 0;
+        bool isPlaying = false;
+        PlayMode playMode = PlayMode::OneShot;
+        float gain = 1.0f;
+
+        void reset()
+        {
+            currentPosition = 0;
+            isPlaying = false;
+        }
+
+        void stop()
+        {
+            isPlaying = false;
+            currentPosition = 0;
+        }
+
+        int getNumFrames() const
+        {
+            return data != nullptr ? data->getNumFrames() : 0;
+        }
+
+        bool isEmpty() const
+        {
+            return getNumFrames() == 0;
+        }
+    };
+
+    SampleSlotBank();
+
+    std::vector<SampleSlot>& getSlots() { return sampleSlots; }
+    const std::vector<SampleSlot>& getSlots() const { return sampleSlots; }
+
+    //==============================================================================
+    // Hauptmethode für Sample-Processing - wird im Audio-Loop aufgerufen
+    // leftOut / rightOut muessen numSamples Platz haben, es wird nichts allokiert
+    void generateSampleOutput(float* leftOut, float* rightOut, int numSamples, float gain);
+
+    bool isAnySamplePlaying() const;
+
+    //==============================================================================
+    /** Copies data into a new SampleData in the current storage format. Allocates, message thread only. */
+    SampleDataPtr makeSlotData(const juce::AudioBuffer<float>& data, double sampleRate) const;
+
+    /** Publishes data (or nullptr to empty the slot) to the audio thread. Message thread only. */
+    void setSlotData(int slotIndex, SampleDataPtr data);
+
+    /** Exchanges the content of two slots; stop them first. Message thread only. */
+    void swapSlots(int slot1, int slot2);
+
+    /** Frees replaced data the audio thread can no longer read. Message thread. */
+    void releaseRetiredData();
+
+    void stopAllSamples();
+    void setSampleGain(int slotIndex, float gain);
+    void triggerSample(int slotIndex);
+
+    // 16-Bit-Speicherung halbiert den Speicher je Slot, bereits geladene Slots werden umgewandelt
+    void setSampleStorage(SampleStorage storage);
+    SampleStorage getSampleStorage() const { return sampleStorage; }
+
+private:
+    struct RetiredData
+    {
+        SampleDataPtr data;
+        juce::uint64 epoch = 0;
+    };
+
+    void publish(int slotIndex);
+    void processSampleSlot(SampleSlot& slot, const SampleData& data, float* leftOut, float* rightOut, int numSamples, float masterGain);
+    void processCompactSlot(SampleSlot& slot, const SampleData& data, float* leftOut, float* rightOut, int numSamples, float masterGain);
+
+    std::vector<SampleSlot> sampleSlots;
+    std::array<std::atomic<const SampleData*>, numSlots> liveData{};  // was generateSampleOutput liest
+    std::atomic<juce::uint64> renderEpoch{ 0 };                       // ungerade während generateSampleOutput
+    std::vector<RetiredData> retiredData;                              // Message Thread
+    SampleStorage sampleStorage = SampleStorage::float32;
+
+    // Wandlungspuffer für 16-Bit-Slots, im Audio Callback wird nichts allokiert
+    static constexpr int compactChunk = 256;
+    std::array<float, compactChunk> compactScratchL;
+    std::array<float, compactChunk> compactScratchR;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SampleSlotBank)
+};
@@ -8,15 +8,27 @@
 */
 
 #include "Sampler.h"
-#include "../AudioManager.h"
-#include "SmartSample.h"
+#include "DiskTrackCache.h"
+#include "ParallelResampler.h"
+
+namespace
+{
+    // Hält renderEpoch für die Dauer eines Blocks ungerade, siehe Sampler::Source
+    struct RenderEpochScope
+    {
+        explicit RenderEpochScope(std::atomic<juce::uint64>& e) noexcept : epoch(e) { epoch.fetch_add(1); }
+        ~RenderEpochScope() { epoch.fetch_add(1); }
+
+        std::atomic<juce::uint64>& epoch;
+    };
+}
 
 Sampler::Sampler(float sampleRate, int bufferSize)
-    : sampleRate(sampleRate)
+    : engineSampleRate(sampleRate)
     , bufferSize(bufferSize)
     , formatManager(std::make_unique<juce::AudioFormatManager>())
-    , sampleBuffer(std::make_unique<juce::AudioSampleBuffer>(2, 16384 * 1024))
     , samplerEnvelope(std::make_unique<SynthLab::ADSR>())
+    , streamScratch(2, (int)(streamBlockSize * maxStreamRate) + 4 * Resampler::numTaps)
 {
     // Initialize format manager with common formats
     formatManager->registerBasicFormats();
@@ -31,17 +43,44 @@ Sampler::Sampler(float sampleRate, int bufferSize)
     samplerEnvelope->setDecayRate(0.1f * sampleRate);
 }
 
+void Sampler::prepareToPlay(double newSampleRate, int newBlockSize) {
+    const double previousRate = engineSampleRate.exchange(newSampleRate);
+    bufferSize = newBlockSize;
+
+    samplerEnvelope->setAttackRate(0.1f * (float)newSampleRate);
+    samplerEnvelope->setReleaseRate(0.3f * (float)newSampleRate);
+    samplerEnvelope->setDecayRate(0.1f * (float)newSampleRate);
+
+    if (previousRate != newSampleRate)
+        scheduleConversion();
+}
+
+void Sampler::setSampleStorage(SampleStorage storage) {
+    if (sampleStorage.exchange(storage) != storage)
+        scheduleConversion();
+}
+
+void Sampler::waitForConversions() {
+    // Ein Job ist erst nach offerConvertedSource aus dem Pool verschwunden
+    while (conversionPool.getNumJobs() > 0)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+}
+
 void Sampler::initializeInterpolators() {
     interpolatorLeft = std::make_unique<juce::CatmullRomInterpolator>();
     interpolatorRight = std::make_unique<juce::CatmullRomInterpolator>();
 }
 
 void Sampler::validateSampleBounds() {
-    if (sampleLength <= 0) return;
+    const long length = sampleLength.load();
+    if (length <= 0) return;
+
+    const long start = juce::jlimit(0L, length - 1, startPosition.load());
+    const long end = juce::jlimit(start + 1, length, endPosition.load());
 
-    startPosition = juce::jlimit(0L, sampleLength - 1, startPosition);
-    endPosition = juce::jlimit(startPosition + 1, sampleLength, endPosition);
-    currentSample = juce::jlimit(startPosition, endPosition - 1, currentSample.load());
+    startPosition = start;
+    endPosition = end;
+    currentSample = juce::jlimit(start, end - 1, currentSample.load());
 }
 
 void Sampler::nextSample() {
@@ -54,7 +93,7 @@ void Sampler::nextSample() {
             currentSample = current + 1;
         }
         else {
-            currentSample = startPosition;
+            currentSample = startPosition.load();
         }
     }
     else {
@@ -63,7 +102,7 @@ void Sampler::nextSample() {
         }
         else {
             playing = false;
-            currentSample = startPosition;
+            currentSample = startPosition.load();
         }
     }
 }
@@ -85,8 +124,70 @@ void Sampler::stop() {
     playing = false;
 }
 
+void Sampler::setStartPosition(long start) noexcept {
+    startPosition = start;
+    setDirty(true);
+
+    // Loop-Anfang warm halten, damit der Rücksprung nicht auf die Platte wartet
+    if (auto source = getSource())
+        if (source->stream) source->stream->setPinnedPosition(0, start);
+}
+
+void Sampler::setCurrentPosition(long position) noexcept {
+    currentSample = position;
+
+    if (auto source = getSource())
+        if (source->stream) source->stream->seekHint(position);
+}
+
+void Sampler::setHotCue(int index, long position) noexcept {
+    if (index < 0 || index >= maxHotCues) return;
+
+    if (auto source = getSource())
+        if (source->stream) source->stream->setPinnedPosition(index + 1, position);
+}
+
+double Sampler::getSourceSampleRate() const noexcept {
+    const double rate = sourceSampleRate.load();
+    return rate > 0.0 ? rate : engineSampleRate.load();
+}
+
+bool Sampler::isStreaming() const {
+    auto source = getSource();
+    return source != nullptr && source->stream != nullptr;
+}
+
+int Sampler::getStreamUnderrunCount() const {
+    const std::lock_guard<std::mutex> lock(sourceLock);
+    int count = releasedUnderruns;
+
+    for (const auto& retired : retiredSources)
+        if (retired.source->stream != nullptr)
+            count += retired.source->stream->getUnderrunCount();
+
+    if (currentSource != nullptr && currentSource->stream != nullptr)
+        count += currentSource->stream->getUnderrunCount();
+
+    return count;
+}
+
+DecodedTrackPtr Sampler::getTrack() const {
+    auto source = getSource();
+    return source != nullptr ? source->track : nullptr;
+}
+
+std::shared_ptr<const Sampler::Source> Sampler::getSource() const {
+    const std::lock_guard<std::mutex> lock(sourceLock);
+
+    // Hat der Audio Thread eine Konvertierung übernommen, ist sie die aktuelle Quelle
+    if (pendingOwner != nullptr && liveSource.load() == pendingOwner.get())
+        return pendingOwner;
+
+    return currentSource;
+}
+
 void Sampler::reset() {
-    currentSample = startPosition;
+    currentSample = startPosition.load();
     samplerEnvelope->reset();
 }
 
@@ -104,22 +205,22 @@ float Sampler::getCurrentSample(int channel) const {
     }
 
     // Direct sample access for normal playback
-    if (position >= 0 && position < sampleBuffer->getNumSamples()) {
-        juce::ScopedLock lock(bufferLock);
-        return sampleBuffer->getSample(channel, static_cast<int>(position));
+    auto track = getTrack();
+    if (track && position >= 0 && position < track->buffer.getNumSamples()) {
+        return track->buffer.getSample(channel, static_cast<int>(position));
     }
 
     return 0.0f;
 }
 
 float Sampler::interpolateSample(int channel, double position) const {
-    if (!hasSample() || channel < 0 || channel >= sampleBuffer->getNumChannels()) {
+    auto track = getTrack();
+
+    if (!hasSample() || !track || channel < 0 || channel >= track->buffer.getNumChannels()) {
         return 0.0f;
     }
 
-    juce::ScopedLock lock(bufferLock);
-
-    const int maxSample = sampleBuffer->getNumSamples() - 1;
+    const int maxSample = track->buffer.getNumSamples() - 1;
     if (position < 0.0 || position > maxSample) {
         return 0.0f;
     }
@@ -129,24 +230,32 @@ float Sampler::interpolateSample(int channel, double position) const {
     const float fraction = static_cast<float>(position - intPos);
 
     if (intPos >= maxSample) {
-        return sampleBuffer->getSample(channel, maxSample);
+        return track->buffer.getSample(channel, maxSample);
     }
 
-    const float sample1 = sampleBuffer->getSample(channel, intPos);
-    const float sample2 = sampleBuffer->getSample(channel, intPos + 1);
+    const float sample1 = track->buffer.getSample(channel, intPos);
+    const float sample2 = track->buffer.getSample(channel, intPos + 1);
 
     return sample1 + fraction * (sample2 - sample1);
 }
 
 float Sampler::getSampleAt(int channel, long position) const {
-    juce::ScopedLock lock(bufferLock);
+    auto source = getSource();
+
+    if (source != nullptr && source->compact != nullptr && hasSample()) {
+        float frame[2];
+        source->compact->read(position, 1, &frame[0], &frame[1], 0, source->compact->getNumSamples(), false);
+        return frame[juce::jlimit(0, 1, channel)];
+    }
 
-    if (!sampleBuffer || !hasSample()) {
+    auto track = source != nullptr ? source->track : nullptr;
+
+    if (!track || !hasSample()) {
         return 0.0f;
     }
 
-    const int numChannels = sampleBuffer->getNumChannels();
-    const int numSamples = sampleBuffer->getNumSamples();
+    const int numChannels = track->buffer.getNumChannels();
+    const int numSamples = track->buffer.getNumSamples();
 
     if (numChannels == 0 || numSamples == 0) {
         return 0.0f;
@@ -162,7 +271,7 @@ float Sampler::getSampleAt(int channel, long position) const {
     const int safePosition = static_cast<int>(juce::jmin(position,
         static_cast<long>(numSamples - 1)));
 
-    return sampleBuffer->getSample(safeChannel, safePosition);
+    return track->buffer.getSample(safeChannel, safePosition);
 }
 
 float Sampler::getOutput(int channel) {
@@ -177,40 +286,202 @@ float Sampler::getOutput(int channel) {
     return sample * envelope * vol;
 }
 
-void Sampler::loadSample(const juce::File& file) {
-    if (!file.exists()) return;
+void Sampler::renderBlock(float* outL, float* outR, int numSamples, double rate, float gain) {
+    juce::FloatVectorOperations::clear(outL, numSamples);
+    juce::FloatVectorOperations::clear(outR, numSamples);
 
-    SmartSample sample;
-    sample.loadFromFile(file, sampleRate);
+    if (numSamples <= 0 || !isPlaying()) return;
 
-    if (sample.getLengthInSamples() <= 0) return;
+    // Solange der Scope lebt, gibt installSource die gelesene Quelle nicht frei
+    const RenderEpochScope epochScope(renderEpoch);
+    const Source* source = liveSource.load();
 
-    {
-        juce::ScopedLock lock(bufferLock);
+    if (source == nullptr || !loaded) return;
 
-        // Create new buffer with sample data
-        sampleBuffer = std::make_unique<juce::AudioSampleBuffer>(sample.getBuffer());
+    // Fertige Ratenkonvertierung am Blockanfang übernehmen, zusammen mit den Positionen
+    // (erst das Angebot beanspruchen, damit ein Writer es nicht gleichzeitig zurückzieht)
+    if (const Source* converted = pendingSource.load()) {
+        const Source* claimed = converted;
+        const Source* expected = source;
 
-        // Handle mono to stereo conversion
-        if (sampleBuffer->getNumChannels() == 1) {
-            auto stereoBuffer = std::make_unique<juce::AudioSampleBuffer>(2, sampleBuffer->getNumSamples());
-            stereoBuffer->copyFrom(0, 0, *sampleBuffer, 0, 0, sampleBuffer->getNumSamples());
-            stereoBuffer->copyFrom(1, 0, *sampleBuffer, 0, 0, sampleBuffer->getNumSamples());
-            sampleBuffer = std::move(stereoBuffer);
+        if (converted->replacesSerial == source->serial
+            && pendingSource.compare_exchange_strong(claimed, nullptr)
+            && liveSource.compare_exchange_strong(expected, converted)) {
+            adoptConvertedSource(*source, *converted);
+            source = converted;
         }
+    }
 
-        // Update sample parameters
-        sampleLength = sample.getLengthInSamples();
-        endPosition = sampleLength;
-        startPosition = 0;
-        currentSample = 0;
+    if (!source->stream && !source->compact && source->track->buffer.getNumChannels() == 0) return;
+
+    const long bufferLength = source->length;
+    if (bufferLength <= 0) return;
+
+    // Neue Quelle: der Nachkommaanteil gehört noch zum alten Material
+    if (source->serial != renderedSourceSerial) {
+        renderedSourceSerial = source->serial;
+        playbackFraction = 0.0;
     }
 
-    // Reset interpolators for new sample
-    initializeInterpolators();
+    const long start = juce::jlimit(0L, bufferLength - 1, startPosition.load());
+    const long end = juce::jlimit(start + 1, bufferLength, endPosition.load());
 
-    loaded = true;
-    setDirty(true);
+    const long blockStartPosition = currentSample.load();
+    long position = juce::jlimit(start, end - 1, blockStartPosition);
+    double fraction = position == blockStartPosition ? playbackFraction : 0.0;
+    bool finished = false;
+
+    // Material liegt in seiner eigenen Rate vor, der Resampler gleicht zur Engine-Rate aus
+    const double sourceRate = juce::jlimit(0.0, 4.0, rate) * source->sampleRate / engineSampleRate.load();
+
+    if (source->stream) {
+        position = renderWindowFrames(*source->stream, outL, outR, numSamples, position, fraction,
+                                      juce::jmin(sourceRate, maxStreamRate), start, end, loop.load(), finished);
+    }
+    else if (source->compact) {
+        // Kompakt gespeichert: blockweise nach Float wandeln, dann wie ein Stream resamplen
+        position = renderWindowFrames(*source->compact, outL, outR, numSamples, position, fraction,
+                                      juce::jmin(sourceRate, maxStreamRate), start, end, loop.load(), finished);
+    }
+    else {
+        const auto& buffer = source->track->buffer;
+        const float* srcL = buffer.getReadPointer(0);
+        const float* srcR = buffer.getReadPointer(juce::jmin(1, buffer.getNumChannels() - 1));
+
+        position = renderFrames(srcL, srcR, outL, outR, numSamples, position, fraction,
+                                sourceRate, start, end, loop.load(), finished);
+    }
+
+    // Envelope: in sustain it is a constant, so apply it together with the gains in one pass
+    const float blockGain = gain * volume.load();
+
+    if (samplerEnvelope->getState() == SynthLab::ADSR::env_sustain) {
+        const float level = blockGain * samplerEnvelope->process();
+        juce::FloatVectorOperations::multiply(outL, level, numSamples);
+        juce::FloatVectorOperations::multiply(outR, level, numSamples);
+    }
+    else {
+        for (int i = 0; i < numSamples; ++i) {
+            const float level = blockGain * samplerEnvelope->process();
+            outL[i] *= level;
+            outR[i] *= level;
+        }
+    }
+
+    if (finished) {
+        playing = false;
+        position = start;
+        fraction = 0.0;
+    }
+
+    // A seek from the UI during this block wins over the rendered position
+    auto expected = blockStartPosition;
+    if (currentSample.compare_exchange_strong(expected, position))
+        playbackFraction = fraction;
+    else
+        playbackFraction = 0.0;
+}
+
+long Sampler::renderFrames(const float* srcL, const float* srcR, float* outL, float* outR,
+                           int numSamples, long position, double& fraction, double rate,
+                           long start, long end, bool looping, bool& finished) const noexcept {
+    int written = 0;
+
+    // Fast path: original speed and on the sample grid, copy straight out of the buffer
+    if (rate == 1.0 && fraction == 0.0) {
+        while (written < numSamples) {
+            const int count = (int)juce::jmin((long)(numSamples - written), end - position);
+
+            juce::FloatVectorOperations::copy(outL + written, srcL + position, count);
+            juce::FloatVectorOperations::copy(outR + written, srcR + position, count);
+
+            written += count;
+            position += count;
+
+            if (position >= end) {
+                if (!looping) {
+                    finished = true;
+                    return start;
+                }
+                position = start;
+            }
+        }
+        return position;
+    }
+
+    // Varispeed: per-deck resampler with selectable quality
+    return resampler.process(srcL, srcR, outL, outR, numSamples, position, fraction,
+                             rate, start, end, looping, finished);
+}
+
+template <typename Window>
+long Sampler::renderWindowFrames(Window& window, float* outL, float* outR, int numSamples, long position,
+                                 double& fraction, double rate, long start, long end, bool looping, bool& finished) noexcept {
+    float* scratchL = streamScratch.getWritePointer(0);
+    float* scratchR = streamScratch.getWritePointer(1);
+    int written = 0;
+
+    // In kleinen Stücken, damit das Quellfenster in den festen Scratch-Puffer passt
+    while (written < numSamples) {
+        const int count = juce::jmin(numSamples - written, streamBlockSize);
+
+        if (rate == 1.0 && fraction == 0.0) {
+            window.read(position, count, outL + written, outR + written, start, end, looping);
+            position += count;
+        }
+        else {
+            // Quellfenster mit Rand für die Filter-Taps holen, Loop und Regionsende löst die Quelle auf
+            const long first = position - Resampler::numTaps;
+            const int needed = (int)std::ceil(count * rate + fraction) + 2 * Resampler::numTaps + 1;
+            jassert(needed <= streamScratch.getNumSamples());
+
+            window.read(first, needed, scratchL, scratchR, start, end, looping);
+
+            bool windowEnded = false;
+            position = first + resampler.process(scratchL, scratchR, outL + written, outR + written, count,
+                                                 position - first, fraction, rate, 0, needed, false, windowEnded);
+        }
+
+        written += count;
+
+        if (position >= end) {
+            if (!looping) {
+                finished = true;
+                return start;
+            }
+            position = start + (position - end) % (end - start);
+        }
+    }
+
+    return position;
+}
+
+void Sampler::loadSample(const juce::File& file) {
+    if (!file.exists()) return;
+
+    // Schon dekodiert (Waveform, BPM, letzter Load): direkt aus dem gemeinsamen Cache spielen
+    if (auto cached = DecodedTrackCache::getInstance().find(file)) {
+        installSource(nullptr, std::move(cached));
+        return;
+    }
+
+    if (auto newStream = openStream(file))
+        installSource(std::move(newStream), nullptr);
+}
+
+std::unique_ptr<StreamingDeckSource> Sampler::openStream(const juce::File& file) const {
+    // Im Plattencache gemappt, sonst direkt aus der Datei dekodieren
+    auto reader = DiskTrackCache::getInstance().createReader(file);
+    if (reader == nullptr)
+        reader.reset(formatManager->createReaderFor(file));
+
+    if (reader == nullptr || reader->lengthInSamples <= 0) return nullptr;
+
+    // Nur der Anfang wird sofort dekodiert, der Rest kommt vom Read-Ahead Thread
+    auto newStream = std::make_unique<StreamingDeckSource>(std::move(reader));
+    newStream->start();
+
+    return newStream;
 }
 
 void Sampler::loadSample(std::unique_ptr<juce::InputStream> input) {
@@ -222,34 +493,228 @@ void Sampler::loadSample(std::unique_ptr<juce::InputStream> input) {
 
     if (!reader) return;
 
-    const auto numSamples = static_cast<int>(reader->lengthInSamples);
-    const auto numChannels = juce::jmin(2, static_cast<int>(reader->numChannels));
+    if (auto track = DecodedTrackCache::decode(*reader))
+        installSource(nullptr, std::move(track));
+}
 
-    {
-        juce::ScopedLock lock(bufferLock);
+void Sampler::installSource(std::unique_ptr<StreamingDeckSource> newStream, DecodedTrackPtr newTrack) {
+    if (newStream == nullptr && newTrack == nullptr) return;
 
-        sampleBuffer = std::make_unique<juce::AudioSampleBuffer>(numChannels, numSamples);
-        reader->read(sampleBuffer.get(), 0, numSamples, 0, true, numChannels > 1);
+    auto source = std::make_shared<Source>();
+    source->length = newStream ? newStream->getLengthInSamples() : newTrack->buffer.getNumSamples();
+    source->sampleRate = newStream ? newStream->getSampleRate() : newTrack->sampleRate;
+    source->stream = std::move(newStream);
+    source->track = newTrack;
+    source->original = std::move(newTrack);
 
-        // Handle mono to stereo conversion
-        if (numChannels == 1) {
-            auto stereoBuffer = std::make_unique<juce::AudioSampleBuffer>(2, numSamples);
-            stereoBuffer->copyFrom(0, 0, *sampleBuffer, 0, 0, numSamples);
-            stereoBuffer->copyFrom(1, 0, *sampleBuffer, 0, 0, numSamples);
-            sampleBuffer = std::move(stereoBuffer);
-        }
+    // Eine laufende Konvertierung gehört zum alten Material
+    ++conversionGeneration;
 
-        sampleLength = numSamples;
-        endPosition = sampleLength;
+    std::vector<RetiredSource> released;
+    {
+        const std::lock_guard<std::mutex> lock(sourceLock);
+
+        source->serial = ++nextSourceSerial;
+
+        // Update sample parameters
+        sampleLength = source->length;
+        endPosition = source->length;
         startPosition = 0;
         currentSample = 0;
+        sourceSampleRate = source->sampleRate;
+
+        // Reset interpolators for new sample
+        initializeInterpolators();
+
+        // Angebotene Konvertierung zurückziehen, bevor die neue Quelle sichtbar wird
+        withdrawPendingSource();
+
+        // Veröffentlichen, dann die Epoche lesen: ist sie gerade, liest der Audio Thread schon die neue Quelle
+        auto previous = std::move(currentSource);
+        currentSource = std::move(source);
+        liveSource.store(currentSource.get());
+
+        retire(std::move(previous));
+
+        released = takeReleasableSources();
     }
 
-    // Reset interpolators for new sample
-    initializeInterpolators();
+    // Erst außerhalb des Locks freigeben, ein Stream wartet dabei auf seinen Thread
+    released.clear();
 
     loaded = true;
     setDirty(true);
+
+    // Kompakte Speicherung: der Deck bekommt seine eigene 16-Bit-Kopie
+    if (sampleStorage.load() != SampleStorage::float32)
+        scheduleConversion();
+}
+
+void Sampler::releaseRetiredSources() {
+    std::vector<RetiredSource> released;
+    std::vector<std::weak_ptr<const DecodedTrack>> replacedDecodes;
+    {
+        const std::lock_guard<std::mutex> lock(sourceLock);
+        promoteAdoptedSource();
+        released = takeReleasableSources();
+
+        // Spielt der Deck seine kompakte Kopie, braucht er die Float-Dekodierung nicht mehr
+        if (currentSource != nullptr && currentSource->compact != nullptr)
+            for (const auto& retired : released)
+                if (retired.source->original != nullptr)
+                    replacedDecodes.push_back(retired.source->original);
+    }
+
+    released.clear();
+
+    // Erst danach hält nur noch der Cache die Dekodierung, dann gibt er sie auch frei
+    for (const auto& decode : replacedDecodes)
+        DecodedTrackCache::getInstance().releaseIfUnused(decode);
+}
+
+void Sampler::retire(std::shared_ptr<const Source> source) {
+    if (source != nullptr)
+        retiredSources.push_back({ std::move(source), renderEpoch.load() });
+}
+
+void Sampler::promoteAdoptedSource() {
+    // Nur unter sourceLock: eine vom Audio Thread übernommene Konvertierung wird zur aktuellen Quelle
+    if (pendingOwner == nullptr || liveSource.load() != pendingOwner.get())
+        return;
+
+    retire(std::move(currentSource));
+    currentSource = std::move(pendingOwner);
+}
+
+void Sampler::withdrawPendingSource() {
+    if (pendingOwner == nullptr)
+        return;
+
+    // Schon beansprucht: der Audio Thread entscheidet noch in diesem Block, also den Block abwarten
+    if (pendingSource.exchange(nullptr) == nullptr) {
+        const auto epoch = renderEpoch.load();
+
+        while ((epoch & 1) != 0 && renderEpoch.load() == epoch)
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+
+    promoteAdoptedSource();
+    retire(std::move(pendingOwner));
+}
+
+std::vector<Sampler::RetiredSource> Sampler::takeReleasableSources() {
+    // Frei ist eine Quelle, wenn beim Tausch kein Block lief oder dieser Block inzwischen vorbei ist
+    const auto epoch = renderEpoch.load();
+    std::vector<RetiredSource> released;
+
+    for (auto it = retiredSources.begin(); it != retiredSources.end();) {
+        if ((it->epoch & 1) == 0 || it->epoch != epoch) {
+            // Zähler des Streams bleibt in getStreamUnderrunCount() erhalten
+            if (it->source->stream != nullptr)
+                releasedUnderruns += it->source->stream->getUnderrunCount();
+
+            released.push_back(std::move(*it));
+            it = retiredSources.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+
+    return released;
+}
+
+void Sampler::scheduleConversion() {
+    const auto generation = ++conversionGeneration;
+
+    // Ein älteres Angebot (andere Zielrate oder Speicherung) darf nicht mehr übernommen werden
+    {
+        const std::lock_guard<std::mutex> lock(sourceLock);
+        withdrawPendingSource();
+    }
+
+    const auto source = getSource();
+
+    // Streams kommen direkt von der Platte und bleiben bei der Überbrückung im renderBlock
+    if (source == nullptr || source->stream != nullptr)
+        return;
+
+    const double targetRate = engineSampleRate.load();
+    const auto storage = sampleStorage.load();
+    const auto currentStorage = source->compact != nullptr ? source->compact->getFormat() : SampleStorage::float32;
+
+    if (std::abs(source->sampleRate - targetRate) < 1.0 && currentStorage == storage)
+        return;
+
+    conversionPool.addJob([this, source, generation, targetRate, storage] {
+        // Ausgangsmaterial ist die Originaldekodierung; kompakte Quellen behalten sie nicht, dann deren Float-Form
+        DecodedTrackPtr input = source->original;
+
+        if (input == nullptr) {
+            const auto& compact = *source->compact;
+            auto expanded = std::make_shared<DecodedTrack>(compact.getNumSamples(), compact.getSampleRate());
+            compact.toFloat(expanded->buffer);
+            input = std::move(expanded);
+        }
+
+        DecodedTrackPtr converted = input;
+
+        if (std::abs(input->sampleRate - targetRate) >= 1.0) {
+            const int length = ParallelResampler::getOutputLength(input->buffer.getNumSamples(), input->sampleRate, targetRate);
+            auto track = std::make_shared<DecodedTrack>(length, targetRate);
+
+            ParallelResampler::process(input->buffer, track->buffer, input->sampleRate, targetRate, resampler.getQuality());
+            converted = std::move(track);
+        }
+
+        auto replacement = std::make_shared<Source>();
+        replacement->length = converted->buffer.getNumSamples();
+        replacement->sampleRate = converted->sampleRate;
+
+        if (storage == SampleStorage::float32) {
+            replacement->original = input;
+            replacement->track = std::move(converted);
+        }
+        else {
+            replacement->compact = std::make_shared<const CompactSampleBuffer>(converted->buffer, storage, converted->sampleRate);
+        }
+
+        offerConvertedSource(source, std::move(replacement), generation);
+    });
+}
+
+void Sampler::offerConvertedSource(const std::shared_ptr<const Source>& base, std::shared_ptr<Source> replacement, juce::uint32 generation) {
+    std::vector<RetiredSource> released;
+    {
+        const std::lock_guard<std::mutex> lock(sourceLock);
+        withdrawPendingSource();
+
+        // Inzwischen neu geladen, Rate oder Speicherung erneut gewechselt: das Ergebnis ist überholt
+        if (generation != conversionGeneration.load() || currentSource != base)
+            return;
+
+        replacement->serial = ++nextSourceSerial;
+        replacement->replacesSerial = base->serial;
+
+        pendingOwner = std::move(replacement);
+        pendingSource.store(pendingOwner.get());
+
+        released = takeReleasableSources();
+    }
+}
+
+void Sampler::adoptConvertedSource(const Source& previous, const Source& converted) noexcept {
+    // Audio Thread: Positionen vom alten ins neue Raster umrechnen
+    const double scale = converted.sampleRate / previous.sampleRate;
+    auto convert = [scale](long position) { return (long)std::llround((double)position * scale); };
+
+    const bool wholeTrack = endPosition.load() >= sampleLength.load();
+
+    currentSample = convert(currentSample.load());
+    startPosition = convert(startPosition.load());
+    endPosition = wholeTrack ? converted.length : convert(endPosition.load());
+    sampleLength = converted.length;
+    sourceSampleRate = converted.sampleRate;
 }
 
 void Sampler::setPitch(float newPitch) noexcept {
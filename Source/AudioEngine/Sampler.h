@@ -10,7 +10,14 @@
 #include <JuceHeader.h>
 #include <memory>
 #include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
 #include "ADSR.h"
+#include "Resampler.h"
+#include "StreamingDeckSource.h"
+#include "DecodedTrackCache.h"
+#include "CompactSampleBuffer.h"
 
 class Sampler {
 public:
@@ -18,18 +25,46 @@ public:
     explicit Sampler(float sampleRate, int bufferSize);
     ~Sampler() = default;
 
+    // Engine rate from the audio device. When it changes, a loaded in-memory track is converted
+    // to it in the background; until the audio thread adopts the conversion, renderBlock bridges
+    // the two rates. Streams are always bridged.
+    void prepareToPlay(double newSampleRate, int newBlockSize);
+    double getEngineSampleRate() const noexcept { return engineSampleRate.load(); }
+
+    // Storage of in-memory tracks. float32 plays the shared decode; int16 and float16 give the
+    // deck its own CompactSampleBuffer, built in the background like a rate conversion and
+    // swapped in the same way. Until the audio thread adopts it both forms are held; after that
+    // releaseRetiredSources() drops the float decode and its cache entry unless something else
+    // still uses it, so the deck ends up at half the memory. Streams are not affected.
+    void setSampleStorage(SampleStorage storage);
+    SampleStorage getSampleStorage() const noexcept { return sampleStorage.load(); }
+
+    // Blocks until every queued conversion has been offered, so the next block that plays adopts
+    // it at its start. Offline rendering calls this before the first block, otherwise the output
+    // would depend on how fast the conversion ran. Not from the audio thread.
+    void waitForConversions();
+
     // Core playback control
     void play();
     void stop();
     void reset();
     void nextSample();
 
-    // Sample loading
+    // Sample loading: files are streamed from disk unless already in the DecodedTrackCache,
+    // streams are decoded into memory
     void loadSample(const juce::File& file);
     void loadSample(std::unique_ptr<juce::InputStream> input);
 
+    // Loading in two steps for the DeckLoader: openStream may run on any thread and leaves the
+    // deck untouched, installSource publishes the new material to the audio thread (see Source)
+    std::unique_ptr<StreamingDeckSource> openStream(const juce::File& file) const;
+    void installSource(std::unique_ptr<StreamingDeckSource> newStream, DecodedTrackPtr newTrack);
+
+    // Frees replaced sources the audio thread has stopped reading; never call from the audio thread
+    void releaseRetiredSources();
+
     // Position control
-    void setStartPosition(long start) noexcept { startPosition = start; setDirty(true); }
+    void setStartPosition(long start) noexcept;
     long getStartPosition() const noexcept { return startPosition; }
 
     void setEndPosition(long end) noexcept { endPosition = end; setDirty(true); }
@@ -38,7 +73,7 @@ public:
     void setSampleLength(long length) noexcept { sampleLength = length; setDirty(true); }
     long getSampleLength() const noexcept { return sampleLength; }
 
-    void setCurrentPosition(long position) noexcept { currentSample = position; }
+    void setCurrentPosition(long position) noexcept;
     long getCurrentPosition() const noexcept { return currentSample; }
 
     // Playback parameters
@@ -53,8 +88,23 @@ public:
     void setPitch(float newPitch) noexcept;
     float getPitch() const noexcept { return pitch; }
 
+    // Interpolation used by renderBlock when rate != 1
+    void setResamplerQuality(Resampler::Quality quality) noexcept { resampler.setQuality(quality); }
+    Resampler::Quality getResamplerQuality() const noexcept { return resampler.getQuality(); }
+
+    // Hot cues, kept cached by the streaming source (index 0 .. maxHotCues - 1)
+    static constexpr int maxHotCues = StreamingDeckSource::maxPins - 1;
+    void setHotCue(int index, long position) noexcept;
+
+    // Sample rate of the loaded material; positions are in frames at this rate
+    double getSourceSampleRate() const noexcept;
+    bool isStreaming() const;
+
+    // Blocks the disk stream could not serve in time, over every stream this deck has played
+    int getStreamUnderrunCount() const;
+
     // State queries
-    bool hasSample() const noexcept { return loaded && sampleBuffer != nullptr; }
+    bool hasSample() const noexcept { return loaded && liveSource.load() != nullptr; }
     bool isPlaying() const noexcept { return playing.load(); }
     bool isDone() const noexcept { return !loop && currentSample >= sampleLength - 1; }
     bool isDirty() const noexcept { return dirty.load(); }
@@ -64,8 +114,14 @@ public:
     float getCurrentSample(int channel) const;
     float getOutput(int channel);
 
-    // Buffer access
-    const juce::AudioSampleBuffer* getSampleBuffer() const noexcept { return sampleBuffer.get(); }
+    // Block render for the audio thread: writes numSamples stereo frames into outL/outR
+    // (silence once the sample has ended), advancing the play position by rate per frame.
+    // Source, bounds and envelope are resolved once per block. Wait-free: a load running
+    // at the same time never blocks or silences the block.
+    void renderBlock(float* outL, float* outR, int numSamples, double rate, float gain);
+
+    // In-memory float material, nullptr while a file is streamed or stored compact
+    DecodedTrackPtr getTrack() const;
 
     // Editor integration
     void setLoaded(bool isLoaded) noexcept { loaded = isLoaded; }
@@ -73,9 +129,55 @@ public:
 
 private:
 
+    // Loaded material, never changed once published. The audio thread reads it through
+    // liveSource and marks each block by making renderEpoch odd; a replaced source is
+    // retired with the epoch seen at the swap and freed only once the audio thread has
+    // left that block. All other threads take a shared_ptr copy under sourceLock.
+    // A rate or storage conversion is offered through pendingSource instead: the audio thread
+    // swaps it in at the start of a block and converts the play positions in the same step.
+    struct Source
+    {
+        DecodedTrackPtr track;                          // in-memory material, shared with the DecodedTrackCache
+        DecodedTrackPtr original;                       // as decoded, conversions start from here if present
+        std::shared_ptr<const CompactSampleBuffer> compact; // instead of track for int16 / float16 storage
+        std::unique_ptr<StreamingDeckSource> stream;
+        long length = 0;
+        double sampleRate = 0.0;
+        juce::uint32 serial = 0;
+        juce::uint32 replacesSerial = 0;                // conversion: only valid on top of this source
+    };
+
+    struct RetiredSource
+    {
+        std::shared_ptr<const Source> source;
+        juce::uint64 epoch = 0;
+    };
+
+    std::shared_ptr<const Source> getSource() const;
+    std::vector<RetiredSource> takeReleasableSources();
+    void retire(std::shared_ptr<const Source> source);
+    void promoteAdoptedSource();
+    void withdrawPendingSource();
+    void scheduleConversion();
+    void offerConvertedSource(const std::shared_ptr<const Source>& base, std::shared_ptr<Source> replacement, juce::uint32 generation);
+    void adoptConvertedSource(const Source& previous, const Source& converted) noexcept;
+
     // Audio management
     std::unique_ptr<juce::AudioFormatManager> formatManager;
-    std::unique_ptr<juce::AudioSampleBuffer> sampleBuffer;
+    juce::AudioSampleBuffer streamScratch;  // source window for resampling a stream, see renderWindowFrames
+
+    std::shared_ptr<const Source> currentSource;       // owner, guarded by sourceLock
+    std::atomic<const Source*> liveSource{ nullptr };  // what renderBlock reads
+    std::atomic<juce::uint64> renderEpoch{ 0 };       // odd while renderBlock holds liveSource
+    std::vector<RetiredSource> retiredSources;         // guarded by sourceLock
+    std::shared_ptr<const Source> pendingOwner;        // offered conversion, guarded by sourceLock
+    std::atomic<const Source*> pendingSource{ nullptr };
+    std::atomic<juce::uint32> conversionGeneration{ 0 };
+    juce::uint32 nextSourceSerial = 0;                 // guarded by sourceLock
+    int releasedUnderruns = 0;                         // of freed streams, guarded by sourceLock
+    juce::uint32 renderedSourceSerial = 0;             // audio thread only
+    std::atomic<double> sourceSampleRate{ 0.0 };
+    mutable std::mutex sourceLock;
 
     // Interpolation
     std::unique_ptr<juce::CatmullRomInterpolator> interpolatorLeft;
@@ -84,17 +186,22 @@ private:
     // Envelope
     std::unique_ptr<SynthLab::ADSR> samplerEnvelope;
 
+    // Varispeed interpolation, one per deck
+    Resampler resampler;
+
     // Sample parameters
-    float sampleRate;
+    std::atomic<double> engineSampleRate;
+    std::atomic<SampleStorage> sampleStorage{ SampleStorage::float32 };
     int bufferSize;
     std::atomic<float> volume{ 0.5f };
     std::atomic<float> pitch{ 1.0f };
 
     // Position tracking
     std::atomic<long> currentSample{ 0 };
-    long startPosition = 0;
-    long endPosition = 0;
-    long sampleLength = 0;
+    double playbackFraction = 0.0; // sub-sample part of the play position, audio thread only
+    std::atomic<long> startPosition{ 0 };  // written by adoptConvertedSource on the audio thread, too
+    std::atomic<long> endPosition{ 0 };
+    std::atomic<long> sampleLength{ 0 };
 
     // State flags
     std::atomic<bool> loop{ false };
@@ -102,13 +209,22 @@ private:
     std::atomic<bool> playing{ false };
     std::atomic<bool> dirty{ false };
 
-    // Thread safety
-    juce::CriticalSection bufferLock;
-
     // Helper methods
     void initializeInterpolators();
     void validateSampleBounds();
     float interpolateSample(int channel, double position) const;
+    long renderFrames(const float* srcL, const float* srcR, float* outL, float* outR,
+                      int numSamples, long position, double& fraction, double rate,
+                      long start, long end, bool looping, bool& finished) const noexcept;
+    template <typename Window>
+    long renderWindowFrames(Window& window, float* outL, float* outR, int numSamples, long position,
+                            double& fraction, double rate, long start, long end, bool looping, bool& finished) noexcept;
+
+    static constexpr int streamBlockSize = 256;    // output frames per stream or compact read
+    static constexpr double maxStreamRate = 8.0;   // pitch * source / engine rate
+
+    // Background rate and storage conversions; declared last so it is stopped before anything a job uses
+    juce::ThreadPool conversionPool{ 1 };
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Sampler)
 };
\ No newline at end of file
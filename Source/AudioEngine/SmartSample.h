@@ -1,7 +1,7 @@
 #pragma once
 
 #include <juce_audio_formats/juce_audio_formats.h>
-#include <juce_audio_utils/juce_audio_utils.h>
+#include "ParallelResampler.h"
 #include <stdexcept>
 
 class SmartSample
@@ -40,7 +40,8 @@ public:
         // Resample falls nötig
         if (std::abs(originalSampleRate - engineSampleRate) > 1.0)
         {
-            buffer = resampleWithResamplingSource(tempBuffer, originalSampleRate, engineSampleRate);
+            // Chunks und Kanäle parallel, Ergebnis bitgleich zur seriellen Konvertierung
+            ParallelResampler::process(tempBuffer, buffer, originalSampleRate, engineSampleRate);
             wasResampled = true;
         }
         else
@@ -72,70 +73,4 @@ private:
     int numChannels = 0;
     int lengthInSamples = 0;
     juce::String filePath;
-
-    juce::AudioSampleBuffer resampleWithResamplingSource(const juce::AudioSampleBuffer& input,
-        double fromRate, double toRate)
-    {
-        const double ratio = toRate / fromRate;
-        const int estimatedLength = static_cast<int>(std::ceil(input.getNumSamples() * ratio));
-
-        juce::AudioSampleBuffer resultBuffer(input.getNumChannels(), estimatedLength);
-        resultBuffer.clear();
-
-        auto memorySource = std::make_unique<MemoryAudioSource>(input, fromRate);
-        juce::ResamplingAudioSource resampler(memorySource.get(), false);
-        resampler.setResamplingRatio(fromRate / toRate);
-        resampler.prepareToPlay(512, toRate); // 512 = block size, kannst du anpassen
-
-        juce::AudioSourceChannelInfo info(&resultBuffer, 0, estimatedLength);
-        resampler.getNextAudioBlock(info);
-
-        resampler.releaseResources();
-
-        return resultBuffer;
-    }
-
-
-    class MemoryAudioSource : public juce::AudioSource
-    {
-    public:
-        MemoryAudioSource(const juce::AudioBuffer<float>& bufferToUse, double sampleRate)
-            : buffer(bufferToUse), rate(sampleRate)
-        {
-        }
-
-        void prepareToPlay(int, double) override
-        {
-            position = 0;
-        }
-
-        void releaseResources() override {}
-
-        void getNextAudioBlock(const juce::AudioSourceChannelInfo& info) override
-        {
-            const int numSamples = info.numSamples;
-            const int numAvailable = buffer.getNumSamples() - position;
-            const int numToCopy = juce::jmin(numSamples, numAvailable);
-
-            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-            {
-                if (info.buffer->getNumChannels() > ch)
-                    info.buffer->copyFrom(ch, info.startSample, buffer, ch, position, numToCopy);
-            }
-
-            if (numToCopy < numSamples)
-            {
-                for (int ch = 0; ch < info.buffer->getNumChannels(); ++ch)
-                    info.buffer->clear(ch, info.startSample + numToCopy, numSamples - numToCopy);
-            }
-
-            position += numToCopy;
-        }
-
-    private:
-        const juce::AudioBuffer<float>& buffer;
-        int position = 0;
-        double rate;
-    };
-
 };
@@ -0,0 +1,232 @@
+/*
+  ==============================================================================
+
+    StreamingDeckSource.cpp
+    Created: 16 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "StreamingDeckSource.h"
+
+StreamingDeckSource::StreamingDeckSource(std::unique_ptr<juce::AudioFormatReader> sourceReader)
+    : juce::Thread("Deck Read-Ahead")
+    , reader(std::move(sourceReader))
+    , lengthInSamples(reader != nullptr ? (long)reader->lengthInSamples : 0)
+    , sourceSampleRate(reader != nullptr ? reader->sampleRate : 0.0)
+{
+    const size_t slotSize = 2 * (size_t)chunkFrames;
+    storage = SampleMemoryPool::getInstance().allocate((windowSlots.size() + pinSlots.size()) * slotSize);
+
+    // Alle Slots liegen in einem Block, links und rechts hintereinander
+    float* next = storage.getData();
+    auto assignStorage = [&next, slotSize](Slot& slot)
+    {
+        slot.data = { next, next + chunkFrames };
+        next += slotSize;
+    };
+
+    for (auto& slot : windowSlots)
+        assignStorage(slot);
+
+    for (auto& slot : pinSlots)
+        assignStorage(slot);
+
+    for (auto& pin : pinPositions)
+        pin = -1;
+}
+
+StreamingDeckSource::~StreamingDeckSource()
+{
+    stopThread(2000);
+}
+
+void StreamingDeckSource::start()
+{
+    // Den Anfang sofort laden, damit play() direkt nach dem Laden hörbar ist
+    if (lengthInSamples > 0)
+        loadChunk(windowSlots[0], 0);
+
+    startThread(juce::Thread::Priority::high);
+}
+
+void StreamingDeckSource::seekHint(long position) noexcept
+{
+    playhead = position;
+    notify();
+}
+
+void StreamingDeckSource::setPinnedPosition(int pin, long position) noexcept
+{
+    if (pin < 0 || pin >= maxPins)
+        return;
+
+    pinPositions[(size_t)pin] = position;
+    notify();
+}
+
+void StreamingDeckSource::read(long first, int count, float* outL, float* outR, long start, long end, bool looping) noexcept
+{
+    playhead.store(first, std::memory_order_relaxed);
+
+    int written = 0;
+
+    while (written < count)
+    {
+        long index = first + written;
+        int run = count - written;
+
+        if (index < start || index >= end)
+        {
+            if (looping && end > start)
+            {
+                index = start + ((index - start) % (end - start) + (end - start)) % (end - start);
+            }
+            else
+            {
+                // Außerhalb der Region: Stille bis zum Regionsanfang bzw. bis zum Ende
+                if (index < start)
+                    run = (int)juce::jmin((long)run, start - index);
+
+                juce::FloatVectorOperations::clear(outL + written, run);
+                juce::FloatVectorOperations::clear(outR + written, run);
+                written += run;
+                continue;
+            }
+        }
+
+        run = (int)juce::jmin((long)run, end - index);
+        copyFromCache(index, run, outL + written, outR + written);
+        written += run;
+    }
+}
+
+void StreamingDeckSource::copyFromCache(long index, int count, float* outL, float* outR) noexcept
+{
+    while (count > 0)
+    {
+        const long chunk = index / chunkFrames;
+        const int offset = (int)(index - chunk * chunkFrames);
+        const int run = juce::jmin(count, chunkFrames - offset);
+
+        const Slot* slot = index < lengthInSamples ? findSlot(chunk) : nullptr;
+        bool valid = slot != nullptr;
+
+        if (valid)
+        {
+            juce::FloatVectorOperations::copy(outL, slot->data[0] + offset, run);
+            juce::FloatVectorOperations::copy(outR, slot->data[1] + offset, run);
+
+            // Sequenz-Lock: wurde der Slot während des Kopierens neu befüllt, ist die Kopie ungültig
+            std::atomic_thread_fence(std::memory_order_acquire);
+            valid = slot->chunk.load(std::memory_order_relaxed) == chunk;
+        }
+
+        if (!valid)
+        {
+            juce::FloatVectorOperations::clear(outL, run);
+            juce::FloatVectorOperations::clear(outR, run);
+
+            if (index < lengthInSamples)
+                underruns.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        index += run;
+        outL += run;
+        outR += run;
+        count -= run;
+    }
+}
+
+const StreamingDeckSource::Slot* StreamingDeckSource::findSlot(long chunk) const noexcept
+{
+    const auto& windowSlot = windowSlots[(size_t)(chunk % numWindowSlots)];
+    if (windowSlot.chunk.load(std::memory_order_acquire) == chunk)
+        return &windowSlot;
+
+    for (const auto& pinSlot : pinSlots)
+        if (pinSlot.chunk.load(std::memory_order_acquire) == chunk)
+            return &pinSlot;
+
+    return nullptr;
+}
+
+bool StreamingDeckSource::isCached(long chunk) const noexcept
+{
+    return findSlot(chunk) != nullptr;
+}
+
+void StreamingDeckSource::run()
+{
+    while (!threadShouldExit())
+    {
+        if (!fillNextMissingChunk())
+            wait(10);
+    }
+}
+
+bool StreamingDeckSource::fillNextMissingChunk()
+{
+    const long total = numChunks();
+    const long current = juce::jlimit(0L, juce::jmax(0L, total - 1), playhead.load() / chunkFrames);
+
+    // Zuerst vorwärts ab der Abspielposition, das ist was als Nächstes gebraucht wird
+    for (long chunk = current; chunk < juce::jmin(total, current + chunksAhead); ++chunk)
+    {
+        if (!isCached(chunk))
+        {
+            loadChunk(windowSlots[(size_t)(chunk % numWindowSlots)], chunk);
+            return true;
+        }
+    }
+
+    // Dann Loop-Anfang und Hot Cues
+    for (int pin = 0; pin < maxPins; ++pin)
+    {
+        const long position = pinPositions[(size_t)pin].load();
+        if (position < 0)
+            continue;
+
+        for (int k = 0; k < chunksPerPin; ++k)
+        {
+            const long chunk = position / chunkFrames + k;
+            auto& slot = pinSlots[(size_t)(pin * chunksPerPin + k)];
+
+            if (chunk < total && slot.chunk.load() != chunk)
+            {
+                loadChunk(slot, chunk);
+                return true;
+            }
+        }
+    }
+
+    // Zuletzt ein Stück zurück, für kurzes Zurückspulen und Scratchen
+    for (long chunk = current - 1; chunk >= juce::jmax(0L, current - chunksBehind); --chunk)
+    {
+        if (!isCached(chunk))
+        {
+            loadChunk(windowSlots[(size_t)(chunk % numWindowSlots)], chunk);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void StreamingDeckSource::loadChunk(Slot& slot, long chunk)
+{
+    slot.chunk.store(loadingTag, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    const long first = chunk * chunkFrames;
+    const int count = (int)juce::jmin((long)chunkFrames, lengthInSamples - first);
+
+    // Direkt in den Slot dekodieren, Mono-Dateien landen auf beiden Kanälen
+    juce::AudioBuffer<float> target(slot.data.data(), 2, chunkFrames);
+    target.clear();
+
+    if (count > 0)
+        reader->read(&target, 0, count, first, true, true);
+
+    slot.chunk.store(chunk, std::memory_order_release);
+}
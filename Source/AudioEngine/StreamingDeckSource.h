@@ -0,0 +1,105 @@
+/*
+  ==============================================================================
+
+    StreamingDeckSource.h
+    Created: 16 Oct 2026
+
+    Disk streaming for one deck. Instead of decoding the whole track into
+    memory, a read-ahead thread decodes fixed-size chunks into a cache around
+    the playhead, so deck memory is bounded by the window and playback can
+    start as soon as the first chunk is there.
+
+    Cache layout, 16384 frames per chunk:
+
+      window   64 direct-mapped slots (chunk % 64), filled up to 40 chunks
+               ahead of and 8 behind the playhead (about 15 s / 3 s at
+               44.1 kHz), ~8 MB per deck
+      pinned   2 chunks for each of maxPins positions (loop in, hot cues),
+               kept warm so a jump there does not wait for the disk
+
+    The audio thread never blocks and never allocates: every slot carries an
+    atomic chunk tag used as a sequence lock, a read that finds a slot empty
+    or being refilled outputs silence for that span and counts an underrun.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "SampleMemoryPool.h"
+#include <array>
+#include <atomic>
+#include <memory>
+
+class StreamingDeckSource : private juce::Thread
+{
+public:
+    static constexpr int chunkFrames = 16384;
+    static constexpr int numWindowSlots = 64;
+    static constexpr int chunksAhead = 40;
+    static constexpr int chunksBehind = 8;
+    static constexpr int maxPins = 8;
+    static constexpr int chunksPerPin = 2;
+
+    /** Takes ownership of the reader; from here on only the read-ahead thread touches it. */
+    explicit StreamingDeckSource(std::unique_ptr<juce::AudioFormatReader> sourceReader);
+    ~StreamingDeckSource() override;
+
+    /** Decodes the first chunk synchronously and starts the read-ahead thread. */
+    void start();
+
+    long getLengthInSamples() const noexcept { return lengthInSamples; }
+    double getSampleRate() const noexcept { return sourceSampleRate; }
+
+    /**
+        Audio thread. Copies count stereo frames starting at first into outL/outR.
+        Indices outside [start, end) wrap when looping and are silent otherwise;
+        frames that are not cached yet are silent as well. Also moves the
+        read-ahead window to first.
+    */
+    void read(long first, int count, float* outL, float* outR, long start, long end, bool looping) noexcept;
+
+    /** Message thread: moves the read-ahead window right away, e.g. for a seek. */
+    void seekHint(long position) noexcept;
+
+    /** Keeps the area around position cached; a negative position clears the pin. */
+    void setPinnedPosition(int pin, long position) noexcept;
+
+    /** Number of read spans that found their chunk missing. */
+    int getUnderrunCount() const noexcept { return underruns.load(); }
+
+private:
+    struct Slot
+    {
+        std::atomic<long> chunk { emptyTag };
+        std::array<float*, 2> data {};
+    };
+
+    static constexpr long emptyTag = -1;
+    static constexpr long loadingTag = -2;
+
+    void run() override;
+
+    bool fillNextMissingChunk();
+    bool isCached(long chunk) const noexcept;
+    void loadChunk(Slot& slot, long chunk);
+    void copyFromCache(long index, int count, float* outL, float* outR) noexcept;
+    const Slot* findSlot(long chunk) const noexcept;
+
+    long numChunks() const noexcept { return (lengthInSamples + chunkFrames - 1) / chunkFrames; }
+
+    std::unique_ptr<juce::AudioFormatReader> reader;
+    const long lengthInSamples;
+    const double sourceSampleRate;
+
+    SampleMemoryPool::Block storage;      // alle Slots, aus dem Pool wiederverwendet
+    std::array<Slot, numWindowSlots> windowSlots;
+    std::array<Slot, maxPins * chunksPerPin> pinSlots;
+    std::array<std::atomic<long>, maxPins> pinPositions;
+
+    std::atomic<long> playhead { 0 };
+    std::atomic<int> underruns { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StreamingDeckSource)
+};
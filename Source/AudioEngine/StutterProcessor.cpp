@@ -0,0 +1,303 @@
+/*
+  ==============================================================================
+
+    StutterProcessor.cpp
+    Created: 16 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "StutterProcessor.h"
+#include <cmath>
+
+void StutterProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
+{
+    currentSampleRate = sampleRate;
+    currentBufferSize = samplesPerBlock;
+
+    // Prepare stutter buffer (2 seconds should be enough for longest stutters)
+    stutterBuffer.setSize(2, static_cast<int>(sampleRate * 2.0));
+    stutterBuffer.clear();
+
+    // Prepare dry buffer for mixing
+    dryBuffer.setSize(2, samplesPerBlock);
+    dryBuffer.clear();
+}
+
+void StutterProcessor::processAudioBuffer(juce::AudioBuffer<float>& buffer)
+{
+    if (!stutterState.isActive)
+        return;
+
+    // Store dry signal for mixing - copy into the buffer sized in prepareToPlay,
+    // makeCopyOf() would reallocate whenever the block size differs
+    const int numDryChannels = juce::jmin(buffer.getNumChannels(), dryBuffer.getNumChannels());
+    const int numDrySamples = juce::jmin(buffer.getNumSamples(), dryBuffer.getNumSamples());
+    jassert(numDrySamples == buffer.getNumSamples());
+
+    for (int ch = 0; ch < numDryChannels; ++ch)
+        dryBuffer.copyFrom(ch, 0, buffer, ch, 0, numDrySamples);
+
+    // Update parameters from sliders
+    updateParameters();
+
+    switch (stutterState.type)
+    {
+    case CLASSIC_STUTTER:
+        processClassicStutter(buffer);
+        break;
+    case GATE_STUTTER:
+        processGateStutter(buffer);
+        break;
+    case REVERSE_STUTTER:
+        processReverseStutter(buffer);
+        break;
+    case PITCHED_STUTTER:
+        processPitchedStutter(buffer);
+        break;
+    }
+
+    // Apply dry/wet mixing
+    applyDryWetMix(buffer, dryBuffer);
+}
+
+void StutterProcessor::releaseResources()
+{
+    stutterBuffer.setSize(0, 0);
+    dryBuffer.setSize(0, 0);
+}
+
+void StutterProcessor::startStutter(StutterType type, int subdivision)
+{
+    stutterState.isActive = true;
+    stutterState.type = type;
+    stutterState.currentPosition = 0;
+    stutterState.fadeCounter = 0.0f;
+    stutterState.bufferCaptured = false;
+
+    // Calculate subdivision length in samples with length parameter
+    double beatsPerSecond = 120.0 / 60.0;
+    double subdivisionTime = (1.0 / beatsPerSecond) / stutterSubdivisions[subdivision];
+    subdivisionTime *= lengthParam.load(); // Apply length multiplier
+    stutterState.subdivisionSamples = static_cast<int>(currentSampleRate * subdivisionTime);
+
+    // Ensure we don't exceed buffer size
+    stutterState.subdivisionSamples = std::min(stutterState.subdivisionSamples,
+        stutterBuffer.getNumSamples() - 1);
+
+    stutterBuffer.clear();
+}
+
+void StutterProcessor::updateParameters()
+{
+    stutterState.length = lengthParam.load();
+    stutterState.intensity = intensityParam.load();
+    stutterState.feedback = feedbackParam.load();
+    stutterState.mix = mixParam.load();
+}
+
+void StutterProcessor::applyDryWetMix(juce::AudioBuffer<float>& wetBuffer, const juce::AudioBuffer<float>& dryBuffer)
+{
+    float wetLevel = stutterState.mix;
+    float dryLevel = 1.0f - wetLevel;
+
+    int numChannels = std::min(wetBuffer.getNumChannels(), dryBuffer.getNumChannels());
+    int numSamples = std::min(wetBuffer.getNumSamples(), dryBuffer.getNumSamples());
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        for (int sample = 0; sample < numSamples; ++sample)
+        {
+            float wetSample = wetBuffer.getSample(ch, sample) * wetLevel;
+            float drySample = dryBuffer.getSample(ch, sample) * dryLevel;
+            wetBuffer.setSample(ch, sample, wetSample + drySample);
+        }
+    }
+}
+
+void StutterProcessor::stopStutter()
+{
+    stutterState.isActive = false;
+    stutterState.currentPosition = 0;
+    stutterState.bufferCaptured = false;
+}
+
+void StutterProcessor::processClassicStutter(juce::AudioBuffer<float>& buffer)
+{
+    int numSamples = buffer.getNumSamples();
+    int numChannels = buffer.getNumChannels();
+
+    // Capture the first subdivision into our stutter buffer
+    if (!stutterState.bufferCaptured && stutterState.currentPosition < stutterState.subdivisionSamples)
+    {
+        for (int sample = 0; sample < numSamples; ++sample)
+        {
+            int capturePos = stutterState.currentPosition + sample;
+            if (capturePos < stutterState.subdivisionSamples && capturePos < stutterBuffer.getNumSamples())
+            {
+                for (int ch = 0; ch < std::min(numChannels, stutterBuffer.getNumChannels()); ++ch)
+                {
+                    float inputSample = buffer.getSample(ch, sample);
+                    float feedbackSample = stutterBuffer.getSample(ch, capturePos) * stutterState.feedback;
+                    stutterBuffer.setSample(ch, capturePos, inputSample + feedbackSample);
+                }
+            }
+        }
+
+        stutterState.currentPosition += numSamples;
+
+        if (stutterState.currentPosition >= stutterState.subdivisionSamples)
+        {
+            stutterState.bufferCaptured = true;
+            stutterState.currentPosition = 0;
+        }
+        return;
+    }
+
+    // Play back the captured audio in a loop with intensity control
+    for (int sample = 0; sample < numSamples; ++sample)
+    {
+        int playbackPosition = stutterState.currentPosition % stutterState.subdivisionSamples;
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            if (playbackPosition < stutterBuffer.getNumSamples() && ch < stutterBuffer.getNumChannels())
+            {
+                float stutterSample = stutterBuffer.getSample(ch, playbackPosition);
+                buffer.setSample(ch, sample, stutterSample * stutterState.intensity);
+            }
+        }
+
+        stutterState.currentPosition++;
+    }
+}
+
+void StutterProcessor::processGateStutter(juce::AudioBuffer<float>& buffer)
+{
+    int numSamples = buffer.getNumSamples();
+
+    for (int sample = 0; sample < numSamples; ++sample)
+    {
+        int gatePosition = stutterState.currentPosition % stutterState.subdivisionSamples;
+        float gatePhase = static_cast<float>(gatePosition) / stutterState.subdivisionSamples;
+
+        // Create gate pattern based on intensity
+        bool gateOpen = gatePhase < stutterState.intensity;
+
+        if (!gateOpen)
+        {
+            // Apply smooth fade instead of hard cut for less harsh sound
+            float fade = 1.0f - stutterState.intensity;
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            {
+                buffer.setSample(ch, sample, buffer.getSample(ch, sample) * fade);
+            }
+        }
+
+        stutterState.currentPosition++;
+    }
+}
+
+void StutterProcessor::processReverseStutter(juce::AudioBuffer<float>& buffer)
+{
+    int numSamples = buffer.getNumSamples();
+    int numChannels = buffer.getNumChannels();
+
+    // Capture phase
+    if (!stutterState.bufferCaptured && stutterState.currentPosition < stutterState.subdivisionSamples)
+    {
+        for (int sample = 0; sample < numSamples; ++sample)
+        {
+            int capturePos = stutterState.currentPosition + sample;
+            if (capturePos < stutterState.subdivisionSamples && capturePos < stutterBuffer.getNumSamples())
+            {
+                for (int ch = 0; ch < std::min(numChannels, stutterBuffer.getNumChannels()); ++ch)
+                {
+                    stutterBuffer.setSample(ch, capturePos, buffer.getSample(ch, sample));
+                }
+            }
+        }
+
+        stutterState.currentPosition += numSamples;
+
+        if (stutterState.currentPosition >= stutterState.subdivisionSamples)
+        {
+            stutterState.bufferCaptured = true;
+            stutterState.currentPosition = 0;
+        }
+        return;
+    }
+
+    // Play back reversed
+    for (int sample = 0; sample < numSamples; ++sample)
+    {
+        int playbackPosition = stutterState.currentPosition % stutterState.subdivisionSamples;
+        int reversePosition = stutterState.subdivisionSamples - 1 - playbackPosition;
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            if (reversePosition >= 0 && reversePosition < stutterBuffer.getNumSamples() &&
+                ch < stutterBuffer.getNumChannels())
+            {
+                buffer.setSample(ch, sample, stutterBuffer.getSample(ch, reversePosition));
+            }
+        }
+
+        stutterState.currentPosition++;
+    }
+}
+
+void StutterProcessor::processPitchedStutter(juce::AudioBuffer<float>& buffer)
+{
+    int numSamples = buffer.getNumSamples();
+    int numChannels = buffer.getNumChannels();
+
+    // Capture phase
+    if (!stutterState.bufferCaptured && stutterState.currentPosition < stutterState.subdivisionSamples)
+    {
+        for (int sample = 0; sample < numSamples; ++sample)
+        {
+            int capturePos = stutterState.currentPosition + sample;
+            if (capturePos < stutterState.subdivisionSamples && capturePos < stutterBuffer.getNumSamples())
+            {
+                for (int ch = 0; ch < std::min(numChannels, stutterBuffer.getNumChannels()); ++ch)
+                {
+                    stutterBuffer.setSample(ch, capturePos, buffer.getSample(ch, sample));
+                }
+            }
+        }
+
+        stutterState.currentPosition += numSamples;
+
+        if (stutterState.currentPosition >= stutterState.subdivisionSamples)
+        {
+            stutterState.bufferCaptured = true;
+            stutterState.currentPosition = 0;
+        }
+        return;
+    }
+
+    // Play back with pitch modulation based on intensity parameter
+    for (int sample = 0; sample < numSamples; ++sample)
+    {
+        int playbackPosition = stutterState.currentPosition % stutterState.subdivisionSamples;
+
+        // Pitch modulation depth controlled by intensity
+        float pitchDepth = stutterState.intensity * 0.5f; // Max 50% pitch change
+        float pitchFactor = 1.0f + pitchDepth * std::sin(2.0f * juce::MathConstants<float>::pi *
+            playbackPosition / (float)stutterState.subdivisionSamples);
+
+        int modulatedPosition = static_cast<int>(playbackPosition * pitchFactor);
+        modulatedPosition = modulatedPosition % stutterState.subdivisionSamples;
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            if (modulatedPosition < stutterBuffer.getNumSamples() && ch < stutterBuffer.getNumChannels())
+            {
+                buffer.setSample(ch, sample, stutterBuffer.getSample(ch, modulatedPosition));
+            }
+        }
+
+        stutterState.currentPosition++;
+    }
+}
@@ -0,0 +1,94 @@
+/*
+  ==============================================================================
+
+    StutterProcessor.h
+    Created: 16 Oct 2026
+
+    The stutter DSP (classic repeat, gate, reverse and pitched stutter with
+    dry/wet mix) without any UI, so the mixer core can be built and run
+    headless. StutterEffectComponent owns one and forwards its buttons and
+    sliders to it.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+
+class StutterProcessor
+{
+public:
+    enum StutterType
+    {
+        CLASSIC_STUTTER = 0,    // Klassisches wiederholendes Stottern
+        GATE_STUTTER,           // Gate-artiges Ein/Aus
+        REVERSE_STUTTER,        // Rückwärts-Stutter
+        PITCHED_STUTTER         // Pitch-moduliertes Stutter
+    };
+
+    StutterProcessor() = default;
+
+    void prepareToPlay(double sampleRate, int samplesPerBlock);
+    void processAudioBuffer(juce::AudioBuffer<float>& buffer);
+    void releaseResources();
+
+    /** Starts a stutter of the given type; subdivision indexes 1/16, 1/8, 1/4 and 1/2 notes. */
+    void startStutter(StutterType type, int subdivision);
+    void stopStutter();
+
+    bool isStutterActive() const { return stutterState.isActive; }
+    StutterType getStutterType() const { return stutterState.type; }
+
+    // Vom Message Thread gesetzt, der Audio Thread liest sie einmal pro Block
+    void setLength(float newLength) { lengthParam = newLength; }
+    void setIntensity(float newIntensity) { intensityParam = newIntensity; }
+    void setFeedback(float newFeedback) { feedbackParam = newFeedback; }
+    void setMix(float newMix) { mixParam = newMix; }
+
+private:
+    // Stutter parameters
+    struct StutterParams
+    {
+        bool isActive = false;
+        int subdivisionSamples = 0;
+        int currentPosition = 0;
+        float fadeCounter = 0.0f;
+        StutterType type = CLASSIC_STUTTER;
+        bool bufferCaptured = false;
+
+        // User controllable parameters
+        float length = 0.5f;        // 0.1 - 2.0 (multiplier for subdivision length)
+        float intensity = 0.8f;     // 0.0 - 1.0 (effect strength)
+        float feedback = 0.3f;      // 0.0 - 0.9 (for repeating effects)
+        float mix = 1.0f;           // 0.0 - 1.0 (dry/wet mix)
+    };
+
+    StutterParams stutterState;
+
+    std::atomic<float> lengthParam { 0.5f };
+    std::atomic<float> intensityParam { 0.8f };
+    std::atomic<float> feedbackParam { 0.3f };
+    std::atomic<float> mixParam { 1.0f };
+
+    // Audio buffer for storing stuttered audio
+    juce::AudioBuffer<float> stutterBuffer;
+    juce::AudioBuffer<float> dryBuffer;  // For dry/wet mixing
+
+    // Audio parameters
+    double currentSampleRate = 44100.0;
+    int currentBufferSize = 512;
+
+    // Stutter timing (16th notes, 8th notes, etc.)
+    const int stutterSubdivisions[4] = { 16, 8, 4, 2 }; // 16tel, 8tel, 4tel, halbe Noten
+
+    void updateParameters();
+    void processClassicStutter(juce::AudioBuffer<float>& buffer);
+    void processGateStutter(juce::AudioBuffer<float>& buffer);
+    void processReverseStutter(juce::AudioBuffer<float>& buffer);
+    void processPitchedStutter(juce::AudioBuffer<float>& buffer);
+    void applyDryWetMix(juce::AudioBuffer<float>& wetBuffer, const juce::AudioBuffer<float>& dryBuffer);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StutterProcessor)
+};
@@ -0,0 +1,263 @@
+/*
+  ==============================================================================
+
+    TempoEstimator.cpp
+    Created: 16 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "TempoEstimator.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    constexpr double bpmStep = 0.1;
+    constexpr int numCombTeeth = 4;
+    constexpr double localMeanSeconds = 0.5;
+    constexpr float minRefinementPeak = 0.05f;
+}
+
+//==============================================================================
+void TempoEstimator::prepare(int newMaxFrames, double newFrameRate, const Options& newOptions)
+{
+    options = newOptions;
+    frameRate = newFrameRate;
+    maxFrames = juce::jmax(16, newMaxFrames);
+
+    // Zero-Padding auf mindestens 2n, sonst läuft die zyklische Korrelation in sich selbst
+    int fftOrder = 1;
+    while ((1 << fftOrder) < 2 * maxFrames)
+        ++fftOrder;
+
+    fft = std::make_unique<juce::dsp::FFT>(fftOrder);
+    fftData.assign((size_t)(2 << fftOrder), 0.0f);
+    envelope.assign((size_t)maxFrames, 0.0f);
+    autocorrelation.assign((size_t)maxFrames, 0.0f);
+    combScores.assign((size_t)((options.maxBPM - options.minBPM) / bpmStep) + 1, 0.0);
+    numLags = 0;
+}
+
+std::vector<TempoEstimator::Candidate> TempoEstimator::estimate(const std::vector<float>& onsetEnvelope, int maxCandidates)
+{
+    if (fft == nullptr || (int)onsetEnvelope.size() > maxFrames)
+        prepare((int)onsetEnvelope.size(), frameRate, options);
+
+    std::vector<Candidate> candidates((size_t)juce::jmax(0, maxCandidates));
+    candidates.resize((size_t)estimate(onsetEnvelope.data(), (int)onsetEnvelope.size(), candidates.data(), maxCandidates));
+    return candidates;
+}
+
+int TempoEstimator::estimate(const float* onsetEnvelope, int numFrames, Candidate* candidates, int maxCandidates) noexcept
+{
+    numLags = 0;
+
+    if (fft == nullptr || onsetEnvelope == nullptr || maxCandidates <= 0)
+        return 0;
+
+    numFrames = juce::jmin(numFrames, maxFrames);
+
+    // Mindestens zwei Perioden des langsamsten Tempos
+    const double slowestPeriod = 60.0 * frameRate / options.minBPM;
+    if (numFrames < (int)(2.0 * slowestPeriod) + 4)
+        return 0;
+
+    // === 1. Glätten, lokalen Mittelwert abziehen, einweggleichrichten ===
+    static constexpr float smoothing[] = { 1.0f / 9.0f, 2.0f / 9.0f, 3.0f / 9.0f, 2.0f / 9.0f, 1.0f / 9.0f };
+
+    for (int i = 0; i < numFrames; ++i)
+    {
+        float sum = 0.0f;
+        for (int k = -2; k <= 2; ++k)
+            sum += smoothing[k + 2] * onsetEnvelope[juce::jlimit(0, numFrames - 1, i + k)];
+
+        envelope[(size_t)i] = sum;
+    }
+
+    const int halfWindow = juce::jmax(1, juce::roundToInt(0.5 * localMeanSeconds * frameRate));
+    double windowSum = 0.0;
+    int windowStart = 0, windowEnd = 0;     // [windowStart, windowEnd)
+    double mean = 0.0;
+
+    for (int i = 0; i < numFrames; ++i)
+    {
+        const int wantedEnd = juce::jmin(numFrames, i + halfWindow + 1);
+        const int wantedStart = juce::jmax(0, i - halfWindow);
+
+        for (; windowEnd < wantedEnd; ++windowEnd)     windowSum += envelope[(size_t)windowEnd];
+        for (; windowStart < wantedStart; ++windowStart) windowSum -= envelope[(size_t)windowStart];
+
+        const float localMean = (float)(windowSum / (windowEnd - windowStart));
+        const float accent = juce::jmax(0.0f, envelope[(size_t)i] - localMean);
+
+        fftData[(size_t)i] = accent;
+        mean += accent;
+    }
+
+    mean /= numFrames;
+
+    for (int i = 0; i < numFrames; ++i)
+        fftData[(size_t)i] -= (float)mean;
+
+    std::fill(fftData.begin() + numFrames, fftData.end(), 0.0f);
+
+    // === 2. Autokorrelation über das Leistungsspektrum ===
+    const int fftSize = fft->getSize();
+    fft->performRealOnlyForwardTransform(fftData.data(), true);
+
+    for (int bin = 0; bin <= fftSize / 2; ++bin)
+    {
+        const float re = fftData[(size_t)(2 * bin)], im = fftData[(size_t)(2 * bin + 1)];
+        fftData[(size_t)(2 * bin)] = re * re + im * im;
+        fftData[(size_t)(2 * bin + 1)] = 0.0f;
+    }
+
+    // Obere Hälfte spiegeln (Leistung ist reell, also nur kopieren)
+    for (int bin = fftSize / 2 + 1; bin < fftSize; ++bin)
+    {
+        fftData[(size_t)(2 * bin)] = fftData[(size_t)(2 * (fftSize - bin))];
+        fftData[(size_t)(2 * bin + 1)] = 0.0f;
+    }
+
+    fft->performRealOnlyInverseTransform(fftData.data());
+
+    const double energy = fftData[0];
+    if (!(energy > 1.0e-12))
+        return 0;
+
+    // Erwartungstreu normiert (weniger Überlappung bei großen Lags), nur bis n/2 aussagekräftig
+    numLags = numFrames / 2;
+
+    for (int lag = 0; lag < numLags; ++lag)
+        autocorrelation[(size_t)lag] = (float)(fftData[(size_t)lag] * numFrames / ((numFrames - lag) * energy));
+
+    // === 3. Kammfilterbank über die Autokorrelation, mal Tempo-Prior ===
+    const int numSteps = juce::jmin((int)combScores.size(), (int)((options.maxBPM - options.minBPM) / bpmStep) + 1);
+
+    auto combScore = [this](double period) noexcept
+    {
+        // Halbe Periode schwach mitzählen: gerade Unterteilung wie bei 4/4 bevorzugen,
+        // sonst gewinnen bei durchgehenden Achteln auch 3/2 und 2/3 des Tempos
+        double score = 0.25 * getCorrelation(0.5 * period), weights = 0.25;
+
+        for (int tooth = 1; tooth <= numCombTeeth && tooth * period < numLags - 1; ++tooth)
+        {
+            score += getCorrelation(tooth * period) / tooth;
+            weights += 1.0 / tooth;
+        }
+
+        return weights > 0.0 ? score / weights : 0.0;
+    };
+
+    for (int step = 0; step < numSteps; ++step)
+    {
+        const double bpm = options.minBPM + step * bpmStep;
+        double prior = 1.0;
+
+        if (options.priorWidthOctaves > 0.0)
+        {
+            const double octaves = std::log2(bpm / options.preferredBPM) / options.priorWidthOctaves;
+            prior = std::exp(-0.5 * octaves * octaves);
+        }
+
+        combScores[(size_t)step] = juce::jmax(0.0, combScore(60.0 * frameRate / bpm)) * prior;
+    }
+
+    // === 4. Maxima sammeln, die besten sortiert behalten ===
+    int numCandidates = 0;
+    double totalScore = 0.0;
+
+    for (int step = 1; step + 1 < numSteps; ++step)
+    {
+        const double left = combScores[(size_t)step - 1], centre = combScores[(size_t)step], right = combScores[(size_t)step + 1];
+
+        if (!(centre > left && centre >= right && centre > 0.0))
+            continue;
+
+        totalScore += centre;
+
+        const double curvature = left - 2.0 * centre + right;
+        const double offset = curvature < 0.0 ? 0.5 * (left - right) / curvature : 0.0;
+
+        Candidate candidate;
+        candidate.bpm = options.minBPM + (step + offset) * bpmStep;
+        candidate.confidence = centre;  // vorerst Rohwert, unten in Anteil umgerechnet
+
+        int position = numCandidates;
+        while (position > 0 && candidates[position - 1].confidence < centre)
+            --position;
+
+        if (position >= maxCandidates)
+            continue;
+
+        for (int i = juce::jmin(numCandidates, maxCandidates - 1); i > position; --i)
+            candidates[i] = candidates[i - 1];
+
+        candidates[position] = candidate;
+        numCandidates = juce::jmin(numCandidates + 1, maxCandidates);
+    }
+
+    for (int i = 0; i < numCandidates; ++i)
+    {
+        auto& candidate = candidates[i];
+        const double period = refinePeriod(60.0 * frameRate / candidate.bpm);
+
+        candidate.bpm = juce::jlimit(options.minBPM, options.maxBPM, 60.0 * frameRate / period);
+        candidate.strength = juce::jlimit(0.0, 1.0, combScore(period));
+        candidate.confidence = totalScore > 0.0 ? candidate.confidence / totalScore : 0.0;
+    }
+
+    return numCandidates;
+}
+
+double TempoEstimator::getCorrelation(double lag) const noexcept
+{
+    const int index = (int)lag;
+
+    if (index < 0 || index + 1 >= numLags)
+        return 0.0;
+
+    const double fraction = lag - index;
+    return autocorrelation[(size_t)index] * (1.0 - fraction) + autocorrelation[(size_t)index + 1] * fraction;
+}
+
+double TempoEstimator::refinePeriod(double period) const noexcept
+{
+    // Der Peak bei k Schlägen liegt bei k * Periode; je größer k, desto feiner die Periode
+    double refined = period;
+
+    for (int beats = 4; ; beats *= 2)
+    {
+        const int centre = juce::roundToInt(refined * beats);
+
+        if (centre + 3 >= numLags)
+            break;
+
+        int best = -1;
+        float bestValue = minRefinementPeak;
+
+        for (int lag = juce::jmax(1, centre - 2); lag <= centre + 2; ++lag)
+        {
+            const float value = autocorrelation[(size_t)lag];
+
+            if (value > bestValue && value >= autocorrelation[(size_t)lag - 1] && value >= autocorrelation[(size_t)lag + 1])
+            {
+                best = lag;
+                bestValue = value;
+            }
+        }
+
+        // Kein klarer Peak mehr (Tempo schwankt oder Breaks): bei der letzten Schätzung bleiben
+        if (best < 0)
+            break;
+
+        const double left = autocorrelation[(size_t)best - 1], right = autocorrelation[(size_t)best + 1];
+        const double curvature = left - 2.0 * bestValue + right;
+        const double offset = curvature < 0.0 ? 0.5 * (left - right) / curvature : 0.0;
+
+        refined = (best + offset) / beats;
+    }
+
+    return refined;
+}
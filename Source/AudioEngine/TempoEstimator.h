@@ -0,0 +1,95 @@
+/*
+  ==============================================================================
+
+    TempoEstimator.h
+    Created: 16 Oct 2026
+
+    Tempo from an onset envelope (see OnsetDetector):
+
+      1. The envelope is smoothed, its local mean (~0.5 s) removed and
+         half-wave rectified, so only the accents above the running level
+         remain, then made zero-mean.
+      2. Autocorrelation via the JUCE FFT (zero-padded to avoid wrap-around),
+         normalised to 1 at lag 0: O(n log n) for the whole envelope instead
+         of one pass per lag.
+      3. A comb-filter bank over the autocorrelation: for every tempo on a
+         0.1 BPM grid the correlation at the beat period and its first
+         multiples is summed (weights 1, 1/2, 1/3, 1/4), plus the half
+         period (weight 1/4) so duple metres beat 3:2 relatives, times a
+         log-normal tempo prior that settles octave ambiguity towards
+         ~120 BPM.
+      4. The peaks of that curve are the candidates. Each is refined on
+         the autocorrelation peaks at 4, 8, 16 ... beats, which gives a
+         tempo to a few hundredths of a BPM on steady material.
+
+    Each candidate carries its comb score ("strength", how strongly the
+    onsets repeat at that period, 0..1) and a confidence: its share of all
+    candidate scores. Octave pairs therefore split the confidence; a clear
+    single tempo gets close to 1.
+
+    prepare() allocates for a maximum envelope length; estimate() does not
+    allocate.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <memory>
+#include <vector>
+
+class TempoEstimator
+{
+public:
+    struct Options
+    {
+        double minBPM = 60.0;
+        double maxBPM = 200.0;
+        double preferredBPM = 120.0;    // Mitte des Tempo-Priors
+        double priorWidthOctaves = 1.0; // Standardabweichung des Priors, 0 = aus
+    };
+
+    struct Candidate
+    {
+        double bpm = 0.0;
+        double strength = 0.0;
+        double confidence = 0.0;
+    };
+
+    TempoEstimator() = default;
+
+    /** Allocates for envelopes up to maxFrames frames. Not real-time safe. */
+    void prepare(int maxFrames, double frameRate, const Options& newOptions);
+    void prepare(int maxFrames, double frameRate) { prepare(maxFrames, frameRate, Options()); }
+
+    int getMaxFrames() const noexcept { return maxFrames; }
+    double getFrameRate() const noexcept { return frameRate; }
+
+    /**
+        Writes up to maxCandidates tempo candidates, best first, and returns
+        how many were found (0 if the envelope is too short or has no
+        periodicity). numFrames is clamped to the prepared maximum.
+    */
+    int estimate(const float* onsetEnvelope, int numFrames, Candidate* candidates, int maxCandidates) noexcept;
+
+    /** Convenience for the analysis threads, allocates. */
+    std::vector<Candidate> estimate(const std::vector<float>& onsetEnvelope, int maxCandidates = 5);
+
+private:
+    double getCorrelation(double lag) const noexcept;
+    double refinePeriod(double period) const noexcept;
+
+    Options options;
+    double frameRate = 86.0;
+    int maxFrames = 0;
+    int numLags = 0;
+
+    std::unique_ptr<juce::dsp::FFT> fft;
+    std::vector<float> fftData;         // 2 * fftSize, Arbeitsspeicher der FFT
+    std::vector<float> envelope;
+    std::vector<float> autocorrelation; // normiert, Index = Lag in Frames
+    std::vector<double> combScores;     // je BPM-Schritt
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TempoEstimator)
+};
@@ -0,0 +1,364 @@
+/*
+  ==============================================================================
+
+    TimeStretcher.cpp
+    Created: 16 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "TimeStretcher.h"
+#include "Sampler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+    constexpr float vocoderOverlapGain = 1.0f / 1.5f;  // Summe von Hann^2 bei 4-facher Überlappung
+
+    void fillPeriodicHann(std::vector<float>& window, int size)
+    {
+        window.resize((size_t)size);
+
+        for (int i = 0; i < size; ++i)
+            window[(size_t)i] = 0.5f - 0.5f * std::cos(juce::MathConstants<float>::twoPi * (float)i / (float)size);
+    }
+
+    // Die reellen JUCE-Transformationen liefern nur die Bins 0..size/2, für die
+    // Rücktransformation wird die obere Hälfte konjugiert gespiegelt
+    void mirrorSpectrum(float* interleaved, int size) noexcept
+    {
+        for (int bin = size / 2 + 1; bin < size; ++bin)
+        {
+            interleaved[2 * bin] = interleaved[2 * (size - bin)];
+            interleaved[2 * bin + 1] = -interleaved[2 * (size - bin) + 1];
+        }
+    }
+
+    inline float wrapPhase(float phase) noexcept
+    {
+        return phase - juce::MathConstants<float>::twoPi
+                     * std::floor((phase + juce::MathConstants<float>::pi) / juce::MathConstants<float>::twoPi);
+    }
+}
+
+juce::String TimeStretcher::getModeName(Mode m)
+{
+    switch (m)
+    {
+    case Mode::WSOLA:        return "WSOLA";
+    case Mode::PhaseVocoder: return "Phase Vocoder";
+    }
+
+    return {};
+}
+
+void TimeStretcher::prepare()
+{
+    input.setSize(2, inputCapacity);
+    overlapAdd.setSize(2, maxFrameSize);
+    ready.setSize(2, hopSize);
+
+    const int wsolaFftSize = 1 << wsolaFftOrder;
+    fillPeriodicHann(wsolaWindow, wsolaFrameSize);
+    templateSpectrum.assign((size_t)(2 * wsolaFftSize), 0.0f);
+    searchSpectrum.assign((size_t)(2 * wsolaFftSize), 0.0f);
+    energyPrefix.assign((size_t)(wsolaFftSize + 1), 0.0);
+    wsolaFft = std::make_unique<juce::dsp::FFT>(wsolaFftOrder);
+
+    fillPeriodicHann(vocoderWindow, vocoderFrameSize);
+    vocoderSpectrum.assign((size_t)(2 * vocoderFrameSize), 0.0f);
+    for (auto* phases : { &analysisPhase, &synthesisPhase })
+        for (auto& channel : *phases)
+            channel.assign((size_t)(vocoderFrameSize / 2 + 1), 0.0f);
+    vocoderFft = std::make_unique<juce::dsp::FFT>(vocoderFftOrder);
+
+    prepared = true;
+    reset();
+}
+
+void TimeStretcher::reset() noexcept
+{
+    resetState();
+    active = false;
+}
+
+void TimeStretcher::resetState() noexcept
+{
+    if (!prepared)
+        return;
+
+    // Vor dem Startpunkt liegt Stille, damit die WSOLA-Suche auch beim ersten Frame Platz hat
+    input.clear();
+    inputStart = -wsolaSearchRadius;
+    inputFilled = wsolaSearchRadius;
+    expectedSourcePosition = -1;
+
+    overlapAdd.clear();
+    readyPosition = 0;
+    readyCount = 0;
+
+    nominalPosition = 0.0;
+    previousFramePosition = -1;
+    vocoderPrimed = false;
+}
+
+void TimeStretcher::process(Sampler& source, float* outL, float* outR, int numSamples, double tempo, float gain) noexcept
+{
+    if (!prepared || numSamples <= 0)
+        return;
+
+    const Mode newMode = requestedMode.load();
+    if (!active || newMode != mode)
+    {
+        mode = newMode;
+        resetState();
+        active = true;
+    }
+
+    // Gestoppt, oder die Position wurde von außen verändert (Seek, Cue): neu aufsetzen
+    if (!source.isPlaying() || tempo < 0.05
+        || (expectedSourcePosition >= 0 && source.getCurrentPosition() != expectedSourcePosition))
+    {
+        resetState();
+        juce::FloatVectorOperations::clear(outL, numSamples);
+        juce::FloatVectorOperations::clear(outR, numSamples);
+
+        if (!source.isPlaying() || tempo < 0.05)
+            return;
+    }
+
+    const double clampedTempo = juce::jlimit(minTempo, maxTempo, tempo);
+    int written = 0;
+
+    while (written < numSamples)
+    {
+        if (readyPosition >= readyCount)
+            produceHop(source, clampedTempo);
+
+        const int count = juce::jmin(numSamples - written, readyCount - readyPosition);
+
+        juce::FloatVectorOperations::multiply(outL + written, ready.getReadPointer(0, readyPosition), gain, count);
+        juce::FloatVectorOperations::multiply(outR + written, ready.getReadPointer(1, readyPosition), gain, count);
+
+        written += count;
+        readyPosition += count;
+    }
+}
+
+void TimeStretcher::produceHop(Sampler& source, double tempo) noexcept
+{
+    const int frameSize = mode == Mode::WSOLA ? wsolaFrameSize : vocoderFrameSize;
+    const long nominal = (long)std::floor(nominalPosition + 0.5);
+    long framePosition = nominal;
+
+    if (mode == Mode::WSOLA)
+    {
+        ensureInput(source, nominal + wsolaSearchRadius + frameSize);
+        framePosition = findWsolaSplice(nominal);
+        produceWsolaFrame(framePosition);
+    }
+    else
+    {
+        ensureInput(source, nominal + frameSize);
+        produceVocoderFrame(framePosition, previousFramePosition >= 0 ? framePosition - previousFramePosition : 0);
+    }
+
+    previousFramePosition = framePosition;
+    nominalPosition += hopSize * tempo;
+
+    // Was weder die nächste Suche noch die nächste Vorlage braucht, kann weg
+    const long nextNominal = (long)std::floor(nominalPosition + 0.5);
+    if (mode == Mode::WSOLA)
+        discardInputBefore(juce::jmin(framePosition + hopSize, nextNominal - wsolaSearchRadius));
+    else
+        discardInputBefore(nextNominal);
+
+    // Die ersten hopSize Samples sind fertig überlagert
+    for (int channel = 0; channel < 2; ++channel)
+    {
+        float* accumulator = overlapAdd.getWritePointer(channel);
+
+        ready.copyFrom(channel, 0, accumulator, hopSize);
+        std::memmove(accumulator, accumulator + hopSize, sizeof(float) * (size_t)(frameSize - hopSize));
+        juce::FloatVectorOperations::clear(accumulator + frameSize - hopSize, hopSize);
+    }
+
+    readyPosition = 0;
+    readyCount = hopSize;
+}
+
+void TimeStretcher::ensureInput(Sampler& source, long to) noexcept
+{
+    const long available = inputStart + inputFilled;
+    if (to <= available)
+        return;
+
+    const int count = (int)juce::jmin(to - available, (long)(inputCapacity - inputFilled));
+    jassert(count == to - available);
+
+    // Die Quelle läuft immer mit Rate 1, die Lautstärke kommt erst am Ausgang dazu
+    source.renderBlock(input.getWritePointer(0, inputFilled), input.getWritePointer(1, inputFilled), count, 1.0, 1.0f);
+    inputFilled += count;
+    expectedSourcePosition = source.getCurrentPosition();
+}
+
+void TimeStretcher::discardInputBefore(long position) noexcept
+{
+    const int drop = (int)juce::jlimit(0L, (long)inputFilled, position - inputStart);
+    if (drop == 0)
+        return;
+
+    for (int channel = 0; channel < 2; ++channel)
+    {
+        float* data = input.getWritePointer(channel);
+        std::memmove(data, data + drop, sizeof(float) * (size_t)(inputFilled - drop));
+    }
+
+    inputFilled -= drop;
+    inputStart += drop;
+}
+
+const float* TimeStretcher::inputAt(int channel, long absolutePosition) const noexcept
+{
+    jassert(absolutePosition >= inputStart);
+    return input.getReadPointer(channel) + (absolutePosition - inputStart);
+}
+
+long TimeStretcher::findWsolaSplice(long nominal) noexcept
+{
+    if (previousFramePosition < 0)
+        return nominal;
+
+    const int fftSize = 1 << wsolaFftOrder;
+    const int overlap = wsolaFrameSize - hopSize;
+    const int searchLength = overlap + 2 * wsolaSearchRadius;
+
+    // Vorlage: natürliche Fortsetzung des letzten Frames, Mono, nur der überlappende Teil
+    const long templateStart = previousFramePosition + hopSize;
+    const float* templateL = inputAt(0, templateStart);
+    const float* templateR = inputAt(1, templateStart);
+
+    std::fill(templateSpectrum.begin(), templateSpectrum.end(), 0.0f);
+    for (int i = 0; i < overlap; ++i)
+        templateSpectrum[(size_t)i] = 0.5f * (templateL[i] + templateR[i]);
+
+    const long searchStart = nominal - wsolaSearchRadius;
+    const float* searchL = inputAt(0, searchStart);
+    const float* searchR = inputAt(1, searchStart);
+
+    std::fill(searchSpectrum.begin(), searchSpectrum.end(), 0.0f);
+    energyPrefix[0] = 0.0;
+    for (int i = 0; i < searchLength; ++i)
+    {
+        const float mono = 0.5f * (searchL[i] + searchR[i]);
+        searchSpectrum[(size_t)i] = mono;
+        energyPrefix[(size_t)i + 1] = energyPrefix[(size_t)i] + (double)mono * mono;
+    }
+
+    // Kreuzkorrelation im Frequenzbereich: S * conj(T)
+    wsolaFft->performRealOnlyForwardTransform(templateSpectrum.data(), true);
+    wsolaFft->performRealOnlyForwardTransform(searchSpectrum.data(), true);
+
+    for (int bin = 0; bin <= fftSize / 2; ++bin)
+    {
+        const float sr = searchSpectrum[(size_t)(2 * bin)], si = searchSpectrum[(size_t)(2 * bin + 1)];
+        const float tr = templateSpectrum[(size_t)(2 * bin)], ti = templateSpectrum[(size_t)(2 * bin + 1)];
+
+        searchSpectrum[(size_t)(2 * bin)] = sr * tr + si * ti;
+        searchSpectrum[(size_t)(2 * bin + 1)] = si * tr - sr * ti;
+    }
+
+    mirrorSpectrum(searchSpectrum.data(), fftSize);
+    wsolaFft->performRealOnlyInverseTransform(searchSpectrum.data());
+
+    // Nach der Energie des jeweiligen Kandidaten normieren, bei Gleichstand gewinnt die Soll-Position
+    auto score = [this, overlap](int offset) noexcept
+    {
+        const double energy = energyPrefix[(size_t)(offset + overlap)] - energyPrefix[(size_t)offset];
+        return (double)searchSpectrum[(size_t)offset] / std::sqrt(energy + 1.0e-9);
+    };
+
+    int bestOffset = wsolaSearchRadius;
+    double bestScore = score(bestOffset);
+
+    for (int offset = 0; offset <= 2 * wsolaSearchRadius; ++offset)
+    {
+        const double candidate = score(offset);
+        if (candidate > bestScore)
+        {
+            bestScore = candidate;
+            bestOffset = offset;
+        }
+    }
+
+    return searchStart + bestOffset;
+}
+
+void TimeStretcher::produceWsolaFrame(long framePosition) noexcept
+{
+    for (int channel = 0; channel < 2; ++channel)
+    {
+        const float* source = inputAt(channel, framePosition);
+        float* accumulator = overlapAdd.getWritePointer(channel);
+
+        for (int i = 0; i < wsolaFrameSize; ++i)
+            accumulator[i] += source[i] * wsolaWindow[(size_t)i];
+    }
+}
+
+void TimeStretcher::produceVocoderFrame(long framePosition, long analysisHop) noexcept
+{
+    const int numBins = vocoderFrameSize / 2 + 1;
+    const float binFrequency = juce::MathConstants<float>::twoPi / (float)vocoderFrameSize;
+    const bool propagate = vocoderPrimed && analysisHop > 0;
+
+    for (int channel = 0; channel < 2; ++channel)
+    {
+        const float* source = inputAt(channel, framePosition);
+        float* spectrum = vocoderSpectrum.data();
+        auto& previousPhase = analysisPhase[(size_t)channel];
+        auto& outputPhase = synthesisPhase[(size_t)channel];
+
+        juce::FloatVectorOperations::multiply(spectrum, source, vocoderWindow.data(), vocoderFrameSize);
+        juce::FloatVectorOperations::clear(spectrum + vocoderFrameSize, vocoderFrameSize);
+        vocoderFft->performRealOnlyForwardTransform(spectrum, true);
+
+        for (int bin = 0; bin < numBins; ++bin)
+        {
+            const float re = spectrum[2 * bin];
+            const float im = spectrum[2 * bin + 1];
+            const float magnitude = std::sqrt(re * re + im * im);
+            const float phase = std::atan2(im, re);
+
+            if (propagate)
+            {
+                // Abweichung von der Bin-Mittenfrequenz ergibt die tatsächliche Frequenz
+                const float omega = binFrequency * (float)bin;
+                const float deviation = wrapPhase(phase - previousPhase[(size_t)bin] - omega * (float)analysisHop);
+                const float frequency = omega + deviation / (float)analysisHop;
+
+                outputPhase[(size_t)bin] = wrapPhase(outputPhase[(size_t)bin] + frequency * (float)hopSize);
+            }
+            else
+            {
+                outputPhase[(size_t)bin] = phase;
+            }
+
+            previousPhase[(size_t)bin] = phase;
+
+            spectrum[2 * bin] = magnitude * std::cos(outputPhase[(size_t)bin]);
+            spectrum[2 * bin + 1] = magnitude * std::sin(outputPhase[(size_t)bin]);
+        }
+
+        mirrorSpectrum(spectrum, vocoderFrameSize);
+        vocoderFft->performRealOnlyInverseTransform(spectrum);
+
+        float* accumulator = overlapAdd.getWritePointer(channel);
+        for (int i = 0; i < vocoderFrameSize; ++i)
+            accumulator[i] += spectrum[i] * vocoderWindow[(size_t)i] * vocoderOverlapGain;
+    }
+
+    vocoderPrimed = true;
+}
@@ -0,0 +1,132 @@
+/*
+  ==============================================================================
+
+    TimeStretcher.h
+    Created: 16 Oct 2026
+
+    Key-lock for one deck: changes tempo without changing pitch. Sits between
+    the Sampler and the mix bus and pulls source audio at rate 1 through
+    Sampler::renderBlock().
+
+    Two algorithms:
+
+      WSOLA          1024-sample Hann frames, 512 hop, +-256 sample search.
+                     The best splice point is found by cross-correlating the
+                     natural continuation of the previous frame with the
+                     search region via the JUCE FFT (3 transforms of 1024 per
+                     hop). Keeps transients tight; default.
+      PhaseVocoder   2048-sample frames, 512 hop, per-bin phase propagation
+                     (2 transforms of 2048 plus one atan2 / sincos per bin
+                     and channel per hop). Smoother on pads, smears drums.
+
+    Work happens in whole hops of 512 output frames, so the cost per callback
+    is bounded by ceil(blockSize / 512) hops no matter what the tempo is; at
+    64-sample buffers at most one hop lands in a callback. Everything is
+    allocated in prepare().
+
+    The deck reads about one frame ahead of what is heard, so the displayed
+    position leads the audio by roughly 20 ms while key-lock is active.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+class Sampler;
+
+class TimeStretcher
+{
+public:
+    enum class Mode
+    {
+        WSOLA = 0,
+        PhaseVocoder
+    };
+
+    TimeStretcher() = default;
+
+    /** Allocates every buffer. Not real-time safe. */
+    void prepare();
+
+    /** Drops all buffered audio, e.g. after a seek or when key-lock is switched on. */
+    void reset() noexcept;
+
+    /** Can be called from any thread, takes effect (with a reset) on the next process(). */
+    void setMode(Mode newMode) noexcept { requestedMode = newMode; }
+    Mode getMode() const noexcept { return requestedMode.load(); }
+
+    static juce::String getModeName(Mode mode);
+
+    /**
+        Audio thread. Renders numSamples frames of source played at the given
+        tempo (1.0 = original) with unchanged pitch, scaled by gain.
+    */
+    void process(Sampler& source, float* outL, float* outR, int numSamples, double tempo, float gain) noexcept;
+
+    bool isActive() const noexcept { return active; }
+
+private:
+    static constexpr int wsolaFrameSize = 1024;
+    static constexpr int wsolaSearchRadius = 256;
+    static constexpr int wsolaFftOrder = 10;            // 1024 >= overlap + 2 * searchRadius
+    static constexpr int vocoderFrameSize = 2048;
+    static constexpr int vocoderFftOrder = 11;
+    static constexpr int hopSize = 512;
+    static constexpr int maxFrameSize = vocoderFrameSize;
+    static constexpr int inputCapacity = 3 * maxFrameSize;
+    static constexpr double minTempo = 0.25;
+    static constexpr double maxTempo = 2.0;
+
+    void resetState() noexcept;
+    void produceHop(Sampler& source, double tempo) noexcept;
+    void produceWsolaFrame(long framePosition) noexcept;
+    void produceVocoderFrame(long framePosition, long analysisHop) noexcept;
+    long findWsolaSplice(long nominalPosition) noexcept;
+    void ensureInput(Sampler& source, long to) noexcept;
+    void discardInputBefore(long position) noexcept;
+
+    const float* inputAt(int channel, long absolutePosition) const noexcept;
+
+    // Eingang: lineares Fenster auf den Quellstrom, absoluter Index des ersten Samples in inputStart
+    juce::AudioBuffer<float> input;
+    long inputStart = 0;
+    int inputFilled = 0;
+    long expectedSourcePosition = -1;
+
+    // Overlap-Add Akkumulator und fertige Ausgabe eines Hops
+    juce::AudioBuffer<float> overlapAdd;
+    juce::AudioBuffer<float> ready;
+    int readyPosition = 0;
+    int readyCount = 0;
+
+    double nominalPosition = 0.0;       // Soll-Analyseposition des nächsten Frames
+    long previousFramePosition = -1;    // tatsächlich verwendete Position des letzten Frames
+
+    // WSOLA
+    std::vector<float> wsolaWindow;
+    std::vector<float> templateSpectrum;
+    std::vector<float> searchSpectrum;
+    std::vector<double> energyPrefix;
+    std::unique_ptr<juce::dsp::FFT> wsolaFft;
+
+    // Phase Vocoder
+    std::vector<float> vocoderWindow;
+    std::vector<float> vocoderSpectrum;
+    std::array<std::vector<float>, 2> analysisPhase;
+    std::array<std::vector<float>, 2> synthesisPhase;
+    bool vocoderPrimed = false;
+    std::unique_ptr<juce::dsp::FFT> vocoderFft;
+
+    std::atomic<Mode> requestedMode { Mode::WSOLA };
+    Mode mode = Mode::WSOLA;
+    bool prepared = false;
+    bool active = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TimeStretcher)
+};
@@ -0,0 +1,676 @@
+/*
+  ==============================================================================
+
+    TrackDatabase.cpp
+    Created: 16 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "TrackDatabase.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    constexpr juce::uint32 dataMagic = 0x42445242;      // "RBDB"
+    constexpr juce::uint32 indexMagic = 0x58494252;     // "RBIX"
+    constexpr juce::uint32 recordMagic = 0x314b5254;    // "TRK1"
+    constexpr juce::uint32 formatVersion = 2;
+
+    constexpr int dataHeaderSize = 16;
+    constexpr int indexHeaderSize = 32;
+    constexpr int indexEntrySize = 24;
+    constexpr int segmentSize = 24;
+    constexpr size_t maxPendingRecords = 32;
+    constexpr size_t minWaveformLevelPoints = 64;
+    constexpr juce::int64 minCompactionGarbage = 1024 * 1024;
+
+    // Wellenform als int8, -127 .. 127
+    char quantise(float value) noexcept
+    {
+        return (char)juce::jlimit(-127, 127, juce::roundToInt(value * 127.0f));
+    }
+
+    float dequantise(char value) noexcept
+    {
+        return (float)(signed char)value / 127.0f;
+    }
+
+    juce::MemoryBlock serialise(const juce::String& path, juce::int64 fileSize, juce::int64 modificationTime,
+                                const TrackDatabase::Record& record)
+    {
+        juce::MemoryOutputStream out;
+        const auto pathBytes = path.toUTF8();
+        const auto numPathBytes = (int)pathBytes.sizeInBytes() - 1;
+
+        out.writeInt((int)recordMagic);
+        out.writeInt(0);    // Größe, unten eingetragen
+        out.writeInt64(fileSize);
+        out.writeInt64(modificationTime);
+        out.writeDouble(record.duration);
+        out.writeDouble(record.sampleRate);
+        out.writeDouble(record.bpm);
+        out.writeDouble(record.bpmConfidence);
+        out.writeDouble(record.loudness);
+        out.writeFloat(record.peak);
+        out.writeInt(record.beatGrid.beatsPerBar);
+        out.writeInt(record.beatGrid.firstDownbeat);
+        out.writeInt((int)record.beatGrid.segments.size());
+        out.writeInt((int)record.waveform.size());
+        out.writeInt(numPathBytes);
+        out.write(pathBytes.getAddress(), (size_t)numPathBytes);
+
+        for (const auto& segment : record.beatGrid.segments)
+        {
+            out.writeDouble(segment.startTime);
+            out.writeDouble(segment.beatLength);
+            out.writeInt(segment.firstBeat);
+            out.writeInt(segment.numBeats);
+        }
+
+        for (const auto& level : record.waveform)
+        {
+            const auto numPoints = juce::jmin(level.minSamples.size(), level.maxSamples.size());
+            out.writeInt((int)numPoints);
+
+            for (size_t i = 0; i < numPoints; ++i)
+            {
+                out.writeByte(quantise(level.minSamples[i]));
+                out.writeByte(quantise(level.maxSamples[i]));
+            }
+        }
+
+        // Auf 8 Bytes auffüllen, damit die Datensätze ausgerichtet bleiben
+        while (out.getDataSize() % 8 != 0)
+            out.writeByte(0);
+
+        juce::MemoryBlock block(out.getData(), out.getDataSize());
+        const auto size = (juce::uint32)block.getSize();
+        block[4] = (char)(size & 0xff);
+        block[5] = (char)((size >> 8) & 0xff);
+        block[6] = (char)((size >> 16) & 0xff);
+        block[7] = (char)((size >> 24) & 0xff);
+
+        return block;
+    }
+
+    bool writeDataHeader(juce::FileOutputStream& out, juce::uint64 generation)
+    {
+        out.writeInt((int)dataMagic);
+        out.writeInt((int)formatVersion);
+        out.writeInt64((juce::int64)generation);
+        return !out.getStatus().failed();
+    }
+
+    bool readFileState(const juce::File& file, juce::int64& fileSize, juce::int64& modificationTime)
+    {
+        if (!file.existsAsFile())
+            return false;
+
+        fileSize = file.getSize();
+        modificationTime = file.getLastModificationTime().toMilliseconds();
+        return true;
+    }
+}
+
+//==============================================================================
+std::vector<TrackDatabase::WaveformLevel> TrackDatabase::Record::buildWaveformLevels(const std::vector<float>& minSamples,
+                                                                                      const std::vector<float>& maxSamples)
+{
+    std::vector<WaveformLevel> levels;
+    const auto numPoints = juce::jmin(minSamples.size(), maxSamples.size());
+
+    if (numPoints == 0)
+        return levels;
+
+    levels.push_back({ std::vector<float>(minSamples.begin(), minSamples.begin() + (std::ptrdiff_t)numPoints),
+                       std::vector<float>(maxSamples.begin(), maxSamples.begin() + (std::ptrdiff_t)numPoints) });
+
+    while (levels.back().minSamples.size() / 2 >= minWaveformLevelPoints)
+    {
+        const auto& finer = levels.back();
+        WaveformLevel coarser;
+        const auto numCoarse = finer.minSamples.size() / 2;
+        coarser.minSamples.resize(numCoarse);
+        coarser.maxSamples.resize(numCoarse);
+
+        for (size_t i = 0; i < numCoarse; ++i)
+        {
+            coarser.minSamples[i] = juce::jmin(finer.minSamples[2 * i], finer.minSamples[2 * i + 1]);
+            coarser.maxSamples[i] = juce::jmax(finer.maxSamples[2 * i], finer.maxSamples[2 * i + 1]);
+        }
+
+        levels.push_back(std::move(coarser));
+    }
+
+    return levels;
+}
+
+//==============================================================================
+TrackDatabase& TrackDatabase::getInstance()
+{
+    static TrackDatabase database(juce::File::getSpecialLocation(juce::File::userHomeDirectory).getChildFile(".RadioBlast/library"));
+    return database;
+}
+
+TrackDatabase::TrackDatabase(const juce::File& newDirectory)
+    : directory(newDirectory),
+      indexFile(newDirectory.getChildFile("tracks.idx"))
+{
+    open();
+}
+
+TrackDatabase::~TrackDatabase()
+{
+    flush();
+}
+
+juce::uint64 TrackDatabase::getKey(const juce::String& path) noexcept
+{
+    return (juce::uint64)path.hashCode64();
+}
+
+juce::File TrackDatabase::getDataFile(juce::uint64 generation) const
+{
+    return directory.getChildFile("tracks-" + juce::String(generation) + ".dat");
+}
+
+void TrackDatabase::open()
+{
+    // Nur aus dem Konstruktor, noch kein anderer Thread
+    if (!directory.createDirectory())
+        return;
+
+    // Der Index nennt die Generation der Datendatei, zu der er gehört
+    {
+        juce::FileInputStream in(indexFile);
+
+        if (in.openedOk() && in.getTotalLength() >= indexHeaderSize)
+        {
+            in.setPosition(24);
+            dataGeneration = (juce::uint64)in.readInt64();
+        }
+    }
+
+    dataFile = getDataFile(dataGeneration);
+    mapFiles();
+
+    // Index und Daten passen nicht zusammen (andere Version, abgebrochener Schreibvorgang): neu anfangen
+    const bool dataValid = mappedData != nullptr
+        && mappedData->getSize() >= (size_t)dataHeaderSize
+        && juce::ByteOrder::littleEndianInt(mappedData->getData()) == dataMagic
+        && juce::ByteOrder::littleEndianInt(juce::addBytesToPointer(mappedData->getData(), 4)) == formatVersion
+        && juce::ByteOrder::littleEndianInt64(juce::addBytesToPointer(mappedData->getData(), 8)) == dataGeneration;
+
+    bool indexValid = false;
+
+    if (dataValid && mappedIndex != nullptr)
+    {
+        auto* header = mappedIndex->getData();
+        const auto count = juce::ByteOrder::littleEndianInt64(juce::addBytesToPointer(header, 8));
+        const auto coveredDataSize = juce::ByteOrder::littleEndianInt64(juce::addBytesToPointer(header, 16));
+
+        indexValid = juce::ByteOrder::littleEndianInt(header) == indexMagic
+            && juce::ByteOrder::littleEndianInt(juce::addBytesToPointer(header, 4)) == formatVersion
+            && mappedIndex->getSize() == (size_t)indexHeaderSize + (size_t)count * (size_t)indexEntrySize
+            && coveredDataSize <= (juce::uint64)dataFile.getSize();
+    }
+
+    if (!indexValid)
+    {
+        mappedIndex.reset();
+        mappedData.reset();
+
+        indexFile.deleteFile();
+        dataFile.deleteFile();
+
+        dataGeneration = 1;
+        dataFile = getDataFile(dataGeneration);
+        dataFile.deleteFile();
+
+        {
+            juce::FileOutputStream out(dataFile);
+
+            if (!out.openedOk() || !writeDataHeader(out, dataGeneration))
+                return;
+        }
+
+        if (!writeIndex({}, dataHeaderSize, dataGeneration))
+            return;
+
+        mapFiles();
+
+        if (mappedIndex == nullptr)
+            return;
+    }
+
+    // Reste einer abgebrochenen Kompaktierung (oder eines älteren Formats) gehören zu keinem Index
+    for (const auto& file : directory.findChildFiles(juce::File::findFiles, false, "tracks*.dat"))
+        if (file != dataFile)
+            file.deleteFile();
+
+    // Alles hinter dem Ende, das der Index kennt, hat ihn nie erreicht (Absturz vor flush)
+    const auto coveredDataSize = (juce::int64)juce::ByteOrder::littleEndianInt64(juce::addBytesToPointer(mappedIndex->getData(), 16));
+
+    if (dataFile.getSize() > coveredDataSize)
+    {
+        mappedData.reset();
+
+        {
+            juce::FileOutputStream out(dataFile);
+
+            if (out.openedOk() && out.setPosition(coveredDataSize))
+                out.truncate();
+        }
+
+        mapFiles();
+    }
+
+    dataOut = std::make_unique<juce::FileOutputStream>(dataFile);
+
+    if (!dataOut->openedOk())
+        dataOut.reset();
+
+    juce::int64 liveBytes = 0;
+    for (size_t i = 0; i < numEntries; ++i)
+        liveBytes += readEntry(i).size;
+
+    const auto garbage = dataFile.getSize() - dataHeaderSize - liveBytes;
+
+    if (garbage > liveBytes && garbage > minCompactionGarbage)
+        compact();
+}
+
+void TrackDatabase::mapFiles()
+{
+    mappedIndex.reset();
+    mappedData.reset();
+    indexEntries = nullptr;
+    numEntries = 0;
+
+    if (indexFile.existsAsFile())
+    {
+        mappedIndex = std::make_unique<juce::MemoryMappedFile>(indexFile, juce::MemoryMappedFile::readOnly);
+
+        if (mappedIndex->getData() == nullptr || mappedIndex->getSize() < (size_t)indexHeaderSize)
+        {
+            mappedIndex.reset();
+        }
+        else
+        {
+            indexEntries = static_cast<const char*>(mappedIndex->getData()) + indexHeaderSize;
+            numEntries = (mappedIndex->getSize() - (size_t)indexHeaderSize) / (size_t)indexEntrySize;
+        }
+    }
+
+    if (dataFile.existsAsFile())
+    {
+        mappedData = std::make_unique<juce::MemoryMappedFile>(dataFile, juce::MemoryMappedFile::readOnly);
+
+        if (mappedData->getData() == nullptr)
+            mappedData.reset();
+    }
+}
+
+bool TrackDatabase::writeIndex(const std::vector<IndexEntry>& newEntries, juce::int64 dataSize, juce::uint64 generation)
+{
+    juce::TemporaryFile temp(indexFile);
+
+    {
+        juce::FileOutputStream out(temp.getFile());
+
+        if (!out.openedOk())
+            return false;
+
+        out.writeInt((int)indexMagic);
+        out.writeInt((int)formatVersion);
+        out.writeInt64((juce::int64)newEntries.size());
+        out.writeInt64(dataSize);
+        out.writeInt64((juce::int64)generation);
+
+        for (const auto& entry : newEntries)
+        {
+            out.writeInt64((juce::int64)entry.key);
+            out.writeInt64((juce::int64)entry.offset);
+            out.writeInt((int)entry.size);
+            out.writeInt(0);
+        }
+
+        out.flush();
+
+        if (out.getStatus().failed())
+            return false;
+    }
+
+    // Vorher die alte Abbildung lösen, sonst lässt sich die Datei unter Windows nicht ersetzen
+    mappedIndex.reset();
+    indexEntries = nullptr;
+    numEntries = 0;
+
+    return temp.overwriteTargetFileWithTemporary();
+}
+
+//==============================================================================
+TrackDatabase::IndexEntry TrackDatabase::readEntry(size_t index) const noexcept
+{
+    // Feldweise little-endian lesen, nicht als Struct: die Datei ist auf jeder Plattform dieselbe
+    const auto* bytes = indexEntries + index * (size_t)indexEntrySize;
+
+    return { juce::ByteOrder::littleEndianInt64(bytes),
+             juce::ByteOrder::littleEndianInt64(bytes + 8),
+             juce::ByteOrder::littleEndianInt(bytes + 16),
+             0 };
+}
+
+std::vector<TrackDatabase::IndexEntry> TrackDatabase::readEntries() const
+{
+    std::vector<IndexEntry> result;
+    result.reserve(numEntries);
+
+    for (size_t i = 0; i < numEntries; ++i)
+        result.push_back(readEntry(i));
+
+    return result;
+}
+
+bool TrackDatabase::findEntry(juce::uint64 key, IndexEntry& entry) const noexcept
+{
+    if (indexEntries == nullptr)
+        return false;
+
+    size_t first = 0, last = numEntries;
+
+    while (first < last)
+    {
+        const auto middle = first + (last - first) / 2;
+
+        if (juce::ByteOrder::littleEndianInt64(indexEntries + middle * (size_t)indexEntrySize) < key)
+            first = middle + 1;
+        else
+            last = middle;
+    }
+
+    if (first == numEntries)
+        return false;
+
+    entry = readEntry(first);
+    return entry.key == key;
+}
+
+bool TrackDatabase::parseRecord(const IndexEntry& entry, const juce::String& path, juce::int64 fileSize,
+                                juce::int64 modificationTime, Record& record, bool withWaveform) const
+{
+    if (mappedData == nullptr || entry.offset + entry.size > mappedData->getSize())
+        return false;
+
+    juce::MemoryInputStream in(juce::addBytesToPointer(mappedData->getData(), entry.offset), entry.size, false);
+
+    if ((juce::uint32)in.readInt() != recordMagic || (juce::uint32)in.readInt() != entry.size)
+        return false;
+
+    // Datei seitdem geändert: Datensatz gilt nicht mehr
+    if (in.readInt64() != fileSize || in.readInt64() != modificationTime)
+        return false;
+
+    Record result;
+    result.duration = in.readDouble();
+    result.sampleRate = in.readDouble();
+    result.bpm = in.readDouble();
+    result.bpmConfidence = in.readDouble();
+    result.loudness = in.readDouble();
+    result.peak = in.readFloat();
+    result.beatGrid.beatsPerBar = in.readInt();
+    result.beatGrid.firstDownbeat = in.readInt();
+
+    const int numSegments = in.readInt();
+    const int numLevels = in.readInt();
+    const int numPathBytes = in.readInt();
+
+    if (numSegments < 0 || numLevels < 0 || numPathBytes < 0
+        || in.getNumBytesRemaining() < (juce::int64)numPathBytes + (juce::int64)numSegments * segmentSize)
+        return false;
+
+    // Pfad mitvergleichen, zwei Dateien können denselben Hash haben
+    const auto* pathBytes = static_cast<const char*>(in.getData()) + in.getPosition();
+
+    if (juce::String::fromUTF8(pathBytes, numPathBytes) != path)
+        return false;
+
+    in.skipNextBytes(numPathBytes);
+
+    result.beatGrid.segments.resize((size_t)numSegments);
+    for (auto& segment : result.beatGrid.segments)
+    {
+        segment.startTime = in.readDouble();
+        segment.beatLength = in.readDouble();
+        segment.firstBeat = in.readInt();
+        segment.numBeats = in.readInt();
+    }
+
+    // Kaputte Grids gar nicht erst weitergeben
+    auto& grid = result.beatGrid;
+    grid.beatsPerBar = juce::jmax(1, grid.beatsPerBar);
+    grid.firstDownbeat = juce::jlimit(0, grid.beatsPerBar - 1, grid.firstDownbeat);
+    grid.segments.erase(std::remove_if(grid.segments.begin(), grid.segments.end(),
+                                       [](const BeatGrid::Segment& segment) { return !(segment.beatLength > 0.0) || segment.numBeats <= 0; }),
+                        grid.segments.end());
+
+    if (withWaveform)
+    {
+        result.waveform.resize((size_t)numLevels);
+
+        for (auto& level : result.waveform)
+        {
+            const int numPoints = in.readInt();
+
+            if (numPoints < 0 || in.getNumBytesRemaining() < 2 * (juce::int64)numPoints)
+                return false;
+
+            level.minSamples.resize((size_t)numPoints);
+            level.maxSamples.resize((size_t)numPoints);
+
+            for (int i = 0; i < numPoints; ++i)
+            {
+                level.minSamples[(size_t)i] = dequantise(in.readByte());
+                level.maxSamples[(size_t)i] = dequantise(in.readByte());
+            }
+        }
+    }
+
+    record = std::move(result);
+    return true;
+}
+
+bool TrackDatabase::lookup(const juce::File& file, Record& record, bool withWaveform)
+{
+    juce::int64 fileSize = 0, modificationTime = 0;
+
+    if (!readFileState(file, fileSize, modificationTime))
+        return false;
+
+    const auto path = file.getFullPathName();
+    std::lock_guard<std::mutex> guard(lock);
+
+    const auto pendingRecord = pending.find(path);
+
+    if (pendingRecord != pending.end())
+    {
+        const auto& entry = pendingRecord->second;
+
+        if (entry.fileSize != fileSize || entry.modificationTime != modificationTime)
+            return false;
+
+        record = entry.record;
+
+        if (!withWaveform)
+            record.waveform.clear();
+
+        return true;
+    }
+
+    IndexEntry entry;
+    return findEntry(getKey(path), entry) && parseRecord(entry, path, fileSize, modificationTime, record, withWaveform);
+}
+
+double TrackDatabase::getDuration(const juce::File& file)
+{
+    Record record;
+    return lookup(file, record, false) ? record.duration : 0.0;
+}
+
+int TrackDatabase::getNumTracks() const
+{
+    std::lock_guard<std::mutex> guard(lock);
+
+    int count = (int)numEntries;
+    IndexEntry existing;
+
+    for (const auto& entry : pending)
+        if (!findEntry(getKey(entry.first), existing))
+            ++count;
+
+    return count;
+}
+
+//==============================================================================
+void TrackDatabase::store(const juce::File& file, const Record& record)
+{
+    juce::int64 fileSize = 0, modificationTime = 0;
+
+    if (!readFileState(file, fileSize, modificationTime))
+        return;
+
+    const auto path = file.getFullPathName();
+    const auto block = serialise(path, fileSize, modificationTime, record);
+
+    std::lock_guard<std::mutex> guard(lock);
+
+    if (dataOut == nullptr)
+        return;
+
+    Pending entry;
+    entry.offset = (juce::uint64)dataOut->getPosition();
+    entry.size = (juce::uint32)block.getSize();
+    entry.fileSize = fileSize;
+    entry.modificationTime = modificationTime;
+    entry.record = record;
+
+    if (!dataOut->write(block.getData(), block.getSize()))
+        return;
+
+    pending[path] = std::move(entry);
+
+    if (pending.size() >= maxPendingRecords)
+        flushLocked();
+}
+
+void TrackDatabase::flush()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    flushLocked();
+}
+
+void TrackDatabase::flushLocked()
+{
+    if (pending.empty() || dataOut == nullptr)
+        return;
+
+    dataOut->flush();
+
+    auto merged = readEntries();
+    std::vector<IndexEntry> added;
+    added.reserve(pending.size());
+
+    for (const auto& record : pending)
+        added.push_back({ getKey(record.first), record.second.offset, record.second.size, 0 });
+
+    // Neue Einträge ersetzen alte mit demselben Schlüssel; kollidieren zwei Pfade,
+    // wird der ältere beim nächsten Mal eben neu analysiert
+    std::sort(added.begin(), added.end(), [](const IndexEntry& a, const IndexEntry& b) { return a.key < b.key; });
+    merged.insert(merged.begin(), added.begin(), added.end());
+    std::stable_sort(merged.begin(), merged.end(), [](const IndexEntry& a, const IndexEntry& b) { return a.key < b.key; });
+    merged.erase(std::unique(merged.begin(), merged.end(), [](const IndexEntry& a, const IndexEntry& b) { return a.key == b.key; }),
+                 merged.end());
+
+    const auto dataSize = dataOut->getPosition();
+
+    if (!writeIndex(merged, dataSize, dataGeneration))
+    {
+        mapFiles();
+        return;
+    }
+
+    mapFiles();
+    pending.clear();
+}
+
+void TrackDatabase::compact()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    flushLocked();
+
+    if (mappedData == nullptr || !pending.empty())
+        return;
+
+    // Die kompaktierten Daten gehen in eine neue Datei der nächsten Generation. Umgeschaltet wird
+    // allein durch das Ersetzen des Index: bricht vorher etwas ab, gilt weiter das alte Paar
+    auto compacted = readEntries();
+    const auto newGeneration = dataGeneration + 1;
+    const auto newDataFile = getDataFile(newGeneration);
+    newDataFile.deleteFile();
+
+    {
+        juce::FileOutputStream out(newDataFile);
+
+        if (!out.openedOk() || !writeDataHeader(out, newGeneration))
+        {
+            newDataFile.deleteFile();
+            return;
+        }
+
+        for (auto& entry : compacted)
+        {
+            if (entry.offset + entry.size > mappedData->getSize())
+            {
+                entry.size = 0;
+                continue;
+            }
+
+            const auto offset = (juce::uint64)out.getPosition();
+            out.write(juce::addBytesToPointer(mappedData->getData(), entry.offset), entry.size);
+            entry.offset = offset;
+        }
+
+        out.flush();
+
+        if (out.getStatus().failed())
+        {
+            newDataFile.deleteFile();
+            return;
+        }
+    }
+
+    compacted.erase(std::remove_if(compacted.begin(), compacted.end(), [](const IndexEntry& entry) { return entry.size == 0; }),
+                    compacted.end());
+
+    if (!writeIndex(compacted, newDataFile.getSize(), newGeneration))
+    {
+        newDataFile.deleteFile();
+        mapFiles();
+        return;
+    }
+
+    dataOut.reset();
+    mappedData.reset();
+    dataFile.deleteFile();
+
+    dataFile = newDataFile;
+    dataGeneration = newGeneration;
+    mapFiles();
+
+    dataOut = std::make_unique<juce::FileOutputStream>(dataFile);
+
+    if (!dataOut->openedOk())
+        dataOut.reset();
+}
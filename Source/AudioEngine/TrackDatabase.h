@@ -0,0 +1,145 @@
+/*
+  ==============================================================================
+
+    TrackDatabase.h
+    Created: 16 Oct 2026
+
+    Persistent per-track analysis under ~/.RadioBlast/library: duration,
+    sample rate, tempo and beatgrid, a waveform pyramid and loudness, so
+    nothing is decoded or measured twice across sessions.
+
+    Two files, both binary and little-endian on every platform:
+
+      tracks-N.dat  append-only records. Each starts with the source path,
+                    size and modification time it was made from; a lookup
+                    only counts if the file on disk still matches.
+      tracks.idx    sorted array of (64 bit path hash, record offset,
+                    size), memory-mapped, plus the generation N of the
+                    data file it belongs to. Opening the library maps it
+                    and the data file without reading either; a lookup is
+                    a binary search plus one record parse, no file is
+                    opened.
+
+    New records are appended at once and become part of the index on the
+    next flush (every few records, on flush() and on destruction), which
+    writes a new index next to the old one and swaps it in. Replaced
+    records stay in the data file as garbage until compact(), which runs
+    on open when more than half the file is garbage. compact() writes a
+    data file of the next generation and then swaps in the index that
+    names it, so the pair on disk is always consistent; the old data file
+    is deleted afterwards (or on the next open, after a crash).
+
+    Thread safe; lookups take microseconds, store() appends one record.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "BeatGrid.h"
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class TrackDatabase
+{
+public:
+    struct WaveformLevel
+    {
+        std::vector<float> minSamples;  // -1 .. 0
+        std::vector<float> maxSamples;  //  0 .. 1
+    };
+
+    struct Record
+    {
+        double duration = 0.0;
+        double sampleRate = 0.0;
+        double bpm = 0.0;
+        double bpmConfidence = 0.0;
+        double loudness = -70.0;        // integriert, LUFS
+        float peak = 0.0f;
+        BeatGrid beatGrid;
+        std::vector<WaveformLevel> waveform;    // feinste Stufe zuerst, jede weitere halb so viele Punkte
+
+        /** The overview at its finest resolution plus halvings down to ~64 points. */
+        static std::vector<WaveformLevel> buildWaveformLevels(const std::vector<float>& minSamples,
+                                                              const std::vector<float>& maxSamples);
+    };
+
+    /** The library database in the user's home directory. */
+    static TrackDatabase& getInstance();
+
+    explicit TrackDatabase(const juce::File& directory);
+    ~TrackDatabase();
+
+    /**
+        Reads the record for file if there is one and the file did not change
+        since. Without withWaveform the pyramid is skipped (cheaper, e.g. for
+        playlist columns).
+    */
+    bool lookup(const juce::File& file, Record& record, bool withWaveform);
+    bool lookup(const juce::File& file, Record& record) { return lookup(file, record, true); }
+
+    /** Stored duration in seconds, 0 if the file is not in the database. */
+    double getDuration(const juce::File& file);
+
+    /** Adds or replaces the record for file. */
+    void store(const juce::File& file, const Record& record);
+
+    /** Makes all stored records part of the on-disk index. */
+    void flush();
+
+    /** Rewrites the data file without replaced records. */
+    void compact();
+
+    int getNumTracks() const;
+    juce::File getDirectory() const { return directory; }
+
+private:
+    struct IndexEntry   // auf der Platte 24 Bytes, little-endian
+    {
+        juce::uint64 key;
+        juce::uint64 offset;
+        juce::uint32 size;
+        juce::uint32 reserved;
+    };
+
+    struct Pending
+    {
+        juce::uint64 offset = 0;
+        juce::uint32 size = 0;
+        juce::int64 fileSize = 0;
+        juce::int64 modificationTime = 0;
+        Record record;
+    };
+
+    static juce::uint64 getKey(const juce::String& path) noexcept;
+    juce::File getDataFile(juce::uint64 generation) const;
+
+    void open();
+    void mapFiles();
+    void flushLocked();
+    bool writeIndex(const std::vector<IndexEntry>& entries, juce::int64 dataSize, juce::uint64 generation);
+    IndexEntry readEntry(size_t index) const noexcept;
+    std::vector<IndexEntry> readEntries() const;
+    bool findEntry(juce::uint64 key, IndexEntry& entry) const noexcept;
+    bool parseRecord(const IndexEntry& entry, const juce::String& path, juce::int64 fileSize,
+                     juce::int64 modificationTime, Record& record, bool withWaveform) const;
+
+    const juce::File directory;
+    const juce::File indexFile;
+    juce::File dataFile;                // tracks-N.dat, N aus dem Index
+    juce::uint64 dataGeneration = 0;
+
+    mutable std::mutex lock;
+    std::unique_ptr<juce::MemoryMappedFile> mappedIndex, mappedData;
+    const char* indexEntries = nullptr;
+    size_t numEntries = 0;
+
+    std::unique_ptr<juce::FileOutputStream> dataOut;
+    std::map<juce::String, Pending> pending;   // geschrieben, aber noch nicht im Index
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TrackDatabase)
+};
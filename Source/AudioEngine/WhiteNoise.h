@@ -13,7 +13,7 @@
 
 #include "Oszillator.h"
 #include "Modulator.h"
-#include "../JuceLibraryCode/JuceHeader.h"
+#include <JuceHeader.h>
 
 class WhiteNoise : public Oszillator, public Modulator {
     
@@ -6,14 +6,19 @@
 */
 #pragma once
 #include <JuceHeader.h>
+#include "AudioEngine/DecodedTrackCache.h"
+#include "AudioEngine/BeatTracker.h"
+#include "AudioEngine/OnsetDetector.h"
+#include "AudioEngine/TempoEstimator.h"
+#include "AudioEngine/TrackDatabase.h"
 #include <vector>
-#include <complex>
 
 class BPMAnalyzer
 {
 public:
     BPMAnalyzer()
     {
+        setupAnalysis();
         reset();
     }
 
@@ -30,59 +35,93 @@ public:
         detectedBPM = 0.0;
         confidence = 0.0;
         analysisComplete = false;
-        audioBuffer.clear();
+        onsetDetector.reset();
+        onsetEnvelope.clear();
+        lowBandEnvelope.clear();
+        tempoCandidates.clear();
+        beatGrid = BeatGrid();
         beatTimes.clear();
     }
 
-    // Audio-Samples fr Analyse hinzufgen
-    void processAudioBlock(const float* audioData, int numSamples)
+    // BPM und Beatgrid aus Audio-Datei (Bibliothek, sonst dekodieren ber den gemeinsamen Cache; blockiert)
+    bool analyzeFile(const juce::File& audioFile)
     {
-        if (analysisComplete) return;
+        if (loadStoredAnalysis(audioFile))
+            return true;
 
-        // Audio in internen Buffer sammeln
-        for (int i = 0; i < numSamples; ++i)
-        {
-            audioBuffer.push_back(audioData[i]);
-        }
+        auto track = DecodedTrackCache::getInstance().getOrDecode(audioFile);
 
-        // Genug Samples fr Analyse? (ca. 10 Sekunden)
-        if (audioBuffer.size() >= static_cast<size_t>(sampleRate * 10.0))
+        if (track == nullptr)
         {
-            analyzeBPM();
-            analysisComplete = true;
+            reset();
+            return false;
         }
+
+        return analyzeTrack(*track);
     }
 
-    // BPM aus Audio-Datei analysieren
-    bool analyzeFile(const juce::File& audioFile)
+    // Frheres Ergebnis fr diese Datei aus der TrackDatabase bernehmen, falls sie sich seitdem nicht gendert hat
+    bool loadStoredAnalysis(const juce::File& audioFile)
     {
-        reset();
-
-        juce::AudioFormatManager formatManager;
-        formatManager.registerBasicFormats();
+        TrackDatabase::Record record;
+        return TrackDatabase::getInstance().lookup(audioFile, record, false) && loadStoredAnalysis(record);
+    }
 
-        auto reader = std::unique_ptr<juce::AudioFormatReader>(formatManager.createReaderFor(audioFile));
-        if (!reader) return false;
+    bool loadStoredAnalysis(const TrackDatabase::Record& record)
+    {
+        return setAnalysis(record.bpm, record.bpmConfidence, record.beatGrid);
+    }
 
-        setSampleRate(reader->sampleRate);
+    // Ergebnis einer Analyse von anderswo bernehmen (AnalysisScheduler, TrackDatabase)
+    bool setAnalysis(double bpm, double bpmConfidence, const BeatGrid& grid)
+    {
+        if (bpm <= 0.0)
+            return false;
 
-        // Audio laden (erste 30 Sekunden fr bessere Analyse)
-        int samplesToRead = static_cast<int>(juce::jmin(reader->lengthInSamples,
-            static_cast<juce::int64 > (sampleRate * 30.0)));
+        reset();
+        detectedBPM = bpm;
+        confidence = bpmConfidence;
+        beatGrid = grid;
+        beatTimes = beatGrid.getBeatTimes();
+        analysisComplete = true;
+        return true;
+    }
 
-        juce::AudioBuffer<float> fileBuffer(1, samplesToRead);
-        reader->read(&fileBuffer, 0, samplesToRead, 0, true, false); // Mono
+    // BPM und Beatgrid aus bereits dekodiertem Track (ganzer Track, beide Kanle, ein Durchlauf)
+    bool analyzeTrack(const DecodedTrack& track)
+    {
+        const int numSamples = track.buffer.getNumSamples();
+        beginTrack(track.sampleRate, numSamples);
 
-        // BPM analysieren
-        audioBuffer.clear();
-        audioBuffer.reserve(samplesToRead);
+        // In Blcken durch den Detector, er hlt nur ein FFT-Fenster
+        constexpr int blockSize = 65536;
 
-        const float* channelData = fileBuffer.getReadPointer(0);
-        for (int i = 0; i < samplesToRead; ++i)
+        for (int start = 0; start < numSamples; start += blockSize)
         {
-            audioBuffer.push_back(channelData[i]);
+            const float* channels[] = { track.buffer.getReadPointer(0, start), track.buffer.getReadPointer(1, start) };
+            addTrackBlock(channels, 2, juce::jmin(blockSize, numSamples - start));
         }
 
+        return finishTrack();
+    }
+
+    // Dasselbe blockweise, wenn der Track nicht dekodiert im Speicher liegt (z.B. direkt aus dem Reader)
+    void beginTrack(double trackSampleRate, juce::int64 expectedSamples)
+    {
+        setSampleRate(trackSampleRate);
+        reset();
+
+        onsetEnvelope.reserve(static_cast<size_t>(onsetDetector.getMaxFramesForSamples(expectedSamples)));
+        lowBandEnvelope.reserve(onsetEnvelope.capacity());
+    }
+
+    void addTrackBlock(const float* const* channels, int numChannels, int numSamples)
+    {
+        appendOnsets(channels, numChannels, numSamples);
+    }
+
+    bool finishTrack()
+    {
         analyzeBPM();
         analysisComplete = true;
 
@@ -93,6 +132,13 @@ public:
     double getConfidence() const { return confidence; }
     bool isAnalysisComplete() const { return analysisComplete; }
 
+    // Alle Tempo-Kandidaten, bester zuerst (Halb-/Doppeltempo stehen meist auf Platz 2 und 3)
+    const std::vector<TempoEstimator::Candidate>& getTempoCandidates() const { return tempoCandidates; }
+
+    // Schlge, Downbeats und Tempo-Segmente; Zeiten in Sekunden ab Trackanfang
+    const BeatGrid& getBeatGrid() const { return beatGrid; }
+    const std::vector<double>& getBeatTimes() const { return beatTimes; }
+
     // Tempo-Matching: Berechne Pitch-Ratio fr BPM-Anpassung
     double calculatePitchRatio(double targetBPM) const
     {
@@ -120,100 +166,52 @@ private:
     double confidence = 0.0;
     bool analysisComplete = false;
 
-    std::vector<float> audioBuffer;
+    OnsetDetector onsetDetector;
+    std::vector<float> onsetEnvelope;   // Spectral Flux, ca. 86 Frames pro Sekunde
+    std::vector<float> lowBandEnvelope; // nur unter ~200 Hz, fr Downbeats
+    TempoEstimator tempoEstimator;
+    std::vector<TempoEstimator::Candidate> tempoCandidates;
+    BeatTracker beatTracker;
+    BeatGrid beatGrid;
     std::vector<double> beatTimes;
 
     void setupAnalysis()
     {
-        // Setup fr Audio-Analyse
+        onsetDetector.prepare(sampleRate);
     }
 
-    void analyzeBPM()
+    void appendOnsets(const float* const* channels, int numChannels, int numSamples)
     {
-        if (audioBuffer.empty()) return;
-
-        // Simplified BPM detection algorithm
-        std::vector<float> onset_strength = calculateOnsetStrength();
-        std::vector<double> tempo_candidates = findTempoCandidates(onset_strength);
-
-        if (!tempo_candidates.empty())
-        {
-            detectedBPM = tempo_candidates[0];
-            confidence = 0.8; // Vereinfacht
-        }
+        const size_t oldSize = onsetEnvelope.size();
+        onsetEnvelope.resize(oldSize + static_cast<size_t>(onsetDetector.getMaxFramesForSamples(numSamples)));
+        lowBandEnvelope.resize(onsetEnvelope.size());
+
+        const int numFrames = onsetDetector.process(channels, numChannels, numSamples,
+                                                    onsetEnvelope.data() + oldSize, static_cast<int>(onsetEnvelope.size() - oldSize),
+                                                    lowBandEnvelope.data() + oldSize);
+        onsetEnvelope.resize(oldSize + static_cast<size_t>(numFrames));
+        lowBandEnvelope.resize(onsetEnvelope.size());
     }
 
-    std::vector<float> calculateOnsetStrength()
-    {
-        // Vereinfachte Onset Detection
-        std::vector<float> onsets;
-
-        const int hopSize = 512;
-        const int windowSize = 1024;
-
-        for (size_t i = 0; i + windowSize < audioBuffer.size(); i += hopSize)
-        {
-            float energy = 0.0f;
-            for (int j = 0; j < windowSize; ++j)
-            {
-                energy += audioBuffer[i + j] * audioBuffer[i + j];
-            }
-            onsets.push_back(energy);
-        }
-
-        // High-pass filtern fr Beat-Detection
-        for (size_t i = 1; i < onsets.size(); ++i)
-        {
-            float diff = onsets[i] - onsets[i - 1];
-            onsets[i] = juce::jmax(0.0f, diff);
-        }
-
-        return onsets;
-    }
-
-    std::vector<double> findTempoCandidates(const std::vector<float>& onsetStrength)
+    void analyzeBPM()
     {
-        std::vector<double> candidates;
-
-        // Autocorrelation fr Tempo-Detection
-        const double minBPM = 60.0;
-        const double maxBPM = 200.0;
-        const double hopTime = 512.0 / sampleRate;
+        if (onsetEnvelope.empty()) return;
 
-        int minLag = static_cast<int>(60.0 / (maxBPM * hopTime));
-        int maxLag = static_cast<int>(60.0 / (minBPM * hopTime));
+        // Autokorrelation per FFT ber die ganze Onset-Kurve, dann Kammfilter ber die Tempi
+        if (tempoEstimator.getMaxFrames() < static_cast<int>(onsetEnvelope.size())
+            || tempoEstimator.getFrameRate() != onsetDetector.getFrameRate())
+            tempoEstimator.prepare(static_cast<int>(onsetEnvelope.size()), onsetDetector.getFrameRate());
 
-        double bestCorrelation = 0.0;
-        double bestBPM = 0.0;
+        tempoCandidates = tempoEstimator.estimate(onsetEnvelope);
 
-        for (int lag = minLag; lag <= maxLag; ++lag)
-        {
-            double correlation = 0.0;
-            int count = 0;
-
-            for (size_t i = lag; i < onsetStrength.size(); ++i)
-            {
-                correlation += onsetStrength[i] * onsetStrength[i - lag];
-                count++;
-            }
-
-            if (count > 0)
-            {
-                correlation /= count;
-
-                if (correlation > bestCorrelation)
-                {
-                    bestCorrelation = correlation;
-                    bestBPM = 60.0 / (lag * hopTime);
-                }
-            }
-        }
+        if (tempoCandidates.empty()) return;
 
-        if (bestBPM > 0.0)
-        {
-            candidates.push_back(bestBPM);
-        }
+        detectedBPM = tempoCandidates[0].bpm;
+        confidence = tempoCandidates[0].confidence;
 
-        return candidates;
+        // Schlge per Dynamic Programming ber dieselbe Onset-Kurve, folgt auch driftendem Tempo
+        beatGrid = beatTracker.track(onsetEnvelope, lowBandEnvelope, detectedBPM,
+                                     onsetDetector.getFrameRate(), onsetDetector.getFrameTime(0.0));
+        beatTimes = beatGrid.getBeatTimes();
     }
-};
\ No newline at end of file
+};
@@ -0,0 +1,180 @@
+/*
+  ==============================================================================
+
+    BenchmarkRunner.cpp
+    Created: 16 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "BenchmarkRunner.h"
+#include <algorithm>
+
+std::vector<BenchmarkResult> BenchmarkRunner::run(const std::vector<BenchmarkDefinition>& benchmarks,
+                                                  std::function<void(const BenchmarkResult&)> onResult)
+{
+    std::vector<BenchmarkResult> results;
+
+    for (const auto& benchmark : benchmarks)
+    {
+        if (options.filter.isNotEmpty()
+            && !benchmark.module.containsIgnoreCase(options.filter)
+            && !benchmark.implementation.containsIgnoreCase(options.filter))
+            continue;
+
+        for (auto sampleRate : options.sampleRates)
+        {
+            for (auto blockSize : options.blockSizes)
+            {
+                results.push_back(measure(benchmark, sampleRate, blockSize));
+
+                if (onResult)
+                    onResult(results.back());
+            }
+        }
+    }
+
+    compareWithReferences(results);
+    return results;
+}
+
+BenchmarkResult BenchmarkRunner::measure(const BenchmarkDefinition& benchmark, double sampleRate, int blockSize)
+{
+    BenchmarkResult result;
+    result.module = benchmark.module;
+    result.implementation = benchmark.implementation;
+    result.isReference = benchmark.isReference;
+    result.numChannels = benchmark.numChannels;
+    result.sampleRate = sampleRate;
+    result.blockSize = blockSize;
+
+    // Rauschen als Eingang; Oszillatoren überschreiben den Block ohnehin
+    juce::AudioBuffer<float> block(2, blockSize);
+    juce::Random random(0x5eed);
+
+    for (int ch = 0; ch < block.getNumChannels(); ++ch)
+        for (int i = 0; i < blockSize; ++i)
+            block.setSample(ch, i, random.nextFloat() - 0.5f);
+
+    const auto process = benchmark.prepare(sampleRate, blockSize);
+
+    // Denormals würden die in-place laufenden Filter mit der Zeit ausbremsen
+    const juce::ScopedNoDenormals noDenormals;
+
+    auto timeBlocks = [&](int numBlocks)
+    {
+        const auto start = juce::Time::getHighResolutionTicks();
+
+        for (int i = 0; i < numBlocks; ++i)
+            process(block);
+
+        return juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start) * 1.0e3;
+    };
+
+    // Aufwärmen, dann so viele Blöcke pro Runde, dass eine Runde mindestens roundMs dauert
+    timeBlocks(16);
+
+    int blocksPerRound = 1;
+
+    while (timeBlocks(blocksPerRound) < options.roundMs && blocksPerRound < (1 << 24))
+        blocksPerRound *= 2;
+
+    std::vector<double> nsPerSample;
+
+    for (int round = 0; round < juce::jmax(1, options.numRounds); ++round)
+        nsPerSample.push_back(timeBlocks(blocksPerRound) * 1.0e6 / ((double)blocksPerRound * blockSize));
+
+    std::sort(nsPerSample.begin(), nsPerSample.end());
+
+    result.nsPerSample = nsPerSample[nsPerSample.size() / 2];
+    result.nsPerSampleMin = nsPerSample.front();
+    result.cpuPercent = result.nsPerSample * sampleRate * 1.0e-7;
+    return result;
+}
+
+void BenchmarkRunner::compareWithReferences(std::vector<BenchmarkResult>& results)
+{
+    for (auto& result : results)
+    {
+        if (result.isReference)
+            continue;
+
+        // Erste Referenz desselben Moduls bei gleicher Rate und Blockgröße
+        auto reference = std::find_if(results.begin(), results.end(), [&result](const BenchmarkResult& candidate)
+        {
+            return candidate.isReference && candidate.module == result.module
+                && candidate.sampleRate == result.sampleRate && candidate.blockSize == result.blockSize;
+        });
+
+        if (reference == results.end() || reference->nsPerSample <= 0.0)
+            continue;
+
+        result.reference = reference->implementation;
+        result.relativeToReference = result.nsPerSample / reference->nsPerSample;
+    }
+}
+
+juce::String BenchmarkRunner::toJson(const std::vector<BenchmarkResult>& results, const juce::String& suiteName) const
+{
+    auto* machine = new juce::DynamicObject();
+    machine->setProperty("cpu", juce::SystemStats::getCpuModel());
+    machine->setProperty("cpuVendor", juce::SystemStats::getCpuVendor());
+    machine->setProperty("numCpus", juce::SystemStats::getNumCpus());
+    machine->setProperty("numPhysicalCpus", juce::SystemStats::getNumPhysicalCpus());
+    machine->setProperty("os", juce::SystemStats::getOperatingSystemName());
+
+    auto* config = new juce::DynamicObject();
+    config->setProperty("roundMs", options.roundMs);
+    config->setProperty("numRounds", options.numRounds);
+    config->setProperty("filter", options.filter);
+
+    juce::Array<juce::var> entries;
+
+    for (const auto& result : results)
+    {
+        auto* entry = new juce::DynamicObject();
+        entry->setProperty("module", result.module);
+        entry->setProperty("implementation", result.implementation);
+        entry->setProperty("isReference", result.isReference);
+        entry->setProperty("numChannels", result.numChannels);
+        entry->setProperty("sampleRate", result.sampleRate);
+        entry->setProperty("blockSize", result.blockSize);
+        entry->setProperty("nsPerSample", result.nsPerSample);
+        entry->setProperty("nsPerSampleMin", result.nsPerSampleMin);
+        entry->setProperty("cpuPercent", result.cpuPercent);
+
+        if (result.reference.isNotEmpty())
+        {
+            entry->setProperty("reference", result.reference);
+            entry->setProperty("relativeToReference", result.relativeToReference);
+        }
+
+        entries.add(juce::var(entry));
+    }
+
+    auto* root = new juce::DynamicObject();
+    root->setProperty("suite", suiteName);
+    root->setProperty("version", ProjectInfo::versionString);
+    root->setProperty("timestamp", juce::Time::getCurrentTime().toISO8601(true));
+    root->setProperty("machine", juce::var(machine));
+    root->setProperty("config", juce::var(config));
+    root->setProperty("results", entries);
+
+    return juce::JSON::toString(juce::var(root));
+}
+
+juce::String BenchmarkRunner::toCsv(const std::vector<BenchmarkResult>& results)
+{
+    juce::String csv = "module,implementation,isReference,numChannels,sampleRate,blockSize,nsPerSample,nsPerSampleMin,cpuPercent,reference,relativeToReference\n";
+
+    for (const auto& result : results)
+    {
+        csv << result.module << "," << result.implementation << "," << (result.isReference ? 1 : 0) << ","
+            << result.numChannels << "," << result.sampleRate << "," << result.blockSize << ","
+            << juce::String(result.nsPerSample, 4) << "," << juce::String(result.nsPerSampleMin, 4) << ","
+            << juce::String(result.cpuPercent, 4) << "," << result.reference << ","
+            << juce::String(result.relativeToReference, 4) << "\n";
+    }
+
+    return csv;
+}
@@ -0,0 +1,83 @@
+/*
+  ==============================================================================
+
+    BenchmarkRunner.h
+    Created: 16 Oct 2026
+
+    Times block processors in ns per sample frame over a grid of sample
+    rates and block sizes. Every benchmark is a factory that prepares its
+    processor for one rate / block size and returns the per-block call; the
+    runner feeds it a stereo noise block over and over, calibrates how many
+    blocks make up one timed round and reports the median and the fastest
+    of several rounds.
+
+    Benchmarks of the same module are compared against its reference
+    implementation (the juce::dsp equivalent), and the results can be
+    written as JSON or CSV so runs can be compared over time.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <functional>
+#include <vector>
+
+struct BenchmarkDefinition
+{
+    using BlockProcessor = std::function<void(juce::AudioBuffer<float>&)>;
+
+    juce::String module;            // z.B. "LowPassFilter"
+    juce::String implementation;    // "RadioBlast" oder die JUCE-Klasse
+    bool isReference = false;       // Vergleichsbasis für die anderen Einträge desselben Moduls
+    int numChannels = 1;            // Kanäle, die pro Block bearbeitet werden
+
+    // Bereitet den Prozessor für Rate und Blockgröße vor und gibt den Aufruf pro Block zurück
+    std::function<BlockProcessor(double sampleRate, int blockSize)> prepare;
+};
+
+struct BenchmarkResult
+{
+    juce::String module;
+    juce::String implementation;
+    bool isReference = false;
+    int numChannels = 1;
+    double sampleRate = 0.0;
+    int blockSize = 0;
+
+    double nsPerSample = 0.0;       // Median der Runden
+    double nsPerSampleMin = 0.0;    // schnellste Runde
+    double cpuPercent = 0.0;        // Anteil eines Kerns in Echtzeit bei dieser Rate
+
+    juce::String reference;         // leer, wenn es für das Modul keine Referenz gibt
+    double relativeToReference = 0.0;
+};
+
+class BenchmarkRunner
+{
+public:
+    struct Options
+    {
+        std::vector<double> sampleRates { 44100.0, 48000.0, 96000.0 };
+        std::vector<int> blockSizes { 64, 256, 1024 };
+        double roundMs = 20.0;      // Mindestdauer einer gemessenen Runde
+        int numRounds = 7;
+        juce::String filter;        // nur Module / Implementierungen, die das enthalten
+    };
+
+    explicit BenchmarkRunner(Options optionsToUse) : options(std::move(optionsToUse)) {}
+
+    /** Runs every matching benchmark over the rate / block size grid; onResult is called after each one. */
+    std::vector<BenchmarkResult> run(const std::vector<BenchmarkDefinition>& benchmarks,
+                                     std::function<void(const BenchmarkResult&)> onResult = {});
+
+    juce::String toJson(const std::vector<BenchmarkResult>& results, const juce::String& suiteName) const;
+    static juce::String toCsv(const std::vector<BenchmarkResult>& results);
+
+private:
+    BenchmarkResult measure(const BenchmarkDefinition& benchmark, double sampleRate, int blockSize);
+    static void compareWithReferences(std::vector<BenchmarkResult>& results);
+
+    Options options;
+};
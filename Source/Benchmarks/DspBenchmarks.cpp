@@ -0,0 +1,584 @@
+/*
+  ==============================================================================
+
+    DspBenchmarks.cpp
+    Created: 16 Oct 2026
+
+    RadioBlastDspBench: ns per sample for the AudioEngine DSP modules and
+    their juce::dsp equivalents at common sample rates and block sizes.
+
+        RadioBlastDspBench [--rates 44100,48000,96000] [--blocks 64,256,1024]
+                           [--round-ms 20] [--rounds 7] [--filter name]
+                           [--json results.json] [--csv results.csv] [--list]
+        RadioBlastDspBench --accuracy
+
+    Filters and delays run in place on a stereo noise block, oscillators and
+    envelopes overwrite it. The reference of a module is the JUCE class a
+    rewrite would be measured against; "vs ref" is the time relative to it.
+    CompactSampleBuffer reads are compared against copying the float track.
+
+    --accuracy prints the error of each CompactSampleBuffer format on 10 M
+    frames of music-like material instead of timing anything.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <cmath>
+#include <iostream>
+#include "BenchmarkRunner.h"
+#include "../AudioEngine/ADSR.h"
+#include "../AudioEngine/BasicDelayLine.h"
+#include "../AudioEngine/CompactSampleBuffer.h"
+#include "../AudioEngine/Distortion.h"
+#include "../AudioEngine/FractionalDelayBuffer.h"
+#include "../AudioEngine/HighPassFilter.h"
+#include "../AudioEngine/LowPassFilter.h"
+#include "../AudioEngine/MultimodeFilter.h"
+#include "../AudioEngine/MultimodeOscillator.h"
+#include "../AudioEngine/Pulse.h"
+#include "../AudioEngine/Sawtooth.h"
+#include "../AudioEngine/Sine.h"
+#include "../AudioEngine/WhiteNoise.h"
+
+namespace
+{
+    using BlockProcessor = BenchmarkDefinition::BlockProcessor;
+
+    constexpr float cutoff = 1000.0f;
+    constexpr float resonance = 0.7071f;
+    constexpr float delayMs = 250.0f;
+    constexpr float feedback = 0.5f;
+    constexpr float mix = 0.5f;
+    constexpr double frequency = 440.0;
+
+    juce::dsp::ProcessSpec makeSpec(double sampleRate, int blockSize, int numChannels)
+    {
+        return { sampleRate, (juce::uint32)blockSize, (juce::uint32)numChannels };
+    }
+
+    // Erster Kanal als eigener Block, für die Mono-Module
+    juce::dsp::AudioBlock<float> firstChannel(juce::AudioBuffer<float>& buffer)
+    {
+        return juce::dsp::AudioBlock<float>(buffer).getSingleChannelBlock(0);
+    }
+
+    //==============================================================================
+    // juce::dsp Oszillator mit der Wellenform des jeweiligen RadioBlast-Oszillators
+    BlockProcessor juceOscillator(std::function<float(float)> waveform, size_t lookupTableSize, double sampleRate, int blockSize)
+    {
+        auto oscillator = std::make_shared<juce::dsp::Oscillator<float>>(std::move(waveform), lookupTableSize);
+        oscillator->prepare(makeSpec(sampleRate, blockSize, 1));
+        oscillator->setFrequency((float)frequency, true);
+
+        return [oscillator](juce::AudioBuffer<float>& buffer)
+        {
+            auto block = firstChannel(buffer);
+            block.clear();
+            oscillator->process(juce::dsp::ProcessContextReplacing<float>(block));
+        };
+    }
+
+    template <typename OscillatorType>
+    BlockProcessor radioBlastOscillator(double sampleRate, int blockSize)
+    {
+        auto oscillator = std::make_shared<OscillatorType>((float)sampleRate, blockSize);
+        oscillator->setFrequency(frequency);
+
+        return [oscillator](juce::AudioBuffer<float>& buffer)
+        {
+            auto* data = buffer.getWritePointer(0);
+
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                data[i] = oscillator->process();
+        };
+    }
+
+    //==============================================================================
+    BlockProcessor radioBlastDistortion(int mode, double, int)
+    {
+        auto distortion = std::make_shared<Distortion>();
+        distortion->controls.mode = mode;
+        distortion->controls.drive = 2.0f;
+        distortion->controls.mix = 1.0f;
+
+        return [distortion](juce::AudioBuffer<float>& buffer)
+        {
+            auto* data = buffer.getWritePointer(0);
+
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                data[i] = distortion->processSample(data[i]);
+        };
+    }
+
+    BlockProcessor juceWaveShaper(float (*shape)(float), double sampleRate, int blockSize)
+    {
+        auto shaper = std::make_shared<juce::dsp::WaveShaper<float>>();
+        shaper->functionToUse = shape;
+        shaper->prepare(makeSpec(sampleRate, blockSize, 1));
+
+        return [shaper](juce::AudioBuffer<float>& buffer)
+        {
+            auto block = firstChannel(buffer);
+            shaper->process(juce::dsp::ProcessContextReplacing<float>(block));
+        };
+    }
+
+    //==============================================================================
+    template <typename FilterType>
+    BlockProcessor radioBlastMonoFilter(double sampleRate, int)
+    {
+        auto filter = std::make_shared<FilterType>();
+        filter->coefficients((float)sampleRate, cutoff, resonance);
+
+        return [filter](juce::AudioBuffer<float>& buffer)
+        {
+            filter->process(buffer.getWritePointer(0), nullptr, buffer.getNumSamples());
+        };
+    }
+
+    BlockProcessor juceIIRFilter(bool highPass, double sampleRate, int blockSize)
+    {
+        auto filter = std::make_shared<juce::dsp::IIR::Filter<float>>();
+        filter->coefficients = highPass ? juce::dsp::IIR::Coefficients<float>::makeHighPass(sampleRate, cutoff, resonance)
+                                        : juce::dsp::IIR::Coefficients<float>::makeLowPass(sampleRate, cutoff, resonance);
+        filter->prepare(makeSpec(sampleRate, blockSize, 1));
+
+        return [filter](juce::AudioBuffer<float>& buffer)
+        {
+            auto block = firstChannel(buffer);
+            filter->process(juce::dsp::ProcessContextReplacing<float>(block));
+        };
+    }
+
+    BlockProcessor juceStateVariableFilter(bool highPass, int numChannels, double sampleRate, int blockSize)
+    {
+        auto filter = std::make_shared<juce::dsp::StateVariableTPTFilter<float>>();
+        filter->setType(highPass ? juce::dsp::StateVariableTPTFilterType::highpass : juce::dsp::StateVariableTPTFilterType::lowpass);
+        filter->setCutoffFrequency(cutoff);
+        filter->setResonance(resonance);
+        filter->prepare(makeSpec(sampleRate, blockSize, numChannels));
+
+        return [filter, numChannels](juce::AudioBuffer<float>& buffer)
+        {
+            juce::dsp::AudioBlock<float> block(buffer);
+            auto channels = block.getSubsetChannelBlock(0, (size_t)numChannels);
+            filter->process(juce::dsp::ProcessContextReplacing<float>(channels));
+        };
+    }
+
+    BlockProcessor radioBlastMultimodeFilter(double sampleRate, int)
+    {
+        auto filter = std::make_shared<MultimodeFilter>();
+        filter->setMode(MultimodeFilter::LOWPASS);
+        filter->coefficients((float)sampleRate, cutoff, resonance);
+
+        return [filter](juce::AudioBuffer<float>& buffer)
+        {
+            filter->processStereo(buffer.getWritePointer(0), buffer.getWritePointer(1), buffer.getNumSamples());
+        };
+    }
+
+    BlockProcessor juceStereoIIRFilter(double sampleRate, int blockSize)
+    {
+        using StereoFilter = juce::dsp::ProcessorDuplicator<juce::dsp::IIR::Filter<float>, juce::dsp::IIR::Coefficients<float>>;
+
+        auto filter = std::make_shared<StereoFilter>();
+        *filter->state = *juce::dsp::IIR::Coefficients<float>::makeLowPass(sampleRate, cutoff, resonance);
+        filter->prepare(makeSpec(sampleRate, blockSize, 2));
+
+        return [filter](juce::AudioBuffer<float>& buffer)
+        {
+            juce::dsp::AudioBlock<float> block(buffer);
+            filter->process(juce::dsp::ProcessContextReplacing<float>(block));
+        };
+    }
+
+    //==============================================================================
+    BlockProcessor radioBlastDelayLine(double sampleRate, int)
+    {
+        auto delay = std::make_shared<BasicDelayLine>((int)sampleRate, delayMs, feedback, mix);
+
+        return [delay](juce::AudioBuffer<float>& buffer)
+        {
+            auto* data = buffer.getWritePointer(0);
+
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                data[i] = delay->next(data[i]);
+        };
+    }
+
+    // Feedback-Delay wie BasicDelayLine::next(): Ausgang aus Dry/Wet, Rückkopplung in die Leitung
+    BlockProcessor juceFeedbackDelay(double sampleRate, int blockSize)
+    {
+        using DelayLine = juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::Linear>;
+
+        auto delay = std::make_shared<DelayLine>((int)(sampleRate * 2.0));
+        delay->prepare(makeSpec(sampleRate, blockSize, 1));
+        delay->setDelay((float)(delayMs * sampleRate / 1000.0));
+
+        return [delay](juce::AudioBuffer<float>& buffer)
+        {
+            auto* data = buffer.getWritePointer(0);
+
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+            {
+                const float delayed = delay->popSample(0);
+                delay->pushSample(0, data[i] + feedback * delayed);
+                data[i] = (1.0f - mix) * data[i] + mix * delayed;
+            }
+        };
+    }
+
+    BlockProcessor radioBlastFractionalDelay(double sampleRate, int)
+    {
+        auto delay = std::make_shared<FractionalDelayBuffer>();
+        delay->setBufferSize((int)(sampleRate * 2.0));
+        const float delaySamples = (float)(delayMs * sampleRate / 1000.0) + 0.37f;
+
+        return [delay, delaySamples](juce::AudioBuffer<float>& buffer)
+        {
+            auto* data = buffer.getWritePointer(0);
+
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+            {
+                delay->addSample(data[i]);
+                data[i] = delay->getSample(delaySamples);
+            }
+        };
+    }
+
+    BlockProcessor juceFractionalDelay(double sampleRate, int blockSize)
+    {
+        using DelayLine = juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::Linear>;
+
+        auto delay = std::make_shared<DelayLine>((int)(sampleRate * 2.0));
+        delay->prepare(makeSpec(sampleRate, blockSize, 1));
+        delay->setDelay((float)(delayMs * sampleRate / 1000.0) + 0.37f);
+
+        return [delay](juce::AudioBuffer<float>& buffer)
+        {
+            auto* data = buffer.getWritePointer(0);
+
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+            {
+                delay->pushSample(0, data[i]);
+                data[i] = delay->popSample(0);
+            }
+        };
+    }
+
+    //==============================================================================
+    // Hüllkurven: Gate abwechselnd pro Block an und aus, damit alle Phasen vorkommen
+    BlockProcessor radioBlastEnvelope(double sampleRate, int)
+    {
+        auto envelope = std::make_shared<SynthLab::ADSR>();
+        envelope->setAttackRate((float)(0.005 * sampleRate));
+        envelope->setDecayRate((float)(0.05 * sampleRate));
+        envelope->setSustainLevel(0.7f);
+        envelope->setReleaseRate((float)(0.02 * sampleRate));
+        auto gateOn = std::make_shared<bool>(false);
+
+        return [envelope, gateOn](juce::AudioBuffer<float>& buffer)
+        {
+            *gateOn = !*gateOn;
+            envelope->gate(*gateOn ? 1 : 0);
+
+            auto* data = buffer.getWritePointer(0);
+
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                data[i] = envelope->process();
+        };
+    }
+
+    BlockProcessor juceEnvelope(double sampleRate, int)
+    {
+        auto envelope = std::make_shared<juce::ADSR>();
+        envelope->setSampleRate(sampleRate);
+        envelope->setParameters({ 0.005f, 0.05f, 0.7f, 0.02f });
+        auto gateOn = std::make_shared<bool>(false);
+
+        return [envelope, gateOn](juce::AudioBuffer<float>& buffer)
+        {
+            *gateOn = !*gateOn;
+
+            if (*gateOn)
+                envelope->noteOn();
+            else
+                envelope->noteOff();
+
+            auto* data = buffer.getWritePointer(0);
+
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                data[i] = envelope->getNextSample();
+        };
+    }
+
+    BlockProcessor juceNoise(double, int)
+    {
+        auto random = std::make_shared<juce::Random>();
+
+        return [random](juce::AudioBuffer<float>& buffer)
+        {
+            auto* data = buffer.getWritePointer(0);
+
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                data[i] = random->nextFloat() * 0.25f - 0.125f;
+        };
+    }
+
+    //==============================================================================
+    // Musikähnliches Material: Sinusmischung, Rauschen und abklingende Anschläge, Stereo
+    juce::AudioBuffer<float> makeMusicLikeMaterial(int numFrames, double sampleRate)
+    {
+        juce::AudioBuffer<float> material(2, numFrames);
+        juce::Random random(42);
+        const int burstSpacing = (int)(sampleRate * 0.5);
+
+        for (int channel = 0; channel < 2; ++channel)
+        {
+            auto* data = material.getWritePointer(channel);
+            const double detune = channel == 0 ? 1.0 : 1.003;
+
+            for (int i = 0; i < numFrames; ++i)
+            {
+                const double t = i / sampleRate;
+                const double tones = 0.2 * std::sin(juce::MathConstants<double>::twoPi * 110.0 * detune * t)
+                                   + 0.1 * std::sin(juce::MathConstants<double>::twoPi * 440.0 * detune * t)
+                                   + 0.05 * std::sin(juce::MathConstants<double>::twoPi * 3520.0 * detune * t);
+                const double burst = std::exp(-(double)(i % burstSpacing) / (sampleRate * 0.03));
+
+                data[i] = (float)(tones + 0.02 * (random.nextFloat() * 2.0f - 1.0f) + 0.5 * burst * (random.nextFloat() * 2.0f - 1.0f));
+            }
+        }
+
+        return material;
+    }
+
+    // Liest den Track blockweise weiter, wie ein Deck ohne Tempoänderung
+    BlockProcessor compactRead(SampleStorage storage, double sampleRate, int)
+    {
+        const auto material = makeMusicLikeMaterial((int)(sampleRate * 4.0), sampleRate);
+        auto compact = std::make_shared<const CompactSampleBuffer>(material, storage, sampleRate);
+        auto position = std::make_shared<long>(0);
+
+        return [compact, position](juce::AudioBuffer<float>& buffer)
+        {
+            const long length = compact->getNumSamples();
+            compact->read(*position, buffer.getNumSamples(), buffer.getWritePointer(0), buffer.getWritePointer(1), 0, length, true);
+            *position = (*position + buffer.getNumSamples()) % length;
+        };
+    }
+
+    BlockProcessor floatCopy(double sampleRate, int)
+    {
+        auto material = std::make_shared<const juce::AudioBuffer<float>>(makeMusicLikeMaterial((int)(sampleRate * 4.0), sampleRate));
+        auto position = std::make_shared<int>(0);
+
+        return [material, position](juce::AudioBuffer<float>& buffer)
+        {
+            const int run = juce::jmin(buffer.getNumSamples(), material->getNumSamples() - *position);
+
+            for (int channel = 0; channel < 2; ++channel)
+                juce::FloatVectorOperations::copy(buffer.getWritePointer(channel), material->getReadPointer(channel, *position), run);
+
+            *position = (*position + run) % material->getNumSamples();
+        };
+    }
+
+    void printCompactAccuracy()
+    {
+        constexpr double sampleRate = 48000.0;
+        const auto material = makeMusicLikeMaterial(10 * 1000 * 1000, sampleRate);
+        const double floatBytes = (double)material.getNumChannels() * material.getNumSamples() * sizeof(float);
+
+        std::cout << "format            max error   signal/error   size vs float\n";
+
+        for (auto storage : { SampleStorage::int16, SampleStorage::float16 })
+        {
+            const CompactSampleBuffer compact(material, storage, sampleRate);
+            const auto accuracy = compact.measureAccuracy(material);
+
+            std::cout << CompactSampleBuffer::getStorageName(storage).paddedRight(' ', 16)
+                      << juce::String::formatted("%11.2e %11.1f dB %14.2f\n", (double)accuracy.maxError,
+                                                 accuracy.signalToErrorDb, (double)compact.getSizeInBytes() / floatBytes);
+        }
+    }
+
+    //==============================================================================
+    std::vector<BenchmarkDefinition> createBenchmarks()
+    {
+        using namespace std::placeholders;
+        constexpr auto pi = juce::MathConstants<float>::pi;
+
+        return {
+            { "Distortion (soft clip)", "RadioBlast", false, 1, std::bind(radioBlastDistortion, 1, _1, _2) },
+            { "Distortion (soft clip)", "juce::dsp::WaveShaper (tanh)", true, 1,
+              std::bind(juceWaveShaper, [](float x) { return std::tanh(2.0f * x); }, _1, _2) },
+            { "Distortion (hard clip)", "RadioBlast", false, 1, std::bind(radioBlastDistortion, 2, _1, _2) },
+            { "Distortion (hard clip)", "juce::dsp::WaveShaper (clip)", true, 1,
+              std::bind(juceWaveShaper, [](float x) { return juce::jlimit(-1.0f, 1.0f, 2.0f * x); }, _1, _2) },
+
+            { "BasicDelayLine", "RadioBlast", false, 1, radioBlastDelayLine },
+            { "BasicDelayLine", "juce::dsp::DelayLine (feedback)", true, 1, juceFeedbackDelay },
+            { "FractionalDelayBuffer", "RadioBlast", false, 1, radioBlastFractionalDelay },
+            { "FractionalDelayBuffer", "juce::dsp::DelayLine (linear)", true, 1, juceFractionalDelay },
+
+            { "LowPassFilter", "RadioBlast", false, 1, radioBlastMonoFilter<LowPassFilter> },
+            { "LowPassFilter", "juce::dsp::IIR::Filter", true, 1, std::bind(juceIIRFilter, false, _1, _2) },
+            { "LowPassFilter", "juce::dsp::StateVariableTPTFilter", false, 1, std::bind(juceStateVariableFilter, false, 1, _1, _2) },
+            { "HighPassFilter", "RadioBlast", false, 1, radioBlastMonoFilter<HighPassFilter> },
+            { "HighPassFilter", "juce::dsp::IIR::Filter", true, 1, std::bind(juceIIRFilter, true, _1, _2) },
+            { "HighPassFilter", "juce::dsp::StateVariableTPTFilter", false, 1, std::bind(juceStateVariableFilter, true, 1, _1, _2) },
+            { "MultimodeFilter", "RadioBlast", false, 2, radioBlastMultimodeFilter },
+            { "MultimodeFilter", "juce::dsp::ProcessorDuplicator<IIR::Filter>", true, 2, juceStereoIIRFilter },
+            { "MultimodeFilter", "juce::dsp::StateVariableTPTFilter", false, 2, std::bind(juceStateVariableFilter, false, 2, _1, _2) },
+
+            { "ADSR", "RadioBlast", false, 1, radioBlastEnvelope },
+            { "ADSR", "juce::ADSR", true, 1, juceEnvelope },
+
+            { "Sine", "RadioBlast", false, 1, radioBlastOscillator<Sine> },
+            { "Sine", "juce::dsp::Oscillator (std::sin)", true, 1,
+              std::bind(juceOscillator, [](float x) { return std::sin(x); }, (size_t)0, _1, _2) },
+            { "Sine", "juce::dsp::Oscillator (table 128)", false, 1,
+              std::bind(juceOscillator, [](float x) { return std::sin(x); }, (size_t)128, _1, _2) },
+            { "Sawtooth", "RadioBlast", false, 1, radioBlastOscillator<Sawtooth> },
+            { "Sawtooth", "MultimodeOscillator", false, 1, radioBlastOscillator<MultimodeOscillator> },
+            { "Sawtooth", "juce::dsp::Oscillator (naive)", true, 1,
+              std::bind(juceOscillator, [pi](float x) { return x / pi; }, (size_t)0, _1, _2) },
+            { "Pulse", "RadioBlast", false, 1, radioBlastOscillator<Pulse> },
+            { "Pulse", "juce::dsp::Oscillator (naive)", true, 1,
+              std::bind(juceOscillator, [](float x) { return x < 0.0f ? -1.0f : 1.0f; }, (size_t)0, _1, _2) },
+            { "WhiteNoise", "RadioBlast", false, 1, radioBlastOscillator<WhiteNoise> },
+            { "WhiteNoise", "juce::Random", true, 1, juceNoise },
+
+            { "CompactSampleBuffer", "int16", false, 2, std::bind(compactRead, SampleStorage::int16, _1, _2) },
+            { "CompactSampleBuffer", "float16", false, 2, std::bind(compactRead, SampleStorage::float16, _1, _2) },
+            { "CompactSampleBuffer", "float copy", true, 2, floatCopy },
+        };
+    }
+
+    //==============================================================================
+    template <typename ValueType>
+    std::vector<ValueType> parseList(const juce::String& text)
+    {
+        std::vector<ValueType> values;
+
+        for (const auto& token : juce::StringArray::fromTokens(text, ",", ""))
+            if (token.trim().isNotEmpty())
+                values.push_back((ValueType)token.trim().getDoubleValue());
+
+        return values;
+    }
+
+    void printUsage()
+    {
+        std::cout << "usage: RadioBlastDspBench [--rates 44100,48000,96000] [--blocks 64,256,1024]\n"
+                     "                          [--round-ms 20] [--rounds 7] [--filter name]\n"
+                     "                          [--json results.json] [--csv results.csv] [--list]\n"
+                     "       RadioBlastDspBench --accuracy\n";
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    juce::StringArray args;
+
+    for (int i = 1; i < argc; ++i)
+        args.add(juce::CharPointer_UTF8(argv[i]));
+
+    if (args.contains("-h") || args.contains("--help"))
+    {
+        printUsage();
+        return 0;
+    }
+
+    if (args.contains("--accuracy"))
+    {
+        printCompactAccuracy();
+        return 0;
+    }
+
+    const auto benchmarks = createBenchmarks();
+
+    if (args.contains("--list"))
+    {
+        for (const auto& benchmark : benchmarks)
+            std::cout << benchmark.module.paddedRight(' ', 24) << benchmark.implementation
+                      << (benchmark.isReference ? "  (reference)" : "") << "\n";
+        return 0;
+    }
+
+    BenchmarkRunner::Options options;
+    juce::File jsonFile, csvFile;
+    const auto cwd = juce::File::getCurrentWorkingDirectory();
+
+    for (int i = 0; i < args.size(); ++i)
+    {
+        const auto& arg = args[i];
+
+        if (i + 1 >= args.size())
+        {
+            std::cerr << "unknown or incomplete option " << arg << "\n";
+            printUsage();
+            return 1;
+        }
+
+        const auto value = args[++i];
+
+        if (arg == "--rates")            options.sampleRates = parseList<double>(value);
+        else if (arg == "--blocks")      options.blockSizes = parseList<int>(value);
+        else if (arg == "--round-ms")    options.roundMs = juce::jmax(1.0, value.getDoubleValue());
+        else if (arg == "--rounds")      options.numRounds = juce::jmax(1, value.getIntValue());
+        else if (arg == "--filter")      options.filter = value;
+        else if (arg == "--json")        jsonFile = cwd.getChildFile(value);
+        else if (arg == "--csv")         csvFile = cwd.getChildFile(value);
+        else
+        {
+            std::cerr << "unknown option " << arg << "\n";
+            printUsage();
+            return 1;
+        }
+    }
+
+    if (options.sampleRates.empty() || options.blockSizes.empty())
+    {
+        std::cerr << "need at least one sample rate and one block size\n";
+        return 1;
+    }
+
+    std::cout << juce::SystemStats::getCpuModel() << ", " << juce::SystemStats::getOperatingSystemName() << "\n\n"
+              << "module                  implementation                                   rate  block   ns/smp      min   %core\n";
+
+    BenchmarkRunner runner(options);
+
+    const auto results = runner.run(benchmarks, [](const BenchmarkResult& result)
+    {
+        std::cout << result.module.paddedRight(' ', 24) << result.implementation.paddedRight(' ', 44)
+                  << juce::String::formatted("%8.0f %6d %8.2f %8.2f %7.3f\n", result.sampleRate, result.blockSize,
+                                             result.nsPerSample, result.nsPerSampleMin, result.cpuPercent);
+    });
+
+    // Vergleich mit der Referenz erst am Ende, wenn alle Zeilen eines Moduls gemessen sind
+    std::cout << "\nrelative to reference (ns/sample ratio, < 1 is faster):\n";
+
+    for (const auto& result : results)
+        if (result.reference.isNotEmpty())
+            std::cout << result.module.paddedRight(' ', 24) << result.implementation.paddedRight(' ', 44)
+                      << juce::String::formatted("%8.0f %6d %8.2fx  vs %s\n", result.sampleRate, result.blockSize,
+                                                 result.relativeToReference, result.reference.toRawUTF8());
+
+    if (jsonFile != juce::File() && !jsonFile.replaceWithText(runner.toJson(results, "RadioBlastDspBench")))
+    {
+        std::cerr << "cannot write " << jsonFile.getFullPathName() << "\n";
+        return 1;
+    }
+
+    if (csvFile != juce::File() && !csvFile.replaceWithText(BenchmarkRunner::toCsv(results)))
+    {
+        std::cerr << "cannot write " << csvFile.getFullPathName() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
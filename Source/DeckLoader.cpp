@@ -0,0 +1,223 @@
+/*
+  ==============================================================================
+
+    DeckLoader.cpp
+    Created: 16 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "DeckLoader.h"
+#include "AnalysisScheduler.h"
+
+class DeckLoader::LoadJob : public juce::ThreadPoolJob
+{
+public:
+    LoadJob(DeckLoader& loader, const juce::File& fileToLoad, juce::uint32 loadGeneration, bool play)
+        : juce::ThreadPoolJob("Deck Load")
+        , owner(loader)
+        , file(fileToLoad)
+        , generation(loadGeneration)
+        , startPlayback(play)
+    {
+    }
+
+    JobStatus runJob() override
+    {
+        // Bibliotheksanalyse pausiert, solange ein Deck lädt
+        const AnalysisScheduler::ForegroundScope foreground;
+
+        // Öffnen: schon dekodiert aus dem Speicher-Cache, sonst als Stream von der Platte
+        owner.setStage(generation, Stage::opening, 0.0);
+
+        auto track = DecodedTrackCache::getInstance().find(file);
+        std::unique_ptr<StreamingDeckSource> stream;
+
+        if (track == nullptr)
+            stream = owner.sampler.openStream(file);
+
+        if (track == nullptr && stream == nullptr)
+            return fail();
+
+        if (!publish(std::move(stream), std::move(track)))
+            return jobHasFinished;
+
+        // Waveform, BPM, Beatgrid und Loudness in einem blockweisen Durchgang in der Deck-Lane
+        // des Schedulers (oder gleich aus der TrackDatabase); der Track wird dafür nicht ganz dekodiert
+        owner.setStage(generation, Stage::analyzing, 0.0);
+
+        auto& scheduler = AnalysisScheduler::getInstance();
+        auto analysis = scheduler.find(file);
+
+        if (analysis == nullptr)
+        {
+            scheduler.request(file, AnalysisScheduler::Lane::deck);
+
+            while (analysis == nullptr && scheduler.isPending(file))
+            {
+                if (isCancelled())
+                    return jobHasFinished;
+
+                analysis = scheduler.waitFor(file, 100);
+                owner.setStage(generation, Stage::analyzing, scheduler.getProgress(file));
+            }
+
+            if (analysis == nullptr)
+                analysis = scheduler.find(file);
+        }
+
+        if (isCancelled())
+            return jobHasFinished;
+
+        // Nicht analysierbar: der Deck spielt trotzdem, nur ohne Waveform und Beatgrid
+        if (analysis != nullptr)
+        {
+            owner.deliver(generation, [waveform = analysis->waveform](DeckLoader& loader)
+            {
+                if (loader.onWaveformReady != nullptr)
+                    loader.onWaveformReady(waveform);
+            });
+
+            // std::function muss kopierbar sein, daher den Analyzer über einen shared_ptr reichen
+            auto analyzer = std::make_shared<std::unique_ptr<BPMAnalyzer>>(std::make_unique<BPMAnalyzer>());
+            (*analyzer)->setAnalysis(analysis->bpm, analysis->bpmConfidence, analysis->beatGrid);
+
+            owner.deliver(generation, [analyzer](DeckLoader& loader)
+            {
+                if (loader.onAnalysisReady != nullptr)
+                    loader.onAnalysisReady(std::move(*analyzer));
+            });
+        }
+
+        owner.setStage(generation, Stage::ready, 1.0);
+
+        // Die beim Publish ersetzte Quelle ist spätestens jetzt vom Audio Thread losgelassen
+        owner.sampler.releaseRetiredSources();
+        return jobHasFinished;
+    }
+
+private:
+    bool isCancelled() const noexcept
+    {
+        return shouldExit() || !owner.isCurrent(generation);
+    }
+
+    bool publish(std::unique_ptr<StreamingDeckSource> stream, DecodedTrackPtr track)
+    {
+        {
+            const std::lock_guard<std::mutex> guard(owner.publishLock);
+
+            // Eine neuere Ladeanforderung gewinnt, der Stream wird hier auf dem Worker verworfen
+            if (!owner.isCurrent(generation))
+                return false;
+
+            owner.sampler.installSource(std::move(stream), std::move(track));
+
+            if (startPlayback)
+                owner.sampler.play();
+        }
+
+        owner.deliver(generation, [loadedFile = file](DeckLoader& loader)
+        {
+            if (loader.onLoaded != nullptr)
+                loader.onLoaded(loadedFile);
+        });
+
+        return true;
+    }
+
+    JobStatus fail()
+    {
+        owner.setStage(generation, Stage::failed, 0.0);
+        owner.deliver(generation, [failedFile = file](DeckLoader& loader)
+        {
+            if (loader.onFailed != nullptr)
+                loader.onFailed(failedFile);
+        });
+
+        return jobHasFinished;
+    }
+
+    DeckLoader& owner;
+    const juce::File file;
+    const juce::uint32 generation;
+    const bool startPlayback;
+
+    JUCE_DECLARE_NON_COPYABLE(LoadJob)
+};
+
+//==============================================================================
+DeckLoader::DeckLoader(Sampler& deckSampler)
+    : sampler(deckSampler)
+{
+    selfReference = this;
+}
+
+DeckLoader::~DeckLoader()
+{
+    ++latestGeneration;
+    pool.removeAllJobs(true, 4000);
+}
+
+void DeckLoader::load(const juce::File& file, bool startPlayback)
+{
+    const auto generation = ++latestGeneration;
+
+    // Laufende Ladung abbrechen, ohne auf sie zu warten; der Worker bemerkt es zwischen zwei Blöcken
+    pool.removeAllJobs(true, 0);
+    pool.addJob(new LoadJob(*this, file, generation, startPlayback), true);
+}
+
+void DeckLoader::cancel()
+{
+    ++latestGeneration;
+    pool.removeAllJobs(true, 0);
+    stage = Stage::idle;
+
+    if (onProgress != nullptr)
+        onProgress(Stage::idle, 0.0);
+}
+
+bool DeckLoader::isLoading() const noexcept
+{
+    const auto current = stage.load();
+    return current == Stage::opening || current == Stage::analyzing;
+}
+
+juce::String DeckLoader::getStageName(Stage stage)
+{
+    switch (stage)
+    {
+        case Stage::opening:   return "Opening";
+        case Stage::analyzing: return "Analyzing";
+        case Stage::ready:     return "Ready";
+        case Stage::failed:    return "Load failed";
+        case Stage::idle:
+        default:               return {};
+    }
+}
+
+void DeckLoader::setStage(juce::uint32 generation, Stage newStage, double progress)
+{
+    if (!isCurrent(generation))
+        return;
+
+    stage = newStage;
+
+    deliver(generation, [newStage, progress](DeckLoader& loader)
+    {
+        if (loader.onProgress != nullptr)
+            loader.onProgress(newStage, progress);
+    });
+}
+
+void DeckLoader::deliver(juce::uint32 generation, std::function<void(DeckLoader&)> callback)
+{
+    // Nach dem Zerstören des Loaders oder einer neueren Ladung fällt das Ergebnis weg
+    juce::MessageManager::callAsync([weakLoader = selfReference, generation, callback = std::move(callback)]()
+    {
+        if (auto* loader = weakLoader.get())
+            if (loader->isCurrent(generation))
+                callback(*loader);
+    });
+}
@@ -0,0 +1,92 @@
+/*
+  ==============================================================================
+
+    DeckLoader.h
+    Created: 16 Oct 2026
+
+    Loads a track onto a deck without blocking the message thread. Each load
+    runs on the loader's worker thread in stages:
+
+      opening    open the file (or the disk cache) and decode the first
+                 chunk, then hand the source to the Sampler - the deck is
+                 playable from here on
+      analyzing  waveform, BPM and beatgrid: from the TrackDatabase if the
+                 track was analysed before, otherwise the file is requested
+                 on the AnalysisScheduler's deck lane, which reads it block
+                 by block (from the DecodedTrackCache only if it is there
+                 already), so a deck never holds the whole decoded track
+
+    Every load gets a new generation; a newer load stops waiting for the
+    running one and results of a superseded load are dropped. The
+    hand-off to the audio thread is Sampler::installSource, which publishes
+    the new source through an atomic pointer; the replaced one is freed on
+    the worker once the audio thread has let go of it.
+
+    All callbacks are delivered on the message thread.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "AudioEngine/Sampler.h"
+#include "WaveformGenerator.h"
+#include "BPMAnalyzer.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+class DeckLoader
+{
+public:
+    enum class Stage
+    {
+        idle,
+        opening,
+        analyzing,
+        ready,
+        failed
+    };
+
+    explicit DeckLoader(Sampler& deckSampler);
+    ~DeckLoader();
+
+    /** Starts loading file, cancelling whatever this deck was loading before. */
+    void load(const juce::File& file, bool startPlayback);
+
+    /** Drops the running load; the deck keeps whatever was installed already. */
+    void cancel();
+
+    Stage getStage() const noexcept { return stage.load(); }
+    bool isLoading() const noexcept;
+
+    static juce::String getStageName(Stage stage);
+
+    // Message thread
+    std::function<void(Stage, double progress)> onProgress;
+    std::function<void(const juce::File&)> onLoaded;                                   // Deck spielbereit
+    std::function<void(const WaveformGenerator::WaveformData&)> onWaveformReady;
+    std::function<void(std::unique_ptr<BPMAnalyzer>)> onAnalysisReady;
+    std::function<void(const juce::File&)> onFailed;
+
+private:
+    class LoadJob;
+
+    bool isCurrent(juce::uint32 generation) const noexcept { return latestGeneration.load() == generation; }
+
+    void setStage(juce::uint32 generation, Stage newStage, double progress);
+    void deliver(juce::uint32 generation, std::function<void(DeckLoader&)> callback);
+
+    Sampler& sampler;
+    juce::ThreadPool pool { 1 };
+    juce::WeakReference<DeckLoader> selfReference;  // auf dem Message Thread angelegt, Worker kopieren nur
+
+    std::atomic<juce::uint32> latestGeneration { 0 };
+    std::atomic<Stage> stage { Stage::idle };
+    std::mutex publishLock;     // Prüfen der Generation und Übergabe an den Sampler gemeinsam
+
+    JUCE_DECLARE_WEAK_REFERENCEABLE(DeckLoader)
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DeckLoader)
+};
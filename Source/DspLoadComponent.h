@@ -0,0 +1,164 @@
+/*
+  ==============================================================================
+
+    DspLoadComponent.h
+    Created: 16 Oct 2026
+
+    Dockable "DSP Load" panel: per-stage callback times from the
+    DspLoadMonitor (min / mean / p99 / max over the last callbacks, with a
+    bar for the p99 against the block duration), the total load, deadline
+    misses, the device's xrun count and the decks' disk stream underruns.
+    Built with RADIOBLAST_RT_SANITIZER also the real-time violations
+    caught on the audio thread.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <functional>
+#include "AudioEngine/DspLoadMonitor.h"
+#include "AudioEngine/RealtimeSanitizer.h"
+
+class DspLoadComponent : public juce::Component, public juce::Timer
+{
+public:
+    explicit DspLoadComponent(DspLoadMonitor& monitorToShow)
+        : monitor(monitorToShow)
+    {
+        resetButton.onClick = [this]()
+        {
+            monitor.reset();
+            RealtimeSanitizer::reset();
+            xrunsAtReset = getXRunCount != nullptr ? getXRunCount() : -1;
+            underrunsAtReset = getUnderrunCount != nullptr ? getUnderrunCount() : 0;
+        };
+        addAndMakeVisible(resetButton);
+
+        startTimerHz(4);
+    }
+
+    ~DspLoadComponent() override
+    {
+        stopTimer();
+    }
+
+    // Xrun-Zähler des Audio Device, -1 wenn das Device keinen liefert
+    std::function<int()> getXRunCount;
+
+    // Blöcke, die ein Deck-Stream nicht rechtzeitig von der Platte hatte
+    std::function<int()> getUnderrunCount;
+
+    void timerCallback() override
+    {
+        snapshot = monitor.collect();
+        xruns = getXRunCount != nullptr ? getXRunCount() : -1;
+        underruns = getUnderrunCount != nullptr ? getUnderrunCount() : -1;
+        repaint();
+    }
+
+    void paint(juce::Graphics& g) override
+    {
+        g.fillAll(juce::Colour(0xff222222));
+
+        auto area = getLocalBounds().reduced(8);
+
+        g.setColour(juce::Colours::white);
+        g.setFont(16.0f);
+        g.drawText("DSP Load", area.removeFromTop(24), juce::Justification::centredLeft);
+
+        g.setFont(12.0f);
+        auto header = area.removeFromTop(rowHeight);
+        drawRow(g, header, "Stage", "min", "mean", "p99", "max", juce::Colours::grey);
+
+        for (int stage = 0; stage < DspLoadMonitor::numStages; ++stage)
+        {
+            const auto& stats = snapshot.stages[(size_t)stage];
+            auto row = area.removeFromTop(rowHeight);
+
+            drawLoadBar(g, row, stats.p99Ms);
+            drawRow(g, row, DspLoadMonitor::getStageName((DspLoadMonitor::Stage)stage),
+                    formatTime(stats.minMs), formatTime(stats.meanMs), formatTime(stats.p99Ms), formatTime(stats.maxMs),
+                    juce::Colours::lightgrey);
+        }
+
+        auto total = area.removeFromTop(rowHeight);
+        drawLoadBar(g, total, snapshot.callback.p99Ms);
+        drawRow(g, total, "Callback", formatTime(snapshot.callback.minMs), formatTime(snapshot.callback.meanMs),
+                formatTime(snapshot.callback.p99Ms), formatTime(snapshot.callback.maxMs), juce::Colours::white);
+
+        area.removeFromTop(6);
+
+        const bool overloaded = snapshot.deadlineMisses > 0 || (xruns >= 0 && xruns > xrunsAtReset);
+        g.setColour(overloaded ? juce::Colours::orangered : juce::Colours::lightgreen);
+
+        g.drawText("Load " + juce::String(snapshot.loadPercent, 1) + " %  of " + juce::String(snapshot.budgetMs, 2) + " ms",
+                   area.removeFromTop(rowHeight), juce::Justification::centredLeft);
+
+        const juce::String xrunText = xruns >= 0 ? juce::String(xruns - juce::jmax(0, xrunsAtReset)) : juce::String("n/a");
+        const juce::String underrunText = underruns >= 0 ? juce::String(underruns - underrunsAtReset) : juce::String("n/a");
+        g.drawText("Deadline misses " + juce::String(snapshot.deadlineMisses) + "   XRuns " + xrunText
+                       + "   Underruns " + underrunText + "   Dropped " + juce::String(snapshot.droppedBlocks),
+                   area.removeFromTop(rowHeight), juce::Justification::centredLeft);
+
+       #if RADIOBLAST_RT_SANITIZER
+        // Details im Report auf stderr beim Beenden
+        const auto violations = RealtimeSanitizer::getViolationCount();
+        g.setColour(violations > 0 ? juce::Colours::orangered : juce::Colours::lightgreen);
+        g.drawText("RT violations " + juce::String(violations) + " at " + juce::String(RealtimeSanitizer::getNumCallSites())
+                       + " call sites" + (RealtimeSanitizer::isInterposing() ? "" : "  (no libc hooks)"),
+                   area.removeFromTop(rowHeight), juce::Justification::centredLeft);
+       #endif
+    }
+
+    void resized() override
+    {
+        resetButton.setBounds(getWidth() - 68, 6, 60, 20);
+    }
+
+private:
+    static constexpr int rowHeight = 18;
+
+    static juce::String formatTime(double ms)
+    {
+        // Mikrosekunden, die Stages liegen meist weit unter einer Millisekunde
+        return juce::String(ms * 1000.0, 1);
+    }
+
+    void drawLoadBar(juce::Graphics& g, juce::Rectangle<int> row, double ms) const
+    {
+        if (snapshot.budgetMs <= 0.0)
+            return;
+
+        const double fraction = juce::jlimit(0.0, 1.0, ms / snapshot.budgetMs);
+        const auto colour = fraction < 0.5 ? juce::Colours::green : (fraction < 0.8 ? juce::Colours::yellow : juce::Colours::red);
+
+        g.setColour(colour.withAlpha(0.35f));
+        g.fillRect(row.withWidth((int)(row.getWidth() * fraction)).reduced(0, 1));
+    }
+
+    static void drawRow(juce::Graphics& g, juce::Rectangle<int> row, const juce::String& name,
+                        const juce::String& min, const juce::String& mean, const juce::String& p99, const juce::String& max,
+                        juce::Colour colour)
+    {
+        g.setColour(colour);
+
+        const int valueWidth = juce::jmax(40, (row.getWidth() - 110) / 4);
+        g.drawText(name, row.removeFromLeft(110), juce::Justification::centredLeft);
+
+        for (const auto& value : { min, mean, p99, max })
+            g.drawText(value, row.removeFromLeft(valueWidth), juce::Justification::centredRight);
+    }
+
+    DspLoadMonitor& monitor;
+    DspLoadMonitor::Snapshot snapshot;
+    int xruns = -1;
+    int xrunsAtReset = 0;
+    int underruns = -1;
+    int underrunsAtReset = 0;
+
+    juce::TextButton resetButton { "Reset" };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DspLoadComponent)
+};
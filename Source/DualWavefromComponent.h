@@ -10,6 +10,7 @@
 #pragma once
 #include <JuceHeader.h>
 #include "WaveformGenerator.h"
+#include "AudioEngine/BeatGrid.h"
 
 class DualWaveformComponent : public juce::Component,
     public juce::Timer,
@@ -106,12 +107,20 @@ public:
         drawTimeGrid(g, deck1Area, startTime, endTime);
         drawTimeGrid(g, deck2Area, startTime, endTime);
 
+        // Beatgrid aus der Analyse, Downbeats heller
+        drawBeatGrid(g, deck1Area, deck1BeatGrid, startTime, endTime, juce::Colours::cyan);
+        drawBeatGrid(g, deck2Area, deck2BeatGrid, startTime, endTime, juce::Colours::orange);
+
         // Draw waveforms using WaveformGenerator
         WaveformGenerator::drawWaveform(g, deck1Waveform, juce::Rectangle<float>(deck1Area.toFloat()),
             juce::Colours::cyan.withAlpha(0.7f), zoomFactor);
         WaveformGenerator::drawWaveform(g, deck2Waveform, juce::Rectangle<float>(deck2Area.toFloat()),
             juce::Colours::orange.withAlpha(0.7f), zoomFactor);
 
+        // Ladefortschritt (DeckLoader) mittig ber der Waveform
+        drawLoadProgress(g, deck1Area, deck1LoadProgress, deck1LoadStage, juce::Colours::cyan);
+        drawLoadProgress(g, deck2Area, deck2LoadProgress, deck2LoadStage, juce::Colours::orange);
+
         // Draw playback position markers - MIT OFFSET!
         drawPlaybackMarker(g, deck1Area, deck1Position, startTime, endTime,
             juce::Colours::cyan, deck1Playing, 0.0);
@@ -160,12 +169,30 @@ public:
             deck1Length = 0.0;
             deck1Position = 0.0;
             deck1Playing = false;
+            deck1BeatGrid = BeatGrid();
         }
         else if (deck == 1)
         {
             deck2Length = 0.0;
             deck2Position = 0.0;
             deck2Playing = false;
+            deck2BeatGrid = BeatGrid();
+        }
+        repaint();
+    }
+
+    // Ladefortschritt eines Decks, progress < 0 blendet die Anzeige aus
+    void setLoadProgress(int deck, double progress, const juce::String& stageName)
+    {
+        if (deck == 0)
+        {
+            deck1LoadProgress = progress;
+            deck1LoadStage = stageName;
+        }
+        else if (deck == 1)
+        {
+            deck2LoadProgress = progress;
+            deck2LoadStage = stageName;
         }
         repaint();
     }
@@ -280,6 +307,20 @@ public:
         return (deck == 0) ? deck1BPM : deck2BPM;
     }
 
+    // Beatgrid eines Decks (aus BPMAnalyzer), ungltiges Grid blendet es aus
+    void setBeatGrid(int deck, const BeatGrid& grid)
+    {
+        if (deck == 0)
+        {
+            deck1BeatGrid = grid;
+        }
+        else if (deck == 1)
+        {
+            deck2BeatGrid = grid;
+        }
+        repaint();
+    }
+
     // === ENHANCED MOUSE HANDLING ===
     void mouseDown(const juce::MouseEvent& e) override
     {
@@ -486,6 +527,16 @@ private:
     double deck1BPM = 0.0;
     double deck2BPM = 0.0;
 
+    // Beatgrids fr die Schlaglinien
+    BeatGrid deck1BeatGrid;
+    BeatGrid deck2BeatGrid;
+
+    // Ladefortschritt je Deck, -1 = kein Ladevorgang
+    double deck1LoadProgress = -1.0;
+    double deck2LoadProgress = -1.0;
+    juce::String deck1LoadStage;
+    juce::String deck2LoadStage;
+
     void startScrubbing(int deck, double position)
     {
         isDragging = true;
@@ -681,6 +732,39 @@ private:
         }
     }
 
+    void drawBeatGrid(juce::Graphics& g, juce::Rectangle<int> area, const BeatGrid& grid,
+        double startTime, double endTime, juce::Colour colour)
+    {
+        double duration = endTime - startTime;
+
+        if (!grid.isValid() || duration <= 0.0)
+            return;
+
+        double pixelsPerSecond = area.getWidth() / duration;
+        int firstBeat = (int)std::floor(grid.getBeatPosition(startTime));
+        int lastBeat = juce::jmin(grid.getNumBeats() - 1, (int)std::ceil(grid.getBeatPosition(endTime)));
+
+        // Weit herausgezoomt nur noch Downbeats, sonst wird die Flche nur grau
+        bool downbeatsOnly = grid.getBeatTime(firstBeat + 1) - grid.getBeatTime(firstBeat) < 4.0 / pixelsPerSecond;
+
+        if (downbeatsOnly && (grid.getBeatTime(firstBeat + grid.beatsPerBar) - grid.getBeatTime(firstBeat)) < 4.0 / pixelsPerSecond)
+            return;
+
+        for (int beat = juce::jmax(0, firstBeat); beat <= lastBeat; ++beat)
+        {
+            bool isDownbeat = grid.isDownbeat(beat);
+
+            if (downbeatsOnly && !isDownbeat)
+                continue;
+
+            double relativePos = (grid.getBeatTime(beat) - startTime) / duration;
+            int x = area.getX() + (int)(relativePos * area.getWidth());
+
+            g.setColour(colour.withAlpha(isDownbeat ? 0.6f : 0.25f));
+            g.drawVerticalLine(x, (float)area.getY(), (float)area.getBottom());
+        }
+    }
+
     void drawTimeGrid(juce::Graphics& g, juce::Rectangle<int> area,
         double startTime, double endTime)
     {
@@ -879,6 +963,29 @@ private:
         }
     }
 
+    void drawLoadProgress(juce::Graphics& g, juce::Rectangle<int> area, double progress,
+        const juce::String& stageName, juce::Colour colour)
+    {
+        if (progress < 0.0) return;
+
+        auto barArea = area.withSizeKeepingCentre(juce::jmin(240, area.getWidth() - 20), 6);
+        auto textArea = barArea.translated(0, -18).withHeight(14);
+
+        // Hintergrund, damit die Anzeige auch ber einer alten Waveform lesbar bleibt
+        g.setColour(juce::Colours::black.withAlpha(0.6f));
+        g.fillRoundedRectangle(textArea.getUnion(barArea).toFloat().expanded(6.0f, 4.0f), 4.0f);
+
+        g.setColour(colour);
+        g.setFont(11.0f);
+        g.drawText(stageName, textArea, juce::Justification::centred);
+
+        g.setColour(juce::Colours::darkgrey);
+        g.fillRoundedRectangle(barArea.toFloat(), 3.0f);
+
+        g.setColour(colour);
+        g.fillRoundedRectangle(barArea.withWidth((int)(juce::jlimit(0.0, 1.0, progress) * barArea.getWidth())).toFloat(), 3.0f);
+    }
+
     void drawBPMDisplay(juce::Graphics& g, juce::Rectangle<int> displayArea,
         double bpm, juce::Colour colour, bool isPlaying)
     {
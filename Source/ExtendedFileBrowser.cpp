@@ -9,6 +9,7 @@
 #include "ExtendedFileBrowser.h"
 #include "../JuceLibraryCode/JuceHeader.h"
 #include "AudioManager.h"
+#include "AnalysisScheduler.h"
 
 using juce::File;
 using juce::WildcardFileFilter;
@@ -177,6 +178,24 @@ void ExtendedFileBrowser::mouseDown(const juce::MouseEvent &event) {
     isDragging = false;
     dragStartPosition = event.getPosition();
 
+    // Rechtsklick: aktuellen Ordner im Hintergrund analysieren (BPM, Beatgrid, Waveform, Loudness)
+    if (event.mods.isPopupMenu()) {
+        juce::PopupMenu menu;
+        menu.addItem(1, "Analyze this folder");
+        menu.addItem(2, "Analyze this folder and subfolders");
+        menu.addItem(3, "Stop folder analysis", AnalysisScheduler::getInstance().getNumPending(AnalysisScheduler::Lane::library) > 0);
+
+        juce::File folder(model->getCurrentDir());
+
+        menu.showMenuAsync(juce::PopupMenu::Options(), [folder](int result) {
+            if (result == 1 || result == 2)
+                AnalysisScheduler::getInstance().requestFolder(folder, result == 2);
+            else if (result == 3)
+                AnalysisScheduler::getInstance().cancelLane(AnalysisScheduler::Lane::library);
+        });
+        return;
+    }
+
     if (table->getSelectedRow() > 0) {
         File* f = new File(model->getDirectoryList()->getFile(table->getSelectedRow()));
         if (f->exists()) {
@@ -207,11 +226,13 @@ void ExtendedFileBrowser::mouseDoubleClick(const juce::MouseEvent &event) {
                         f->getFileExtension().toLowerCase().contains("aif") ||
                         f->getFileExtension().toLowerCase().contains("ogg")) {
                         sampler->stop();
-                        sampler->loadSample(*f);
-                        if (onTrackLoadedCallback) {
-						    onTrackLoadedCallback(*f, left);
+                        if (onLoadRequestedCallback) {
+						    onLoadRequestedCallback(*f, left);
+                        }
+                        else {
+                            sampler->loadSample(*f);
+                            sampler->play();
                         }
-                        sampler->play();
                     }
                 }
                 else {
@@ -63,11 +63,12 @@ public:
     ExtendedFileBrowser(const juce::File& initialFileOrDirectory,const juce::WildcardFileFilter* fileFilter, FileBrowserModel* model, bool left);
     ~ExtendedFileBrowser();
     
-    std::function<void(const juce::File&, bool)> onTrackLoadedCallback;
+    // Doppelklick auf einen Track: Laden übernimmt der Empfänger (asynchron), ohne Callback lädt der Browser selbst
+    std::function<void(const juce::File&, bool)> onLoadRequestedCallback;
 
-    void setTrackLoadedCallback(std::function<void(const juce::File&, bool)> callback)
+    void setLoadRequestedCallback(std::function<void(const juce::File&, bool)> callback)
     {
-        onTrackLoadedCallback = callback;
+        onLoadRequestedCallback = callback;
     }
 
     bool isValidDirectory(const juce::File& dir);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "AudioEngine/EngineParameters.h"
 
 
 using juce::Slider;
@@ -352,6 +353,18 @@ public:
         masterVolumeLabel.setColour(juce::Label::textColourId, juce::Colours::white);
         masterVolumeLabel.setJustificationType(juce::Justification::centred);
 
+        // Jede Parameter-nderung an die Audio-Engine melden
+        for (auto* knob : { &filterSection.cutoffKnob, &filterSection.resonanceKnob, &filterSection.driveKnob,
+                            &eqSection.lowKnob, &eqSection.midKnob, &eqSection.highKnob,
+                            &eqSection.lowFreqKnob, &eqSection.highFreqKnob,
+                            &chorusSection.rateKnob, &chorusSection.depthKnob,
+                            &chorusSection.feedbackKnob, &chorusSection.mixKnob,
+                            &reverbSection.roomSizeKnob, &reverbSection.dampingKnob, &reverbSection.wetKnob,
+                            &reverbSection.dryKnob, &reverbSection.widthKnob, &masterVolumeKnob })
+            knob->onValueChange = [this] { notifyParametersChanged(); };
+
+        filterSection.typeCombo.onChange = [this] { notifyParametersChanged(); };
+
         setSize(950, 700); // Grer fr besseres Layout
     }
 
@@ -422,6 +435,41 @@ public:
         reverbSection.setBounds(bottomRow.removeFromLeft(280));
     }
 
+    // Message Thread: aktuellen FX-Zustand in den Engine-Snapshot schreiben
+    void fillEngineParameters(EngineParameters& params) const
+    {
+        params.filter.cutoff = (float)filterSection.cutoffKnob.getValue();
+        params.filter.resonance = (float)filterSection.resonanceKnob.getValue();
+        params.filter.drive = (float)filterSection.driveKnob.getValue();
+        params.filter.type = filterSection.typeCombo.getSelectedId() - 1; // ComboBox IDs starten bei 1
+        params.filter.bypass = filterBypass.getToggleState();
+
+        params.eq.lowGainDb = (float)eqSection.lowKnob.getValue();
+        params.eq.midGainDb = (float)eqSection.midKnob.getValue();
+        params.eq.highGainDb = (float)eqSection.highKnob.getValue();
+        params.eq.lowFreq = (float)eqSection.lowFreqKnob.getValue();
+        params.eq.highFreq = (float)eqSection.highFreqKnob.getValue();
+        params.eq.bypass = eqBypass.getToggleState();
+
+        params.chorus.rate = (float)chorusSection.rateKnob.getValue();
+        params.chorus.depth = (float)chorusSection.depthKnob.getValue();
+        params.chorus.feedback = (float)chorusSection.feedbackKnob.getValue();
+        params.chorus.mix = (float)chorusSection.mixKnob.getValue();
+        params.chorus.bypass = chorusBypass.getToggleState();
+
+        params.reverb.roomSize = (float)reverbSection.roomSizeKnob.getValue();
+        params.reverb.damping = (float)reverbSection.dampingKnob.getValue();
+        params.reverb.wetLevel = (float)reverbSection.wetKnob.getValue();
+        params.reverb.dryLevel = (float)reverbSection.dryKnob.getValue();
+        params.reverb.width = (float)reverbSection.widthKnob.getValue();
+        params.reverb.bypass = reverbBypass.getToggleState();
+
+        params.masterVolumeDb = (float)masterVolumeKnob.getValue();
+    }
+
+    // Wird auf dem Message Thread aufgerufen, sobald sich ein FX-Parameter ndert
+    std::function<void()> onParametersChanged;
+
     // ffentliche Member fr Parameter Binding
     juce::ToggleButton filterBypass, eqBypass, chorusBypass, reverbBypass;
     Slider masterVolumeKnob;
@@ -445,9 +493,16 @@ private:
         button.onClick = [this, &button]()
             {
                 repaint(); // LED Update
+                notifyParametersChanged();
             };
     }
 
+    void notifyParametersChanged()
+    {
+        if (onParametersChanged)
+            onParametersChanged();
+    }
+
     void drawStatusLED(juce::Graphics& g, juce::Point<int> position, bool isActive, const juce::String& label)
     {
         auto ledBounds = juce::Rectangle<float>(position.x, position.y, 15, 15);
@@ -10,10 +10,17 @@
 
 #pragma once
 #include <JuceHeader.h>
+#include "AudioEngine/LevelMeterSource.h"
 
 class LevelMeter : public juce::Component, public juce::Timer
 {
 public:
+    enum class Scale
+    {
+        linear,     // RMS 0..1 as is
+        decibels    // -60 dB .. 0 dB mapped to 0..1
+    };
+
     LevelMeter()
     {
         setSize(20, 200);
@@ -87,10 +94,30 @@ public:
         }
     }
 
+    /**
+        Lets the meter poll its levels from the engine on every timer tick:
+        the bar shows the RMS, the peak hold the true peak since the last
+        tick. channel -1 shows the louder of both channels. The source must
+        outlive the meter or be detached with nullptr.
+    */
+    void setSource(LevelMeterSource* newSource, int newChannel = -1, Scale newScale = Scale::linear)
+    {
+        source = newSource;
+        channel = newChannel;
+        scale = newScale;
+        reset();
+    }
+
     void setLevel(float newLevel)
+    {
+        setLevels(newLevel, newLevel);
+    }
+
+    void setLevels(float newLevel, float newPeak)
     {
         // Smooth level changes with decay
         float targetLevel = juce::jlimit(0.0f, 1.0f, newLevel);
+        float targetPeak = juce::jlimit(0.0f, 1.0f, newPeak);
 
         if (targetLevel > currentLevel)
         {
@@ -98,14 +125,14 @@ public:
         }
         else
         {
-            // Slower decay
-            currentLevel = currentLevel * 0.95f + targetLevel * 0.05f;
+            // Slower decay, per update (the source is polled at the timer rate)
+            currentLevel = currentLevel * 0.85f + targetLevel * 0.15f;
         }
 
         // Update peak hold
-        if (targetLevel > peakLevel)
+        if (targetPeak > peakLevel)
         {
-            peakLevel = targetLevel;
+            peakLevel = targetPeak;
             peakHoldCounter = 0;
         }
     }
@@ -118,8 +145,26 @@ public:
     }
 
 private:
+    static float toDisplay(float gain, Scale displayScale)
+    {
+        if (displayScale == Scale::linear)
+            return gain;
+
+        // Logarithmic scaling for better visibility
+        if (gain < 0.001f)
+            return 0.0f;
+
+        return juce::jlimit(0.0f, 1.0f, (juce::Decibels::gainToDecibels(gain) + 60.0f) / 60.0f);
+    }
+
     void timerCallback() override
     {
+        if (source != nullptr)
+        {
+            const auto reading = channel < 0 ? source->pollBoth() : source->poll(channel);
+            setLevels(toDisplay(reading.rms, scale), toDisplay(reading.peak, scale));
+        }
+
         // Peak hold decay
         peakHoldCounter++;
         if (peakHoldCounter > 20) // Hold peak for 2 seconds at 30fps
@@ -136,5 +181,9 @@ private:
     float peakLevel = 0.0f;
     int peakHoldCounter = 0;
 
+    LevelMeterSource* source = nullptr;
+    int channel = -1;
+    Scale scale = Scale::linear;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LevelMeter)
 };
\ No newline at end of file
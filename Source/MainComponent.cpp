@@ -1,5 +1,7 @@
 ﻿#include "MainComponent.h"
 #include "FXComponent.h"
+#include "AudioEngine/RealtimeSanitizer.h"
+#include "AnalysisScheduler.h"
 
 
 //==============================================================================
@@ -60,9 +62,33 @@ MainComponent::MainComponent()
 	fxComponent->filterBypass.setToggleState(true, juce::sendNotification);
 	fxComponent->eqBypass.setToggleState(true, juce::sendNotification);
 
+	// Parameter-Snapshot für die Audio-Engine: bei jeder Änderung neu veröffentlichen
+	mixer->onParametersChanged = [this]() { publishEngineParameters(); };
+	fxComponent->onParametersChanged = [this]() { publishEngineParameters(); };
+	publishEngineParameters();
+
+	// Deck A, Deck B und Master je mit eigenem Meter, ohne Nachrichten vom Audio-Thread
+	auto& meters = mixEngine.getMeters();
+	mixer->attachLevelMeters(&meters.deckA, &meters.deckB, &meters.master);
+
 	midiMonitor = std::make_unique<MidiMonitorComponent>();
 	stutterEffect = std::make_unique<StutterEffectComponent>();
 
+	// Mischpult-Kern ohne UI: Decks, Sample Slots und Stutter werden nur angehängt
+	mixEngine.setDeck(0, leftFileBrowser->getSampler());
+	mixEngine.setDeck(1, rightFileBrowser->getSampler());
+	mixEngine.setSampleSlots(&samplePlayer->getSlotBank());
+	mixEngine.setStutter(&stutterEffect->getProcessor());
+
+	dspLoadPanel = std::make_unique<DspLoadComponent>(mixEngine.getDspLoadMonitor());
+	dspLoadPanel->getXRunCount = [this]() {
+		auto* device = deviceManager.getCurrentAudioDevice();
+		return device != nullptr ? device->getXRunCount() : -1;
+	};
+	dspLoadPanel->getUnderrunCount = [this]() {
+		return leftFileBrowser->getSampler()->getStreamUnderrunCount() + rightFileBrowser->getSampler()->getStreamUnderrunCount();
+	};
+
 	// AudioDeviceManager initialisieren
 	// Add visible components
 	int width = getLocalBounds().getWidth();
@@ -76,6 +102,7 @@ MainComponent::MainComponent()
 	advancedDock.addComponentToNewColumn(rightPlayList.get(),1, 2,  width / 4);
 	advancedDock.addComponentToNewColumn(midiMonitor.get(), 1, 3, width / 4);
 	advancedDock.addComponentToNewColumn(stutterEffect.get(), 1, 3, width / 4);
+	advancedDock.addComponentToNewColumn(dspLoadPanel.get(), 1, 4, width / 4);
 
 	leftFileBrowser->setName("Browser A");
 	rightFileBrowser->setName("Browser B");
@@ -86,6 +113,7 @@ MainComponent::MainComponent()
 	fxComponent->setName("FX");
 	midiMonitor->setName("MIDI Monitor");
 	stutterEffect->setName("Stutter FX");
+	dspLoadPanel->setName("DSP Load");
 
 	advancedDock.addComponentToNewRow(wave.get(), 2);
 
@@ -115,37 +143,22 @@ MainComponent::MainComponent()
 	setupMidiInputs();
 	startThread(); // file watcher
 
+	// Tempo der Line-Eingänge schätzen und im Mixer anzeigen, der Audio Thread sammelt nur die Onsets
+	startTimerHz(10);
 
-	if (leftFileBrowser)
-	{
-		leftFileBrowser->setTrackLoadedCallback([this](const juce::File& file, bool left) {
-			onTrackLoaded(file, true); // true = left deck
-			});
-	}
 
-	if (rightFileBrowser)
-	{
-		rightFileBrowser->setTrackLoadedCallback([this](const juce::File& file, bool left) {
-			onTrackLoaded(file, false); // false = right deck
-			});
-	}
+	setupDeckLoaders();
 
+	leftFileBrowser->setLoadRequestedCallback([this](const juce::File& file, bool left) {
+		loadDeck(0, file);
+		});
 
-	leftPlayList->onFileSelected = [this](const juce::File& file) {
-		// Datei in Audio-Engine laden und abspielen
-		onTrackLoaded(file, true);
-		leftFileBrowser->getSampler()->loadSample(file);
-		leftFileBrowser->getSampler()->play();
-		int deck = 0; // Left deck
-
-		WaveformGenerator::generateWaveformDataAsync(file, 2000,
-			[this, deck](WaveformGenerator::WaveformData data) {
-				if (data.isValid)
-				{
-					wave->setWaveformData(deck, data);
-				}
-			});
+	rightFileBrowser->setLoadRequestedCallback([this](const juce::File& file, bool left) {
+		loadDeck(1, file);
+		});
 
+	leftPlayList->onFileSelected = [this](const juce::File& file) {
+		loadDeck(0, file);
 		};
 
 	leftPlayList->onPlaylistFinished = [this]() {
@@ -153,32 +166,28 @@ MainComponent::MainComponent()
 		};
 
 	rightPlayList->onFileSelected = [this](const juce::File& file) {
-		// Datei in Audio-Engine laden und abspielen
-		onTrackLoaded(file, false);
-		rightFileBrowser->getSampler()->loadSample(file);
-		rightFileBrowser->getSampler()->play();
-		int deck = 1; // right deck
-
-		WaveformGenerator::generateWaveformDataAsync(file, 2000,
-			[this, deck](WaveformGenerator::WaveformData data) {
-				if (data.isValid)
-				{
-					wave->setWaveformData(deck, data);
-				}
-			});
-
+		loadDeck(1, file);
 		};
 
 
 	wave->onPositionChanged = [this](int deck, double pos, bool playing) {
+		// Positionen zählen in Frames des geladenen Materials
 		if (deck == 0)  {
-			leftFileBrowser->getSampler()->setCurrentPosition((long)(pos * deviceManager.getCurrentAudioDevice()->getCurrentSampleRate()));
+			auto* sampler = leftFileBrowser->getSampler();
+			sampler->setCurrentPosition((long)(pos * sampler->getSourceSampleRate()));
 		}
 		else if (deck == 1) {
-			rightFileBrowser->getSampler()->setCurrentPosition((long)(pos * deviceManager.getCurrentAudioDevice()->getCurrentSampleRate()));
+			auto* sampler = rightFileBrowser->getSampler();
+			sampler->setCurrentPosition((long)(pos * sampler->getSourceSampleRate()));
 		}
 	};
 
+	// Klick bzw. "Set Cue Point" setzt Hot Cue 1 des Decks, der Streaming-Cache hält die Stelle vorrätig
+	wave->onPositionClicked = [this](int deck, double pos) {
+		auto* sampler = deck == 0 ? leftFileBrowser->getSampler() : rightFileBrowser->getSampler();
+		sampler->setHotCue(0, (long)(pos * sampler->getSourceSampleRate()));
+	};
+
 	wave->onScrubStart = [this](int deck, double pos) {
 		if (deck == 0) {
 		
@@ -202,8 +211,6 @@ MainComponent::MainComponent()
 
 	};
 
-	updateFXParameters();
-
 	resized();
 
 	layoutManager.loadLayoutOnStartup();
@@ -211,10 +218,60 @@ MainComponent::MainComponent()
 
 MainComponent::~MainComponent()
 {
+	stopTimer();
+
+	// Hintergrundanalyse beenden, solange Message Loop, Datenbank und Playlists noch leben
+	AnalysisScheduler::getInstance().shutdown();
+
 	layoutManager.saveLayoutOnShutdown();
 	setLookAndFeel(nullptr);
 	cleanupMidiInputs();
 	shutdownAudio();
+
+	// Die Meter-Quellen gehören der Engine, die vor dem Mixer zerstört wird
+	if (mixer)
+		mixer->attachLevelMeters(nullptr, nullptr, nullptr);
+}
+
+void MainComponent::setupDeckLoaders()
+{
+	Sampler* samplers[] = { leftFileBrowser->getSampler(), rightFileBrowser->getSampler() };
+
+	for (int deck = 0; deck < (int)deckLoaders.size(); ++deck)
+	{
+		auto loader = std::make_unique<DeckLoader>(*samplers[deck]);
+
+		loader->onProgress = [this, deck](DeckLoader::Stage stage, double progress) {
+			// Fortschritt nur während des Ladens, ein Fehler bleibt bis zum nächsten Load stehen
+			const bool visible = stage != DeckLoader::Stage::idle && stage != DeckLoader::Stage::ready;
+			wave->setLoadProgress(deck, visible ? progress : -1.0, DeckLoader::getStageName(stage));
+			};
+
+		loader->onWaveformReady = [this, deck](const WaveformGenerator::WaveformData& data) {
+			if (data.isValid)
+			{
+				wave->setWaveformData(deck, data);
+			}
+			};
+
+		loader->onAnalysisReady = [this, deck](std::unique_ptr<BPMAnalyzer> analyzer) {
+			if (analyzer != nullptr)
+				wave->setBeatGrid(deck, analyzer->getBeatGrid());
+
+			mixer->setBPMAnalysis(deck == 0, std::move(analyzer));
+			};
+
+		deckLoaders[deck] = std::move(loader);
+	}
+}
+
+void MainComponent::loadDeck(int deck, const juce::File& audioFile)
+{
+	if (!juce::isPositiveAndBelow(deck, (int)deckLoaders.size()) || deckLoaders[deck] == nullptr)
+		return;
+
+	wave->setLoadProgress(deck, 0.0, DeckLoader::getStageName(DeckLoader::Stage::opening));
+	deckLoaders[deck]->load(audioFile, true);
 }
 
 void MainComponent::setupMidiInputs()
@@ -276,6 +333,38 @@ juce::PopupMenu MainComponent::getMenuForIndex(int topLevelMenuIndex, const juce
 	{
 		menu.addItem(audioSettings, "Audio Settings...", true);
 		menu.addItem(midiSettings, "MIDI Settings...", true);
+
+		// Interpolation beim Pitchen, gilt für beide Decks
+		juce::PopupMenu resamplingMenu;
+		const auto current = leftFileBrowser->getSampler()->getResamplerQuality();
+
+		for (auto [id, quality] : { std::pair<int, Resampler::Quality>{ resamplingLinear, Resampler::Quality::Linear },
+									std::pair<int, Resampler::Quality>{ resamplingCubic, Resampler::Quality::CubicHermite },
+									std::pair<int, Resampler::Quality>{ resamplingSinc, Resampler::Quality::WindowedSinc } })
+			resamplingMenu.addItem(id, Resampler::getQualityName(quality), true, quality == current);
+
+		menu.addSubMenu("Pitch Resampling", resamplingMenu);
+
+		// Algorithmus für Key Lock, gilt für beide Decks
+		juce::PopupMenu keyLockMenu;
+		const auto currentMode = mixEngine.getKeyLockMode();
+
+		for (auto [id, mode] : { std::pair<int, TimeStretcher::Mode>{ keyLockWsola, TimeStretcher::Mode::WSOLA },
+								 std::pair<int, TimeStretcher::Mode>{ keyLockPhaseVocoder, TimeStretcher::Mode::PhaseVocoder } })
+			keyLockMenu.addItem(id, TimeStretcher::getModeName(mode), true, mode == currentMode);
+
+		menu.addSubMenu("Key Lock Mode", keyLockMenu);
+
+		// Speicherformat der Tracks im Speicher, gilt für beide Decks und den Sample Player
+		juce::PopupMenu storageMenu;
+		const auto currentStorage = leftFileBrowser->getSampler()->getSampleStorage();
+
+		for (auto [id, storage] : { std::pair<int, SampleStorage>{ storageFloat32, SampleStorage::float32 },
+									std::pair<int, SampleStorage>{ storageInt16, SampleStorage::int16 },
+									std::pair<int, SampleStorage>{ storageFloat16, SampleStorage::float16 } })
+			storageMenu.addItem(id, CompactSampleBuffer::getStorageName(storage), true, storage == currentStorage);
+
+		menu.addSubMenu("Sample Storage", storageMenu);
 	}
 	else if (topLevelMenuIndex == 2) // Help Menu
 	{
@@ -305,11 +394,71 @@ void MainComponent::menuItemSelected(int menuItemID, int topLevelMenuIndex)
 		juce::JUCEApplication::getInstance()->systemRequestedQuit();
 		break;
 
+	case resamplingLinear:
+		setResamplerQuality(Resampler::Quality::Linear);
+		break;
+
+	case resamplingCubic:
+		setResamplerQuality(Resampler::Quality::CubicHermite);
+		break;
+
+	case resamplingSinc:
+		setResamplerQuality(Resampler::Quality::WindowedSinc);
+		break;
+
+	case keyLockWsola:
+		setKeyLockMode(TimeStretcher::Mode::WSOLA);
+		break;
+
+	case keyLockPhaseVocoder:
+		setKeyLockMode(TimeStretcher::Mode::PhaseVocoder);
+		break;
+
+	case storageFloat32:
+		setSampleStorage(SampleStorage::float32);
+		break;
+
+	case storageInt16:
+		setSampleStorage(SampleStorage::int16);
+		break;
+
+	case storageFloat16:
+		setSampleStorage(SampleStorage::float16);
+		break;
+
 	default:
 		break;
 	}
 }
 
+void MainComponent::setResamplerQuality(Resampler::Quality quality)
+{
+	for (auto* browser : { leftFileBrowser.get(), rightFileBrowser.get() })
+		if (browser != nullptr && browser->getSampler() != nullptr)
+			browser->getSampler()->setResamplerQuality(quality);
+
+	menuItemsChanged();
+}
+
+void MainComponent::setKeyLockMode(TimeStretcher::Mode mode)
+{
+	mixEngine.setKeyLockMode(mode);
+
+	menuItemsChanged();
+}
+
+void MainComponent::setSampleStorage(SampleStorage storage)
+{
+	for (auto* browser : { leftFileBrowser.get(), rightFileBrowser.get() })
+		if (browser != nullptr && browser->getSampler() != nullptr)
+			browser->getSampler()->setSampleStorage(storage);
+
+	if (samplePlayer != nullptr)
+		samplePlayer->setSampleStorage(storage);
+
+	menuItemsChanged();
+}
+
 void MainComponent::createConfig() {
 	String userHome = File::getSpecialLocation(File::userHomeDirectory).getFullPathName();
 
@@ -403,19 +552,24 @@ void MainComponent::showAbout()
 //==============================================================================
 void MainComponent::prepareToPlay(int samplesPerBlockExpected, double sampleRate)
 {
-	currentSampleRate = sampleRate;
+	// FX, Mix-Busse, Key Lock, Decks und Stutter
+	mixEngine.prepareToPlay(sampleRate, samplesPerBlockExpected);
 
-	juce::dsp::ProcessSpec spec;
-	spec.sampleRate = sampleRate;
-	spec.maximumBlockSize = samplesPerBlockExpected;
-	spec.numChannels = 2; // Stereo
+	// Aktive Eingänge liegen im Callback-Puffer vorne, je zwei Kanäle ein Line-Eingang
+	auto* device = deviceManager.getCurrentAudioDevice();
+	numLineInputChannels = device != nullptr ? device->getActiveInputChannels().countNumberOfSetBits() : 0;
 
-	masterFX.prepare(spec);
-
-	// Prepare stutter effect
-	stutterEffect->prepareToPlay(sampleRate,samplesPerBlockExpected);
+	// EQ-Zielkoeffizienten für die neue Rate neu veröffentlichen
+	juce::MessageManager::callAsync([safeThis = juce::Component::SafePointer<MainComponent>(this)]()
+		{
+			if (safeThis != nullptr)
+				safeThis->publishEngineParameters();
+		});
+}
+void MainComponent::releaseResources()
+{
+	mixEngine.releaseResources();
 }
-void MainComponent::releaseResources() {}
 
 void MainComponent::handleIncomingMidiMessage(MidiInput* source, const MidiMessage& message)
 {
@@ -431,243 +585,17 @@ void MainComponent::handleIncomingMidiMessage(MidiInput* source, const MidiMessa
 
 void MainComponent::getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill)
 {
-	bufferToFill.clearActiveBufferRegion();
-
-	// === FX PARAMETER UPDATE ===
-	updateFXParameters();
+	// Ganzer Callback, nicht nur die MixEngine
+	const RealtimeSanitizer::ScopedRealtimeRegion realtimeRegion;
 
-	Sampler* leftSampler = leftFileBrowser->getSampler();
-	Sampler* rightSampler = rightFileBrowser->getSampler();
-
-	// Pitch-Werte von Mixer holen
-	double leftPitch = mixer->getLeftPitch();
-	double rightPitch = mixer->getRightPitch();
-
-	auto* writableBuffer = const_cast<juce::AudioBuffer<float>*>(bufferToFill.buffer);
+	auto* writableBuffer = bufferToFill.buffer;
 	if (!writableBuffer) return;
 
-	float** outputData = const_cast<float**>(writableBuffer->getArrayOfWritePointers());
-	const int outNumChans = writableBuffer->getNumChannels();
-	if (!outputData || outNumChans < 2) return;
-
-	// Stereo Buffers für beide Sampler (mit Pitch-Shifting)
-	std::vector<float> leftSamplerL(bufferToFill.numSamples, 0.0f);
-	std::vector<float> leftSamplerR(bufferToFill.numSamples, 0.0f);
-	std::vector<float> rightSamplerL(bufferToFill.numSamples, 0.0f);
-	std::vector<float> rightSamplerR(bufferToFill.numSamples, 0.0f);
-
-	// Sample Player Buffers
-	std::vector<float> samplePlayerL(bufferToFill.numSamples, 0.0f);
-	std::vector<float> samplePlayerR(bufferToFill.numSamples, 0.0f);
-
-	// === NEU: Master Mix Buffers für FX Processing ===
-	std::vector<float> masterMixL(bufferToFill.numSamples, 0.0f);
-	std::vector<float> masterMixR(bufferToFill.numSamples, 0.0f);
-
-	// Level monitoring variables
-	float leftChannelSum = 0.0f;
-	float rightChannelSum = 0.0f;
-	float masterLeftSum = 0.0f;
-	float masterRightSum = 0.0f;
-	float samplePlayerSum = 0.0f;
-
-	// Generate sampler outputs
-	if (leftSampler && leftSampler->isPlaying()) {
-		generateSamplerOutputWithPitch(leftSampler, leftSamplerL, leftSamplerR,
-			bufferToFill.numSamples, mixer->getLeftChannelGain(), leftPitch);
-	}
-
-	if (rightSampler && rightSampler->isPlaying()) {
-		generateSamplerOutputWithPitch(rightSampler, rightSamplerL, rightSamplerR,
-			bufferToFill.numSamples, mixer->getRightChannelGain(), rightPitch);
-	}
-
-	// Sample Player Output generieren
-	if (samplePlayer && samplePlayer->isAnySamplePlaying()) {
-		samplePlayer->generateSampleOutput(samplePlayerL, samplePlayerR,
-			bufferToFill.numSamples, 1.0f);
-	}
-
-	// === AUDIO ROUTING ZUM MASTER MIX ===
-	for (int j = 0; j < bufferToFill.numSamples; ++j) {
-
-		// Calculate channel levels before routing (for deck meters)
-		float leftChannelLevel = std::sqrt(leftSamplerL[j] * leftSamplerL[j] + leftSamplerR[j] * leftSamplerR[j]);
-		float rightChannelLevel = std::sqrt(rightSamplerL[j] * rightSamplerL[j] + rightSamplerR[j] * rightSamplerR[j]);
-		float samplePlayerLevel = std::sqrt(samplePlayerL[j] * samplePlayerL[j] + samplePlayerR[j] * samplePlayerR[j]);
-
-		leftChannelSum += leftChannelLevel * leftChannelLevel;
-		rightChannelSum += rightChannelLevel * rightChannelLevel;
-		samplePlayerSum += samplePlayerLevel * samplePlayerLevel;
-
-		// === LEFT DECK ROUTING ZUM MASTER MIX ===
-		auto leftDest = mixer->getLeftChannelDestination();
-
-		if (mixer->isLeftChannelRoutedToMaster()) {
-			float masterGain = mixer->getLeftMasterGain();
-
-			switch (leftDest) {
-			case MixerComponent::OutputDestination::MasterLeft:
-				masterMixL[j] += leftSamplerL[j] * masterGain;
-				masterMixR[j] += leftSamplerR[j] * masterGain;
-				break;
-			case MixerComponent::OutputDestination::MasterRight:
-			{
-				float monoOutput = (leftSamplerL[j] + leftSamplerR[j]) * masterGain * 0.5f;
-				masterMixR[j] += monoOutput;
-			}
-			break;
-			}
-		}
-
-		// === RIGHT DECK ROUTING ZUM MASTER MIX ===
-		auto rightDest = mixer->getRightChannelDestination();
-
-		if (mixer->isRightChannelRoutedToMaster()) {
-			float masterGain = mixer->getRightMasterGain();
-
-			switch (rightDest) {
-			case MixerComponent::OutputDestination::MasterLeft:
-			{
-				float monoOutput = (rightSamplerL[j] + rightSamplerR[j]) * masterGain * 0.5f;
-				masterMixL[j] += monoOutput;
-			}
-			break;
-			case MixerComponent::OutputDestination::MasterRight:
-				masterMixL[j] += rightSamplerL[j] * masterGain;
-				masterMixR[j] += rightSamplerR[j] * masterGain;
-				break;
-			}
-		}
-
-		// === Sample Player zum Master Mix hinzufügen ===
-		masterMixL[j] += samplePlayerL[j];
-		masterMixR[j] += samplePlayerR[j];
-
-		// === CUE ROUTING (bypassed FX) ===
-		if (mixer->isLeftChannelRoutedToCue()) {
-			if (outNumChans > 2) outputData[2][j] += leftSamplerL[j];
-			if (outNumChans > 3) outputData[3][j] += leftSamplerR[j];
-		}
-
-		if (mixer->isRightChannelRoutedToCue()) {
-			if (outNumChans > 2) outputData[2][j] += rightSamplerL[j];
-			if (outNumChans > 3) outputData[3][j] += rightSamplerR[j];
-		}
-	}
-
-	// === 🎛️ MASTER FX PROCESSING - HIER PASSIERT DIE MAGIE! ===
-	processFXChain(masterFX, masterMixL, masterMixR, bufferToFill.numSamples);
-
-	juce::AudioBuffer<float> tempBuffer(2, bufferToFill.numSamples);
-
-	// Kopiere Master Mix in temporären Buffer
-	for (int i = 0; i < bufferToFill.numSamples; ++i) {
-		tempBuffer.setSample(0, i, masterMixL[i]);
-		tempBuffer.setSample(1, i, masterMixR[i]);
-	}
-
-	// Wende Stutter-Effekt direkt auf den temporären Buffer an
-	if (stutterEffect) {
-		stutterEffect->processAudioBuffer(tempBuffer);
-	}
-
-	// === Final Output zu Hardware (mit Stutter-Effekt) ===
-	for (int j = 0; j < bufferToFill.numSamples; ++j) {
-		if (outNumChans > 0) {
-			outputData[0][j] = tempBuffer.getSample(0, j);
-			masterLeftSum += tempBuffer.getSample(0, j) * tempBuffer.getSample(0, j);
-		}
-		if (outNumChans > 1) {
-			outputData[1][j] = tempBuffer.getSample(1, j);
-			masterRightSum += tempBuffer.getSample(1, j) * tempBuffer.getSample(1, j);
-		}
-	}
-
-	// === LEVEL METER UPDATES ===
-	if (bufferToFill.numSamples > 0)
-	{
-		leftChannelRMS = std::sqrt(leftChannelSum / bufferToFill.numSamples);
-		rightChannelRMS = std::sqrt(rightChannelSum / bufferToFill.numSamples);
-		masterLeftRMS = std::sqrt(masterLeftSum / bufferToFill.numSamples);
-		masterRightRMS = std::sqrt(masterRightSum / bufferToFill.numSamples);
-		samplePlayerRMS = std::sqrt(samplePlayerSum / bufferToFill.numSamples);
-
-		// === FX COMPONENT LEVEL UPDATES ===
-		juce::AudioBuffer<float> levelBuffer(2, bufferToFill.numSamples);
-		for (int i = 0; i < bufferToFill.numSamples; ++i)
-		{
-			levelBuffer.setSample(0, i, tempBuffer.getSample(0, i));
-			levelBuffer.setSample(1, i, tempBuffer.getSample(1, i));
-		}
-
-		// === NEU: Level Updates an Mixer weiterleiten ===
-		juce::MessageManager::callAsync([this, leftChannelRMS = leftChannelRMS, rightChannelRMS = rightChannelRMS,
-			masterLeftRMS = masterLeftRMS, masterRightRMS = masterRightRMS,
-			samplePlayerRMS = samplePlayerRMS]() mutable
-			{
-				// Update bestehende Mixer Level Meters
-				if (mixer)
-				{
-					mixer->updateChannelLevels(0, leftChannelRMS, rightChannelRMS);   // Left deck
-					mixer->updateChannelLevels(1, leftChannelRMS, rightChannelRMS);   // Right deck (beide gleich für jetzt)
-					mixer->updateTrueMasterLevels(masterLeftRMS, masterRightRMS);     // Master output levels
-				}
-			});
-	}
-}
-// Hilfsfunktion für Pitch-Shifting
-void MainComponent::generateSamplerOutputWithPitch(Sampler* sampler,
-	std::vector<float>& outputL,
-	std::vector<float>& outputR,
-	int numSamples, float gain, double pitch)
-{
-	static double phase = 0.0;
-	static float prevSampleL = 0.0f;
-	static float prevSampleR = 0.0f;
-	static float currentSampleL = 0.0f;
-	static float currentSampleR = 0.0f;
-	static bool needNewSample = true;
-
-	for (int i = 0; i < numSamples; ++i) {
-		if (std::abs(pitch - 1.0) < 0.001) {
-			// Kein Pitch-Shifting - normaler Durchlauf
-			outputL[i] = sampler->getOutput(0) * gain;
-			outputR[i] = sampler->getOutput(1) * gain;
-			sampler->nextSample();
-		}
-		else {
-			// Pitch-Shifting mit korrekter Interpolation
-
-			// Neue Samples holen wenn nötig
-			while (phase >= 1.0) {
-				prevSampleL = currentSampleL;
-				prevSampleR = currentSampleR;
-				currentSampleL = sampler->getOutput(0);
-				currentSampleR = sampler->getOutput(1);
-				sampler->nextSample();
-				phase -= 1.0;
-				needNewSample = false;
-			}
-
-			// Beim ersten Mal oder nach Reset
-			if (needNewSample) {
-				currentSampleL = sampler->getOutput(0);
-				currentSampleR = sampler->getOutput(1);
-				prevSampleL = currentSampleL;
-				prevSampleR = currentSampleR;
-				needNewSample = false;
-			}
-
-			// Linear interpolation zwischen den Samples
-			float fracPart = static_cast<float>(phase);
-			outputL[i] = (prevSampleL + fracPart * (currentSampleL - prevSampleL)) * gain;
-			outputR[i] = (prevSampleR + fracPart * (currentSampleR - prevSampleR)) * gain;
-
-			// Phase für nächstes Sample erhöhen
-			phase += pitch;
-		}
-	}
+	// Decks, Sample Player, Routing, Master FX und Stutter laufen in der MixEngine,
+	// die Pegel holen sich die Meter im Mixer selbst (getMeters()). Die Line-Eingänge
+	// stehen noch im Puffer; die Engine nimmt ihre Onsets und löscht ihn dann
+	mixEngine.process(writableBuffer->getArrayOfWritePointers(), writableBuffer->getNumChannels(),
+		bufferToFill.startSample, bufferToFill.numSamples, numLineInputChannels);
 }
 
 // Erweiterte Header-Deklaration in MainComponent.h
@@ -696,161 +624,42 @@ void MainComponent::resized()
 }
 
 
-void MainComponent::updateFXParameters()
+double MainComponent::getLineInputBPM(int input) const
 {
-	// Parameter direkt von UI-Komponenten lesen (einfacher Weg ohne AudioProcessorValueTreeState)
-	updateFilterParameters(masterFX);
-	updateEQParameters(masterFX);
-	updateChorusParameters(masterFX);
-	updateReverbParameters(masterFX);
-
-	// Master Volume direkt vom Knob lesen
-	if (fxComponent)
-		masterFX.masterVolume = (float)fxComponent->masterVolumeKnob.getValue();
-}
-
-void MainComponent::updateFilterParameters(FXChain& fx, const juce::String& prefix)
-{
-	if (!fxComponent) return;
-
-	auto cutoff = (float)fxComponent->filterSection.cutoffKnob.getValue();
-	auto resonance = (float)fxComponent->filterSection.resonanceKnob.getValue();
-	auto drive = (float)fxComponent->filterSection.driveKnob.getValue();
-	auto type = fxComponent->filterSection.typeCombo.getSelectedId() - 1; // ComboBox IDs starten bei 1
-	fx.filterBypass = fxComponent->filterBypass.getToggleState();
-
-	for (auto& filter : fx.filters)
-	{
-		filter.setCutoffFrequency(cutoff);
-		filter.setResonance(resonance);
-
-		switch (type)
-		{
-		case 0: filter.setType(juce::dsp::StateVariableTPTFilterType::lowpass); break;
-		case 1: filter.setType(juce::dsp::StateVariableTPTFilterType::highpass); break;
-		case 2: filter.setType(juce::dsp::StateVariableTPTFilterType::bandpass); break;
-		// case 3: filter.setType(juce::dsp::StateVariableTPTFilterType::notch); break;
-		default: filter.setType(juce::dsp::StateVariableTPTFilterType::lowpass); break;
-		}
-	}
+	return mixEngine.getLineInputBPM(input);
 }
 
-void MainComponent::updateEQParameters(FXChain& fx, const juce::String& prefix)
+void MainComponent::timerCallback()
 {
-	if (!fxComponent) return;
+	mixEngine.updateLineInputTempo();
 
-	auto lowGain = juce::Decibels::decibelsToGain((float)fxComponent->eqSection.lowKnob.getValue());
-	auto midGain = juce::Decibels::decibelsToGain((float)fxComponent->eqSection.midKnob.getValue());
-	auto highGain = juce::Decibels::decibelsToGain((float)fxComponent->eqSection.highKnob.getValue());
-	auto lowFreq = (float)fxComponent->eqSection.lowFreqKnob.getValue();
-	auto highFreq = (float)fxComponent->eqSection.highFreqKnob.getValue();
-	fx.eqBypass = fxComponent->eqBypass.getToggleState();
-
-	// Stereo EQ - beide Kanäle gleich einstellen
-	for (int i = 0; i < 2; ++i)
+	// Line-Eingang 0 neben Deck A, 1 neben Deck B
+	if (mixer)
 	{
-		fx.lowShelfFilter[i].coefficients = juce::dsp::IIR::Coefficients<float>::makeLowShelf(
-			currentSampleRate, lowFreq, 0.707f, lowGain);
-		fx.peakingFilter[i].coefficients = juce::dsp::IIR::Coefficients<float>::makePeakFilter(
-			currentSampleRate, 1000.0f, 1.0f, midGain);
-		fx.highShelfFilter[i].coefficients = juce::dsp::IIR::Coefficients<float>::makeHighShelf(
-			currentSampleRate, highFreq, 0.707f, highGain);
+		mixer->setLineInputBPM(true, getLineInputBPM(0));
+		mixer->setLineInputBPM(false, getLineInputBPM(1));
 	}
-}
 
-void MainComponent::updateChorusParameters(FXChain& fx, const juce::String& prefix)
-{
-	if (!fxComponent) return;
-
-	auto rate = (float)fxComponent->chorusSection.rateKnob.getValue();
-	auto depth = (float)fxComponent->chorusSection.depthKnob.getValue();
-	auto feedback = (float)fxComponent->chorusSection.feedbackKnob.getValue();
-	auto mix = (float)fxComponent->chorusSection.mixKnob.getValue();
-	fx.chorusBypass = fxComponent->chorusBypass.getToggleState();
-
-	fx.chorus.setRate(rate);
-	fx.chorus.setDepth(depth);
-	fx.chorus.setFeedback(feedback);
-	fx.chorus.setMix(mix);
-	fx.chorus.setCentreDelay(7.0f);
-}
+	// Übernommene Konvertierungen der Decks und ersetzte Slot-Daten freigeben
+	leftFileBrowser->getSampler()->releaseRetiredSources();
+	rightFileBrowser->getSampler()->releaseRetiredSources();
 
-void MainComponent::updateReverbParameters(FXChain& fx, const juce::String& prefix)
-{
-	if (!fxComponent) return;
-
-	juce::dsp::Reverb::Parameters reverbParams;
-	reverbParams.roomSize = (float)fxComponent->reverbSection.roomSizeKnob.getValue();
-	reverbParams.damping = (float)fxComponent->reverbSection.dampingKnob.getValue();
-	reverbParams.wetLevel = (float)fxComponent->reverbSection.wetKnob.getValue();
-	reverbParams.dryLevel = (float)fxComponent->reverbSection.dryKnob.getValue();
-	reverbParams.width = (float)fxComponent->reverbSection.widthKnob.getValue();
-	reverbParams.freezeMode = 0.0f;
-
-	fx.reverbBypass = fxComponent->reverbBypass.getToggleState();
-	fx.reverb.setParameters(reverbParams);
+	if (samplePlayer != nullptr)
+		samplePlayer->getSlotBank().releaseRetiredData();
 }
 
-void MainComponent::processFXChain(FXChain& fx, std::vector<float>& leftChannel, std::vector<float>& rightChannel, int numSamples)
+void MainComponent::publishEngineParameters()
 {
-	// Create audio buffer from vectors
-	juce::AudioBuffer<float> buffer(2, numSamples);
-
-	// Copy input data
-	for (int i = 0; i < numSamples; ++i)
-	{
-		buffer.setSample(0, i, leftChannel[i]);
-		buffer.setSample(1, i, rightChannel[i]);
-	}
-
-	// Process FX Chain
-	juce::dsp::AudioBlock<float> block(buffer);
-	juce::dsp::ProcessContextReplacing<float> context(block);
-
-	// Filter (bereits Stereo-fähig)
-	if (!fx.filterBypass)
-	{
-		for (auto& filter : fx.filters)
-			filter.process(context);
-	}
-
-	// EQ - Stereo Processing
-	if (!fx.eqBypass)
-	{
-		// Separate Channels für EQ
-		for (int channel = 0; channel < 2; ++channel)
-		{
-			for (int sample = 0; sample < numSamples; ++sample)
-			{
-				float input = buffer.getSample(channel, sample);
-
-				// Chain: Low → Peak → High
-				float output = fx.lowShelfFilter[channel].processSample(input);
-				output = fx.peakingFilter[channel].processSample(output);
-				output = fx.highShelfFilter[channel].processSample(output);
-
-				buffer.setSample(channel, sample, output);
-			}
-		}
-	}
+	JUCE_ASSERT_MESSAGE_THREAD
 
-	// Chorus (bereits Stereo-fähig)
-	if (!fx.chorusBypass)
-		fx.chorus.process(context);
+	EngineParameters params;
 
-	// Reverb (bereits Stereo-fähig)
-	if (!fx.reverbBypass)
-		fx.reverb.process(context);
+	if (mixer)
+		mixer->fillEngineParameters(params);
 
-	// Master Volume
-	auto masterGain = juce::Decibels::decibelsToGain(fx.masterVolume);
-	if (masterGain != 1.0f)
-		block.multiplyBy(masterGain);
+	if (fxComponent)
+		fxComponent->fillEngineParameters(params);
 
-	// Copy back to vectors
-	for (int i = 0; i < numSamples; ++i)
-	{
-		leftChannel[i] = buffer.getSample(0, i);
-		rightChannel[i] = buffer.getSample(1, i);
-	}
-}
\ No newline at end of file
+	// Die Engine rechnet die EQ-Koeffizienten für ihre Rate und übergibt den Snapshot
+	mixEngine.publishParameters(params);
+}
@@ -15,6 +15,9 @@
 #include "FXUtilities.h"
 #include "MIdiMonitorComponent.h"
 #include "StutterEffectComponent.h"
+#include "DspLoadComponent.h"
+#include "AudioEngine/MixEngine.h"
+#include "DeckLoader.h"
 //==============================================================================
 /*
     This component lives inside our window, and this is where you should put all
@@ -26,73 +29,14 @@ class MainComponent : public juce::AudioAppComponent,
                       public juce::MidiInputCallback,
                       public juce::MenuBarModel,
 	                  public juce::ChangeListener,
-                      public juce::DragAndDropContainer
+                      public juce::DragAndDropContainer,
+                      private juce::Timer
 {
 public:
     //==============================================================================
     MainComponent();
     ~MainComponent() override;
 
-    // === FX DSP CHAIN ===
-    struct FXChain
-    {
-        // Filter
-        std::array<juce::dsp::StateVariableTPTFilter<float>, 2> filters;
-        bool filterBypass = false;
-
-        // EQ - Separate Filter fr Stereo
-        std::array<juce::dsp::IIR::Filter<float>, 2> lowShelfFilter, peakingFilter, highShelfFilter;
-        bool eqBypass = false;
-
-        // Chorus
-        juce::dsp::Chorus<float> chorus;
-        bool chorusBypass = false;
-
-        // Reverb
-        juce::dsp::Reverb reverb;
-        bool reverbBypass = false;
-
-        // Master Volume
-        float masterVolume = 0.0f; // dB
-
-        void prepare(const juce::dsp::ProcessSpec& spec)
-        {
-            for (auto& filter : filters)
-            {
-                filter.prepare(spec);
-                filter.reset();
-            }
-
-            // EQ - Stereo vorbereiten
-            for (int i = 0; i < 2; ++i)
-            {
-                lowShelfFilter[i].prepare(spec);
-                peakingFilter[i].prepare(spec);
-                highShelfFilter[i].prepare(spec);
-            }
-
-            chorus.prepare(spec);
-            reverb.prepare(spec);
-        }
-
-        void reset()
-        {
-            for (auto& filter : filters)
-                filter.reset();
-
-            // EQ - Stereo reset
-            for (int i = 0; i < 2; ++i)
-            {
-                lowShelfFilter[i].reset();
-                peakingFilter[i].reset();
-                highShelfFilter[i].reset();
-            }
-
-            chorus.reset();
-            reverb.reset();
-        }
-    };
-
     juce::StringArray getMenuBarNames() override;
     juce::PopupMenu getMenuForIndex(int topLevelMenuIndex, const juce::String& menuName) override;
     void menuItemSelected(int menuItemID, int topLevelMenuIndex) override;
@@ -119,27 +63,20 @@ public:
     void changeListenerCallback(juce::ChangeBroadcaster* source) override;
     void createConfig();
 
-    void generateSamplerOutputWithPitch(Sampler* sampler, std::vector<float>& outputL,
-        std::vector<float>& outputR, int numSamples,
-        float gain, double pitch);
+    // Track auf ein Deck laden (0 = A, 1 = B): Laden, Waveform und BPM-Analyse laufen im DeckLoader
+    void loadDeck(int deck, const juce::File& audioFile);
+    void setupDeckLoaders();
 
-    // BPM Analysis Integration - wird aufgerufen wenn Track geladen wird
-    void onTrackLoaded(const juce::File& audioFile, bool isLeftDeck)
-    {
-        // BPM analysieren im Hintergrund
-        if (mixer) {
-            mixer->analyzeBPMFromFile(audioFile, isLeftDeck);
-        }
-    }
+    // Message Thread: Mixer- und FX-Zustand als Snapshot an die Audio-Engine bergeben
+    void publishEngineParameters();
 
-    void updateFXParameters();
-    void processFXChain(FXChain& fx, std::vector<float>& leftChannel, std::vector<float>& rightChannel, int numSamples);
-    void updateFilterParameters(FXChain& fx, const juce::String& prefix = "master");
-    void updateEQParameters(FXChain& fx, const juce::String& prefix = "master");
-    void updateChorusParameters(FXChain& fx, const juce::String& prefix = "master");
-    void updateReverbParameters(FXChain& fx, const juce::String& prefix = "master");
+    // Laufendes Tempo am Line-Eingang 0 (Kanle 1/2) oder 1 (3/4), 0 ohne Signal; jeder Thread
+    double getLineInputBPM(int input) const;
 
 private:
+    // Schtzt das Tempo der Line-Eingnge aus den gesammelten Onsets und zeigt es im Mixer
+    void timerCallback() override;
+
     //==============================================================================
     // Your private member variables go here...
 
@@ -153,9 +90,21 @@ private:
         audioSettings = 1000,
         midiSettings = 1001,
         about = 1002,
-        exit = 1003
+        exit = 1003,
+        resamplingLinear = 1010,
+        resamplingCubic = 1011,
+        resamplingSinc = 1012,
+        keyLockWsola = 1020,
+        keyLockPhaseVocoder = 1021,
+        storageFloat32 = 1030,
+        storageInt16 = 1031,
+        storageFloat16 = 1032
     };
 
+    void setResamplerQuality(Resampler::Quality quality);
+    void setKeyLockMode(TimeStretcher::Mode mode);
+    void setSampleStorage(SampleStorage storage);
+
     void showAudioSettings();
     void showAbout();
 
@@ -176,6 +125,9 @@ private:
     
     std::unique_ptr<DualWaveformComponent> wave = nullptr;
 
+    // Ladepipeline je Deck, nach den Browsern deklariert (die besitzen die Sampler)
+    std::array<std::unique_ptr<DeckLoader>, 2> deckLoaders;
+
     juce::StretchableLayoutManager stretchableManager;
     juce::StretchableLayoutResizerBar resizerBar;
 
@@ -190,13 +142,11 @@ private:
     std::unique_ptr<CyberpunkDJLookAndFeel> djLookAndFeel;
     std::unique_ptr<SamplePlayer> samplePlayer;
 
-    float leftChannelRMS = 0.0f;
-    float rightChannelRMS = 0.0f;
-    float masterLeftRMS = 0.0f;
-    float masterRightRMS = 0.0f;
-    float samplePlayerRMS = 0.0f;
+    // Decks, Sample Player, Routing, Master FX und Stutter ohne UI (auch fr den Offline-Renderer)
+    MixEngine mixEngine;
 
-	double currentSampleRate = 44100.0; 
+    // Aktive Eingnge vorne im Callback-Puffer, je zwei ein Line-Eingang (Tempo in der MixEngine)
+    int numLineInputChannels = 0;
 
 
     std::unique_ptr<AdvancedFXComponent> fxComponent;
@@ -206,11 +156,12 @@ private:
     std::vector<std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment>> buttonAttachments;
     std::vector<std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment>> comboAttachments;
 
-    FXChain masterFX; // Master FX Chain fr alle Signale
-
 	std::unique_ptr<MidiMonitorComponent> midiMonitor;
 	std::unique_ptr<StutterEffectComponent> stutterEffect;
 
+    // Zeitmessung je Stage liefert die MixEngine
+    std::unique_ptr<DspLoadComponent> dspLoadPanel;
+
     juce::AudioFormatManager formatManager;
     std::unique_ptr<juce::AudioFormatReaderSource> readerSource;
     juce::AudioTransportSource transportSource;
@@ -11,6 +11,7 @@
 #include "BPMAnalyzer.h"
 #include "LevelMeterComponent.h"
 #include "BaseComponent.h"
+#include "AudioEngine/EngineParameters.h"
 
 class MixerComponent : public BaseComponent
 {
@@ -159,6 +160,27 @@ public:
 		addAndMakeVisible(leftSyncButton.get());
 		addAndMakeVisible(rightSyncButton.get());
 
+		// Laufendes Tempo des Line-Eingangs je Seite (Kanäle 1/2 bzw. 3/4)
+		leftLineTempoLabel = std::make_unique<juce::Label>("", "LINE -- BPM");
+		rightLineTempoLabel = std::make_unique<juce::Label>("", "LINE -- BPM");
+		for (auto* label : { leftLineTempoLabel.get(), rightLineTempoLabel.get() })
+		{
+			label->setJustificationType(juce::Justification::centred);
+			label->setFont(10.0f);
+			addAndMakeVisible(label);
+		}
+
+		// Key Lock Buttons (Tempo ändern ohne Tonhöhe)
+		leftKeyLockButton = std::make_unique<juce::TextButton>("KEY");
+		rightKeyLockButton = std::make_unique<juce::TextButton>("KEY");
+		for (auto* button : { leftKeyLockButton.get(), rightKeyLockButton.get() })
+		{
+			button->setClickingTogglesState(true);
+			button->setColour(juce::TextButton::buttonColourId, juce::Colours::darkblue);
+			button->setColour(juce::TextButton::buttonOnColourId, juce::Colours::orange);
+			addAndMakeVisible(button);
+		}
+
 		// Button Callbacks - ERWEITERT für Pitch
 		leftLearnButton->onClick = [this]() { startMidiLearn(MidiTarget::LeftVolume); };
 		rightLearnButton->onClick = [this]() { startMidiLearn(MidiTarget::RightVolume); };
@@ -170,6 +192,15 @@ public:
 		leftSyncButton->onClick = [this]() { syncLeftToRight(); };
 		rightSyncButton->onClick = [this]() { syncRightToLeft(); };
 
+		// Jede Änderung an Fadern, Pitch oder Routing an die Audio-Engine melden
+		for (auto* slider : { leftSlider.get(), rightSlider.get(), crossfader.get(), leftPitchSlider.get(), rightPitchSlider.get() })
+			slider->onValueChange = [this]() { notifyParametersChanged(); };
+
+		leftOutputCombo->onChange = [this]() { notifyParametersChanged(); };
+		rightOutputCombo->onChange = [this]() { notifyParametersChanged(); };
+		leftKeyLockButton->onClick = [this]() { notifyParametersChanged(); };
+		rightKeyLockButton->onClick = [this]() { notifyParametersChanged(); };
+
 		// BPM Analyzer
 		leftBPMAnalyzer = std::make_unique<BPMAnalyzer>();
 		rightBPMAnalyzer = std::make_unique<BPMAnalyzer>();
@@ -333,6 +364,8 @@ public:
 		auto outputLabel = isLeft ? leftOutputLabel.get() : rightOutputLabel.get();
 		auto outputCombo = isLeft ? leftOutputCombo.get() : rightOutputCombo.get();
 		auto syncButton = isLeft ? leftSyncButton.get() : rightSyncButton.get();
+		auto keyLockButton = isLeft ? leftKeyLockButton.get() : rightKeyLockButton.get();
+		auto lineTempoLabel = isLeft ? leftLineTempoLabel.get() : rightLineTempoLabel.get();
 		auto pitchSlider = isLeft ? leftPitchSlider.get() : rightPitchSlider.get();
 		auto pitchLabel = isLeft ? leftPitchLabel.get() : rightPitchLabel.get();
 		auto pitchLearnButton = isLeft ? leftPitchLearnButton.get() : rightPitchLearnButton.get();
@@ -444,8 +477,20 @@ public:
 		if (syncButton && workingArea.getHeight() >= 25)
 		{
 			auto syncArea = workingArea.removeFromTop(25);
+
+			if (keyLockButton)
+			{
+				keyLockButton->setBounds(syncArea.removeFromRight(40));
+				syncArea.removeFromRight(4);
+			}
+
 			syncButton->setBounds(syncArea);
+			workingArea.removeFromTop(3);
 		}
+
+		// === LINE-EINGANG TEMPO ===
+		if (lineTempoLabel && workingArea.getHeight() >= 15)
+			lineTempoLabel->setBounds(workingArea.removeFromTop(15));
 	}
 
 	void layoutMasterMeters(juce::Rectangle<int> centerArea)
@@ -712,18 +757,14 @@ public:
 	}
 
 	// BPM und Sync Funktionen (unverändert)
-	void analyzeBPMFromFile(const juce::File& audioFile, bool isLeftDeck)
+	// Ergebnis der BPM-Analyse vom DeckLoader übernehmen (Message Thread)
+	void setBPMAnalysis(bool isLeftDeck, std::unique_ptr<BPMAnalyzer> analyzer)
 	{
-		if (isLeftDeck)
-		{
-			leftBPMAnalyzer->analyzeFile(audioFile);
-			updateBPMDisplay(true);
-		}
-		else
-		{
-			rightBPMAnalyzer->analyzeFile(audioFile);
-			updateBPMDisplay(false);
-		}
+		if (analyzer == nullptr)
+			return;
+
+		(isLeftDeck ? leftBPMAnalyzer : rightBPMAnalyzer) = std::move(analyzer);
+		updateBPMDisplay(isLeftDeck);
 	}
 
 	void updateBPMDisplay(bool isLeftDeck)
@@ -776,19 +817,29 @@ public:
 		}
 	}
 
+	// Tempo am Line-Eingang dieser Seite, 0 ohne erkennbares Tempo (Message Thread, vom Timer in MainComponent)
+	void setLineInputBPM(bool isLeftDeck, double bpm)
+	{
+		auto* label = isLeftDeck ? leftLineTempoLabel.get() : rightLineTempoLabel.get();
+		label->setText(bpm > 0.0 ? "LINE " + juce::String(bpm, 1) + " BPM" : "LINE -- BPM", juce::dontSendNotification);
+	}
+
 	// Audio-Funktionen (unverändert)
 	double getLeftPitch() const { return 1.0 + leftPitchSlider->getValue(); }
 	double getRightPitch() const { return 1.0 + rightPitchSlider->getValue(); }
 
-	float getLeftChannelGain() {
+	bool isLeftKeyLockEnabled() const { return leftKeyLockButton->getToggleState(); }
+	bool isRightKeyLockEnabled() const { return rightKeyLockButton->getToggleState(); }
+
+	float getLeftChannelGain() const {
 		return (float)leftSlider->getValue();
 	}
 
-	float getRightChannelGain() {
+	float getRightChannelGain() const {
 		return (float)rightSlider->getValue();
 	}
 
-	float getLeftMasterGain() {
+	float getLeftMasterGain() const {
 		float baseGain = (float)leftSlider->getValue();
 		float crossfaderValue = (float)crossfader->getValue();
 
@@ -800,7 +851,7 @@ public:
 		return baseGain * crossfaderGain;
 	}
 
-	float getRightMasterGain() {
+	float getRightMasterGain() const {
 		float baseGain = (float)rightSlider->getValue();
 		float crossfaderValue = (float)crossfader->getValue();
 
@@ -812,22 +863,16 @@ public:
 		return baseGain * crossfaderGain;
 	}
 
-	float getLeftCueGain() {
+	float getLeftCueGain() const {
 		return (float)leftSlider->getValue();
 	}
 
-	float getRightCueGain() {
+	float getRightCueGain() const {
 		return (float)rightSlider->getValue();
 	}
 
 	// Output Routing (unverändert)
-	enum class OutputDestination {
-		MasterLeft,
-		MasterRight,
-		CueLeft,
-		CueRight,
-		Muted
-	};
+	using OutputDestination = EngineParameters::OutputDestination;
 
 	bool isLeftChannelRoutedToMaster() const {
 		int selectedOutput = leftOutputCombo->getSelectedId();
@@ -869,10 +914,35 @@ public:
 		}
 	}
 
-	float getCrossfaderValue() {
+	float getCrossfaderValue() const {
 		return (float)crossfader->getValue();
 	}
 
+	// Message Thread: aktuellen Mixer-Zustand in den Engine-Snapshot schreiben
+	void fillEngineParameters(EngineParameters& params) const
+	{
+		auto& deckA = params.decks[0];
+		deckA.channelGain = getLeftChannelGain();
+		deckA.masterGain = getLeftMasterGain();
+		deckA.pitch = getLeftPitch();
+		deckA.keyLock = isLeftKeyLockEnabled();
+		deckA.destination = getLeftChannelDestination();
+		deckA.routedToMaster = isLeftChannelRoutedToMaster();
+		deckA.routedToCue = isLeftChannelRoutedToCue();
+
+		auto& deckB = params.decks[1];
+		deckB.channelGain = getRightChannelGain();
+		deckB.masterGain = getRightMasterGain();
+		deckB.pitch = getRightPitch();
+		deckB.keyLock = isRightKeyLockEnabled();
+		deckB.destination = getRightChannelDestination();
+		deckB.routedToMaster = isRightChannelRoutedToMaster();
+		deckB.routedToCue = isRightChannelRoutedToCue();
+	}
+
+	// Wird auf dem Message Thread aufgerufen, sobald sich ein audio-relevanter Regler ändert
+	std::function<void()> onParametersChanged;
+
 	// Getter für ComboBoxes
 	juce::ComboBox* getLeftOutputCombo() const { return leftOutputCombo.get(); }
 	juce::ComboBox* getRightOutputCombo() const { return rightOutputCombo.get(); }
@@ -906,48 +976,27 @@ public:
 		crossfaderCCLabel->setText(cc >= 0 ? "CC: " + juce::String(cc) : "CC: -", juce::dontSendNotification);
 	}
 
-	void updateChannelLevels(int deck, float leftSample, float rightSample)
-	{
-		if (deck == 0 && leftLevelMeter) // Deck A
-		{
-			// True stereo metering - nutze nur den linken Kanal für linken Meter
-			float level = std::abs(leftSample);
-			leftLevelMeter->setLevel(level);
-		}
-		else if (deck == 1 && rightLevelMeter) // Deck B  
-		{
-			float level = std::abs(rightSample);
-			rightLevelMeter->setLevel(level);
-		}
-	}
-
-	// Separate Methode für echte Master-Levels
-	void updateTrueMasterLevels(float finalMasterLeft, float finalMasterRight)
+	// Die Meter holen sich ihre Pegel selbst im Timer, jedes Deck seinen eigenen, Master getrennt L/R.
+	// nullptr trennt sie wieder (bevor die Engine zerstört wird).
+	void attachLevelMeters(LevelMeterSource* deckA, LevelMeterSource* deckB, LevelMeterSource* master)
 	{
+		if (leftLevelMeter)
+			leftLevelMeter->setSource(deckA);
+		if (rightLevelMeter)
+			rightLevelMeter->setSource(deckB);
 		if (masterLevelMeterL)
-		{
-			masterLevelMeterL->setLevel(calculatePeakLevel(finalMasterLeft));
-		}
+			masterLevelMeterL->setSource(master, 0, LevelMeter::Scale::decibels);
 		if (masterLevelMeterR)
-		{
-			masterLevelMeterR->setLevel(calculatePeakLevel(finalMasterRight));
-		}
+			masterLevelMeterR->setSource(master, 1, LevelMeter::Scale::decibels);
 	}
 
 private:
-	float calculatePeakLevel(float sample)
+	void notifyParametersChanged()
 	{
-		float absSample = std::abs(sample);
-
-		// Logarithmic scaling für bessere Sichtbarkeit
-		if (absSample < 0.001f) return 0.0f;
-
-		float dbValue = 20.0f * std::log10(absSample);
-		// Map from -60dB to 0dB to 0.0 to 1.0
-		float normalizedLevel = juce::jlimit(0.0f, 1.0f, (dbValue + 60.0f) / 60.0f);
-
-		return normalizedLevel;
+		if (onParametersChanged)
+			onParametersChanged();
 	}
+
 private:
 	// GUI Components (erweitert)
 	std::unique_ptr<juce::Slider> leftSlider = nullptr;
@@ -988,6 +1037,10 @@ private:
 	std::unique_ptr<juce::Label> rightPitchLabel = nullptr;
 	std::unique_ptr<juce::TextButton> leftSyncButton = nullptr;
 	std::unique_ptr<juce::TextButton> rightSyncButton = nullptr;
+	std::unique_ptr<juce::TextButton> leftKeyLockButton = nullptr;
+	std::unique_ptr<juce::TextButton> rightKeyLockButton = nullptr;
+	std::unique_ptr<juce::Label> leftLineTempoLabel = nullptr;
+	std::unique_ptr<juce::Label> rightLineTempoLabel = nullptr;
 
 	// BPM Analysis
 	std::unique_ptr<BPMAnalyzer> leftBPMAnalyzer = nullptr;
@@ -7,6 +7,8 @@
 */
 
 #include "PlayListComponent.h"
+#include "AudioEngine/DecodedTrackCache.h"
+#include "AudioEngine/TrackDatabase.h"
 
 PlaylistComponent::PlaylistComponent()
 {
@@ -23,6 +25,7 @@ PlaylistComponent::PlaylistComponent()
     table->getHeader().addColumn("Track", 1, 250, 50, 400);
     table->getHeader().addColumn("Duration", 2, 70, 50, 100);
     table->getHeader().addColumn("Status", 3, 60, 50, 100);
+    table->getHeader().addColumn("BPM", 4, 55, 40, 80);
 
     table->setHeaderHeight(22);
     table->setRowHeight(20);
@@ -63,10 +66,16 @@ PlaylistComponent::PlaylistComponent()
 
     currentTrackIndex = -1;
     isPlaying = false;
+
+    // BPM, Beatgrid und Waveform aller Tracks im Hintergrund
+    AnalysisScheduler::getInstance().addListener(this);
 }
 
 PlaylistComponent::~PlaylistComponent()
 {
+    AnalysisScheduler::getInstance().removeListener(this);
+    AnalysisScheduler::getInstance().cancelLane(AnalysisScheduler::Lane::playlist);
+
     // Timer wird automatisch gestoppt wenn Component zerstört wird
 }
 
@@ -341,6 +350,9 @@ void PlaylistComponent::paintCell(juce::Graphics& g, int rowNumber, int columnId
         else
             text = "Ready";
         break;
+    case 4: // BPM
+        text = track.bpm > 0.0 ? juce::String(track.bpm, 1) : juce::String("--");
+        break;
     }
 
     g.drawText(text, 4, 0, width - 8, height, juce::Justification::centredLeft);
@@ -371,7 +383,23 @@ void PlaylistComponent::addTrack(const juce::File& file)
 
     PlaylistTrack track;
     track.file = file;
-    track.duration = getAudioFileDuration(file);
+
+    // Schon analysiert: Dauer und Tempo aus der Bibliothek, ohne die Datei zu öffnen
+    TrackDatabase::Record stored;
+
+    if (TrackDatabase::getInstance().lookup(file, stored, false))
+    {
+        track.duration = stored.duration;
+        track.bpm = stored.bpm;
+    }
+    else
+    {
+        track.duration = getAudioFileDuration(file);
+
+        if (track.duration > 0.0)
+            AnalysisScheduler::getInstance().request(file, AnalysisScheduler::Lane::playlist);
+    }
+
     track.hasError = (track.duration <= 0.0);
 
     playlist.push_back(track);
@@ -409,6 +437,7 @@ void PlaylistComponent::clearPlaylist()
     stopPlayback();
     playlist.clear();
     currentTrackIndex = -1;
+    AnalysisScheduler::getInstance().cancelLane(AnalysisScheduler::Lane::playlist);
     table->updateContent();
     updateStatusDisplay();
     hasUnsavedChanges = true;
@@ -761,6 +790,9 @@ bool PlaylistComponent::loadPlaylist(const juce::File& file)
             hasUnsavedChanges = false;
             updateWindowTitle();
 
+            // Geladene Tracks kommen nicht über addTrack(), daher hier anstoßen
+            requestAnalysis();
+
             table->updateContent();
             updateStatusDisplay();
             repaint();
@@ -1041,22 +1073,48 @@ double PlaylistComponent::getAudioFileDuration(const juce::File& file) const
     if (!file.exists() || file.getSize() == 0)
         return 0.0;
 
-    juce::AudioFormatManager formatManager;
-    formatManager.registerBasicFormats();
+    // Bibliothek zuerst, sonst nur den Header lesen (Ergebnis wird im gemeinsamen Cache gemerkt)
+    const double stored = TrackDatabase::getInstance().getDuration(file);
 
-    auto fileStream = std::make_unique<juce::FileInputStream>(file);
-    if (!fileStream->openedOk())
-        return 0.0;
+    return stored > 0.0 ? stored : DecodedTrackCache::getInstance().getDuration(file);
+}
+
+void PlaylistComponent::requestAnalysis()
+{
+    juce::Array<juce::File> files;
+    TrackDatabase::Record stored;
+
+    for (auto& track : playlist)
+    {
+        if (track.hasError || track.bpm > 0.0)
+            continue;
+
+        // Aus einer früheren Sitzung bekannt: kein Auftrag nötig
+        if (TrackDatabase::getInstance().lookup(track.file, stored, false))
+            track.bpm = stored.bpm;
+        else
+            files.add(track.file);
+    }
 
-    std::unique_ptr<juce::AudioFormatReader> reader(
-        formatManager.createReaderFor(std::move(fileStream)));
+    AnalysisScheduler::getInstance().request(files, AnalysisScheduler::Lane::playlist);
+}
 
-    if (reader != nullptr && reader->lengthInSamples > 0)
+void PlaylistComponent::trackAnalysed(const TrackAnalysisPtr& analysis)
+{
+    bool changed = false;
+
+    for (auto& track : playlist)
     {
-        return static_cast<double>(reader->lengthInSamples) / reader->sampleRate;
+        if (track.file == analysis->file)
+        {
+            track.bpm = analysis->bpm;
+            track.duration = analysis->duration;
+            changed = true;
+        }
     }
 
-    return 0.0;
+    if (changed)
+        table->repaint();
 }
 
 juce::String PlaylistComponent::formatDuration(double seconds) const
@@ -10,13 +10,15 @@
 
 #pragma once
 #include <JuceHeader.h>
+#include "AnalysisScheduler.h"
 #include <random>
 #include <algorithm>
 
 class PlaylistComponent : public juce::Component,
     public juce::FileDragAndDropTarget,
     public juce::DragAndDropTarget,
-    public juce::TableListBoxModel
+    public juce::TableListBoxModel,
+    private AnalysisScheduler::Listener
 {
 public:
     // Constructor
@@ -102,12 +104,17 @@ private:
     void updateStatusDisplay();
     void startAutoPlayTimer(double trackDuration);
     void showContextMenu(int rowNumber);
+    void requestAnalysis();
+
+    // AnalysisScheduler::Listener
+    void trackAnalysed(const TrackAnalysisPtr& analysis) override;
 
     // Data structures
     struct PlaylistTrack
     {
         juce::File file;
         double duration = 0.0;
+        double bpm = 0.0;           // 0 = noch nicht analysiert
         bool hasError = false;
     };
 
@@ -0,0 +1,264 @@
+/*
+  ==============================================================================
+
+    OfflineRenderer.cpp
+    Created: 16 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "OfflineRenderer.h"
+#include "../BPMAnalyzer.h"
+#include <algorithm>
+#include <ctime>
+
+bool OfflineRenderer::loadDeck(int deck, const juce::File& file, const Options& options, juce::String& errorMessage)
+{
+    auto sampler = std::make_unique<Sampler>((float)options.sampleRate, options.blockSize);
+    sampler->setSampleStorage(options.storage);
+    sampler->setResamplerQuality(options.resamplerQuality);
+    sampler->prepareToPlay(options.sampleRate, options.blockSize);
+
+    if (file != juce::File())
+    {
+        // Ganz dekodieren: ein Stream würde beim Rendern schneller als Echtzeit leer laufen
+        auto track = DecodedTrackCache::getInstance().getOrDecode(file);
+
+        if (track == nullptr)
+        {
+            errorMessage = "cannot decode " + file.getFullPathName();
+            return false;
+        }
+
+        sampler->installSource(nullptr, std::move(track));
+
+        // Kompakte Kopie oder Ratenwandlung vor dem ersten Block fertigstellen, sonst hängt
+        // der Block, in dem sie übernommen wird, vom Tempo des Konvertierungs-Threads ab
+        sampler->waitForConversions();
+    }
+
+    decks[(size_t)deck] = std::move(sampler);
+    engine.setDeck(deck, decks[(size_t)deck].get());
+    return true;
+}
+
+EngineParameters OfflineRenderer::makeParameters() const
+{
+    EngineParameters params;
+
+    // Crossfader wie im MixerComponent: jede Seite wird nur zur Gegenseite hin abgesenkt
+    const float crossfader = (float)state.crossfader;
+    const std::array<float, 2> crossfaderGains { crossfader > 0.0f ? 1.0f - crossfader : 1.0f,
+                                                 crossfader < 0.0f ? 1.0f + crossfader : 1.0f };
+
+    for (size_t deck = 0; deck < 2; ++deck)
+    {
+        auto& deckParams = params.decks[deck];
+        deckParams.channelGain = state.faders[deck];
+        deckParams.masterGain = state.faders[deck] * crossfaderGains[deck];
+        deckParams.pitch = state.pitch[deck];
+        deckParams.keyLock = state.keyLock[deck];
+        deckParams.destination = deck == 0 ? EngineParameters::OutputDestination::MasterLeft
+                                           : EngineParameters::OutputDestination::MasterRight;
+    }
+
+    params.filter.bypass = !state.filterOn;
+    params.eq.bypass = !state.eqOn;
+    params.chorus.bypass = !state.chorusOn;
+    params.reverb.bypass = !state.reverbOn;
+    return params;
+}
+
+void OfflineRenderer::applyEvent(const RenderScenario::Event& event, double bpm, double nowSeconds)
+{
+    using Command = RenderScenario::Command;
+    Sampler* sampler = decks[(size_t)event.deck].get();
+
+    switch (event.command)
+    {
+        case Command::play:       if (sampler != nullptr) sampler->play(); break;
+        case Command::stop:       if (sampler != nullptr) sampler->stop(); break;
+        case Command::seek:
+            if (sampler != nullptr)
+                sampler->setCurrentPosition((long)(event.value * sampler->getSourceSampleRate()));
+            break;
+        case Command::pitch:      state.pitch[(size_t)event.deck] = juce::jlimit(0.25, 4.0, event.value); break;
+        case Command::keyLock:    state.keyLock[(size_t)event.deck] = event.value > 0.5; break;
+        case Command::fader:      state.faders[(size_t)event.deck] = (float)juce::jlimit(0.0, 1.0, event.value); break;
+        case Command::filter:     state.filterOn = event.value > 0.5; break;
+        case Command::eq:         state.eqOn = event.value > 0.5; break;
+        case Command::chorus:     state.chorusOn = event.value > 0.5; break;
+        case Command::reverb:     state.reverbOn = event.value > 0.5; break;
+
+        case Command::crossfader:
+        {
+            const double length = event.duration.toSeconds(bpm);
+
+            if (length <= 0.0)
+            {
+                crossfaderRamp.active = false;
+                state.crossfader = event.value;
+            }
+            else
+            {
+                crossfaderRamp = { true, state.crossfader, event.value, nowSeconds, length };
+            }
+            break;
+        }
+
+        case Command::stutter:
+            if (event.value < 0.0)
+                stutter.stopStutter();
+            else
+                stutter.startStutter((StutterProcessor::StutterType)(int)event.value, (int)event.secondValue);
+            break;
+
+        case Command::end:
+        default:
+            break;
+    }
+}
+
+OfflineRenderer::Result OfflineRenderer::render(const RenderScenario& scenario, const Options& options)
+{
+    Result result;
+
+    if (options.sampleRate <= 0.0 || options.blockSize <= 0)
+    {
+        result.errorMessage = "invalid sample rate or block size";
+        return result;
+    }
+
+    for (int deck = 0; deck < 2; ++deck)
+        if (!loadDeck(deck, options.deckFiles[(size_t)deck], options, result.errorMessage))
+            return result;
+
+    // Tempo für die Beat-Zeiten des Skripts und den Play Head
+    result.bpm = options.bpm;
+
+    if (result.bpm <= 0.0 && options.deckFiles[0] != juce::File())
+    {
+        BPMAnalyzer analyzer;
+
+        if (auto track = DecodedTrackCache::getInstance().find(options.deckFiles[0]))
+            if (analyzer.analyzeTrack(*track))
+                result.bpm = analyzer.getBPM();
+    }
+
+    if (result.bpm <= 0.0)
+        result.bpm = 120.0;
+
+    // Beat- und Sekundenzeiten gemischt: einmal nach Sekunden ordnen, gleiche Zeiten in Dateireihenfolge
+    auto events = scenario.events;
+    std::stable_sort(events.begin(), events.end(), [bpm = result.bpm](const auto& a, const auto& b)
+                     { return a.time.toSeconds(bpm) < b.time.toSeconds(bpm); });
+
+    const double endTime = scenario.getEndTime(result.bpm);
+    result.numFrames = (juce::int64)std::ceil((endTime >= 0.0 ? endTime : options.defaultLength) * options.sampleRate);
+
+    engine.setStutter(&stutter);
+    engine.setKeyLockMode(options.keyLockMode);
+    engine.prepareToPlay(options.sampleRate, options.blockSize);
+
+    std::unique_ptr<juce::AudioFormatWriter> writer;
+
+    if (options.outputFile != juce::File())
+    {
+        options.outputFile.deleteFile();
+        auto stream = options.outputFile.createOutputStream();
+
+        if (stream == nullptr)
+        {
+            result.errorMessage = "cannot write " + options.outputFile.getFullPathName();
+            return result;
+        }
+
+        juce::WavAudioFormat wav;
+        writer.reset(wav.createWriterFor(stream.get(), options.sampleRate, 2, options.bitsPerSample, {}, 0));
+
+        if (writer == nullptr)
+        {
+            result.errorMessage = "cannot create a " + juce::String(options.bitsPerSample) + " bit WAV writer";
+            return result;
+        }
+
+        stream.release(); // gehört jetzt dem Writer
+    }
+
+    juce::AudioBuffer<float> block(2, options.blockSize);
+    state = {};
+    crossfaderRamp = {};
+    engine.publishParameters(makeParameters());
+    engine.getDspLoadMonitor().reset();
+
+    size_t nextEvent = 0;
+    const double wallStart = juce::Time::getMillisecondCounterHiRes();
+    const std::clock_t cpuStart = std::clock();
+
+    for (juce::int64 position = 0; position < result.numFrames; position += options.blockSize)
+    {
+        const int numSamples = (int)juce::jmin((juce::int64)options.blockSize, result.numFrames - position);
+
+        playHead.setPositionInfo(position, options.sampleRate, result.bpm);
+        const auto now = playHead.getPosition();
+        const double nowSeconds = now->getTimeInSeconds().orFallback(0.0);
+        const double nowBeats = now->getPpqPosition().orFallback(0.0);
+
+        // Fällige Events am Blockanfang, Beat-Zeiten gegen die PPQ-Position des Play Heads
+        bool changed = false;
+
+        while (nextEvent < events.size())
+        {
+            const auto& event = events[nextEvent];
+            const bool due = event.time.inBeats ? event.time.value <= nowBeats : event.time.value <= nowSeconds;
+
+            if (!due)
+                break;
+
+            applyEvent(event, result.bpm, nowSeconds);
+            changed = true;
+            ++nextEvent;
+        }
+
+        if (crossfaderRamp.active)
+        {
+            const double progress = juce::jlimit(0.0, 1.0, (nowSeconds - crossfaderRamp.startSeconds) / crossfaderRamp.lengthSeconds);
+            state.crossfader = crossfaderRamp.from + (crossfaderRamp.to - crossfaderRamp.from) * progress;
+            crossfaderRamp.active = progress < 1.0;
+            changed = true;
+        }
+
+        if (changed)
+            engine.publishParameters(makeParameters());
+
+        block.clear();
+        engine.process(block.getArrayOfWritePointers(), block.getNumChannels(), 0, numSamples);
+
+        result.peak = juce::jmax(result.peak, block.getMagnitude(0, numSamples));
+
+        if (writer != nullptr)
+            writer->writeFromAudioSampleBuffer(block, 0, numSamples);
+
+        // Ring des Monitors leeren, bevor er überläuft; ausgetauschte Quellen freigeben
+        if (++result.numBlocks % 256 == 0)
+        {
+            engine.getDspLoadMonitor().collect();
+
+            for (auto& deck : decks)
+                deck->releaseRetiredSources();
+        }
+    }
+
+    result.wallSeconds = (juce::Time::getMillisecondCounterHiRes() - wallStart) / 1000.0;
+    result.cpuSeconds = (double)(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+
+    writer.reset();
+    engine.releaseResources();
+
+    result.audioSeconds = (double)result.numFrames / options.sampleRate;
+    result.realtimeFactor = result.wallSeconds > 0.0 ? result.audioSeconds / result.wallSeconds : 0.0;
+    result.realtimeFactorPerCore = result.cpuSeconds > 0.0 ? result.audioSeconds / result.cpuSeconds : 0.0;
+    result.load = engine.getDspLoadMonitor().collect();
+    result.ok = true;
+    return result;
+}
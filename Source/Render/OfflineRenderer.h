@@ -0,0 +1,97 @@
+/*
+  ==============================================================================
+
+    OfflineRenderer.h
+    Created: 16 Oct 2026
+
+    Runs a RenderScenario through the MixEngine without an audio device:
+    both decks are decoded up front, then the mix is rendered block by block
+    as fast as the CPU allows. An OfflinePlayHead advances with every block;
+    scenario events fire at the first block that starts at or after their
+    time, crossfader ramps are evaluated once per block.
+
+    Throughput is reported as real-time factor (audio seconds per wall clock
+    second) and per core (audio seconds per second of process CPU time, which
+    includes the background rate conversion of the decks).
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include "RenderScenario.h"
+#include "../AudioEngine/MixEngine.h"
+#include "../AudioEngine/OfflinePlayHead.h"
+
+class OfflineRenderer
+{
+public:
+    struct Options
+    {
+        std::array<juce::File, 2> deckFiles;
+        juce::File outputFile;              // leer: nur rendern und messen
+        double sampleRate = 44100.0;
+        int blockSize = 512;
+        int bitsPerSample = 24;
+        double bpm = 0.0;                   // 0: aus Deck A analysieren, sonst 120
+        double defaultLength = 60.0;        // Sekunden, wenn das Skript kein "end" hat
+        SampleStorage storage = SampleStorage::float32;
+        Resampler::Quality resamplerQuality = Resampler::Quality::WindowedSinc;
+        TimeStretcher::Mode keyLockMode = TimeStretcher::Mode::WSOLA;
+    };
+
+    struct Result
+    {
+        bool ok = false;
+        juce::String errorMessage;
+
+        double bpm = 0.0;
+        juce::int64 numFrames = 0;
+        int numBlocks = 0;
+        double audioSeconds = 0.0;
+        double wallSeconds = 0.0;
+        double cpuSeconds = 0.0;
+        double realtimeFactor = 0.0;        // audioSeconds / wallSeconds
+        double realtimeFactorPerCore = 0.0; // audioSeconds / cpuSeconds
+        float peak = 0.0f;
+        DspLoadMonitor::Snapshot load;
+    };
+
+    OfflineRenderer() = default;
+
+    Result render(const RenderScenario& scenario, const Options& options);
+
+private:
+    // Mixer-Zustand, den das Skript verändert (entspricht den Reglern im MixerComponent)
+    struct MixerState
+    {
+        std::array<float, 2> faders { 1.0f, 1.0f };
+        std::array<double, 2> pitch { 1.0, 1.0 };
+        std::array<bool, 2> keyLock { false, false };
+        double crossfader = 0.0;
+        bool filterOn = false, eqOn = false, chorusOn = false, reverbOn = false;
+    };
+
+    struct Ramp
+    {
+        bool active = false;
+        double from = 0.0, to = 0.0;
+        double startSeconds = 0.0, lengthSeconds = 0.0;
+    };
+
+    bool loadDeck(int deck, const juce::File& file, const Options& options, juce::String& errorMessage);
+    void applyEvent(const RenderScenario::Event& event, double bpm, double nowSeconds);
+    EngineParameters makeParameters() const;
+
+    MixEngine engine;
+    std::array<std::unique_ptr<Sampler>, 2> decks;
+    StutterProcessor stutter;
+    OfflinePlayHead playHead;
+
+    MixerState state;
+    Ramp crossfaderRamp;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OfflineRenderer)
+};
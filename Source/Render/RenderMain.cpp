@@ -0,0 +1,227 @@
+/*
+  ==============================================================================
+
+    RenderMain.cpp
+    Created: 16 Oct 2026
+
+    RadioBlastRender: renders a RenderScenario through the headless mixing
+    core to a WAV file and reports the throughput.
+
+        RadioBlastRender <scenario> [-a deckA] [-b deckB] [-o out.wav]
+                         [--rate 44100] [--block 512] [--bits 24] [--bpm 0]
+                         [--length 60] [--storage float32|int16|float16]
+                         [--resampler linear|cubic|sinc] [--keylock wsola|vocoder]
+                         [--repeat 1]
+
+    Without -o the mix is only rendered and measured. With --repeat the
+    scenario runs several times (the decks stay in the track cache) and the
+    fastest run is reported.
+
+    Built with RADIOBLAST_RT_SANITIZER the run also counts real-time
+    violations in MixEngine::process and exits with 2 if there were any,
+    so a CI job keeps them at zero. The report follows on stderr at exit.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <iostream>
+#include "OfflineRenderer.h"
+#include "RealtimeSanitizer.h"
+
+namespace
+{
+    void printUsage()
+    {
+        std::cout << "usage: RadioBlastRender <scenario> [-a deckA] [-b deckB] [-o out.wav]\n"
+                     "                        [--rate Hz] [--block samples] [--bits 16|24|32] [--bpm tempo]\n"
+                     "                        [--length seconds] [--storage float32|int16|float16]\n"
+                     "                        [--resampler linear|cubic|sinc] [--keylock wsola|vocoder]\n"
+                     "                        [--repeat n]\n";
+    }
+
+    bool parseOptions(const juce::StringArray& args, juce::File& scenarioFile, OfflineRenderer::Options& options,
+                      int& repeat, juce::String& errorMessage)
+    {
+        const auto cwd = juce::File::getCurrentWorkingDirectory();
+
+        for (int i = 0; i < args.size(); ++i)
+        {
+            const auto& arg = args[i];
+
+            if (!arg.startsWith("-"))
+            {
+                if (scenarioFile != juce::File())
+                {
+                    errorMessage = "more than one scenario given";
+                    return false;
+                }
+
+                scenarioFile = cwd.getChildFile(arg);
+                continue;
+            }
+
+            if (i + 1 >= args.size())
+            {
+                errorMessage = arg + " needs a value";
+                return false;
+            }
+
+            const auto value = args[++i];
+
+            if (arg == "-a" || arg == "--deck-a")       options.deckFiles[0] = cwd.getChildFile(value);
+            else if (arg == "-b" || arg == "--deck-b")  options.deckFiles[1] = cwd.getChildFile(value);
+            else if (arg == "-o" || arg == "--output")  options.outputFile = cwd.getChildFile(value);
+            else if (arg == "--rate")                   options.sampleRate = value.getDoubleValue();
+            else if (arg == "--block")                  options.blockSize = value.getIntValue();
+            else if (arg == "--bits")                   options.bitsPerSample = value.getIntValue();
+            else if (arg == "--bpm")                    options.bpm = value.getDoubleValue();
+            else if (arg == "--length")                 options.defaultLength = value.getDoubleValue();
+            else if (arg == "--repeat")                 repeat = juce::jmax(1, value.getIntValue());
+            else if (arg == "--storage")
+            {
+                if (value == "float32")      options.storage = SampleStorage::float32;
+                else if (value == "int16")   options.storage = SampleStorage::int16;
+                else if (value == "float16") options.storage = SampleStorage::float16;
+                else { errorMessage = "unknown storage '" + value + "'"; return false; }
+            }
+            else if (arg == "--resampler")
+            {
+                if (value == "linear")      options.resamplerQuality = Resampler::Quality::Linear;
+                else if (value == "cubic")  options.resamplerQuality = Resampler::Quality::CubicHermite;
+                else if (value == "sinc")   options.resamplerQuality = Resampler::Quality::WindowedSinc;
+                else { errorMessage = "unknown resampler '" + value + "'"; return false; }
+            }
+            else if (arg == "--keylock")
+            {
+                if (value == "wsola")         options.keyLockMode = TimeStretcher::Mode::WSOLA;
+                else if (value == "vocoder")  options.keyLockMode = TimeStretcher::Mode::PhaseVocoder;
+                else { errorMessage = "unknown key lock mode '" + value + "'"; return false; }
+            }
+            else
+            {
+                errorMessage = "unknown option " + arg;
+                return false;
+            }
+        }
+
+        if (scenarioFile == juce::File())
+        {
+            errorMessage = "no scenario given";
+            return false;
+        }
+
+        return true;
+    }
+
+    void printResult(const OfflineRenderer::Result& result)
+    {
+        std::cout << juce::String::formatted("rendered   %.2f s audio (%lld frames, %d blocks) at %.2f BPM\n",
+                                             result.audioSeconds, (long long)result.numFrames, result.numBlocks, result.bpm)
+                  << juce::String::formatted("wall       %.3f s   -> %.1fx real time\n", result.wallSeconds, result.realtimeFactor)
+                  << juce::String::formatted("cpu        %.3f s   -> %.1fx real time per core\n", result.cpuSeconds, result.realtimeFactorPerCore)
+                  << juce::String::formatted("peak       %.2f dBFS\n", juce::Decibels::gainToDecibels(result.peak))
+                  << "\nstage            mean ms    p99 ms    max ms\n";
+
+        auto printStage = [](const juce::String& name, const DspLoadMonitor::StageStats& stats)
+        {
+            std::cout << name.paddedRight(' ', 14)
+                      << juce::String::formatted("%10.4f%10.4f%10.4f\n", stats.meanMs, stats.p99Ms, stats.maxMs);
+        };
+
+        for (int stage = 0; stage < DspLoadMonitor::numStages; ++stage)
+            printStage(DspLoadMonitor::getStageName((DspLoadMonitor::Stage)stage), result.load.stages[(size_t)stage]);
+
+        printStage("block", result.load.callback);
+
+        std::cout << juce::String::formatted("\nload       %.2f %% of the block budget (last %d blocks)\n",
+                                             result.load.loadPercent, result.load.numBlocks);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    juce::StringArray args;
+
+    for (int i = 1; i < argc; ++i)
+        args.add(juce::CharPointer_UTF8(argv[i]));
+
+    if (args.isEmpty() || args.contains("-h") || args.contains("--help"))
+    {
+        printUsage();
+        return args.isEmpty() ? 1 : 0;
+    }
+
+    juce::File scenarioFile;
+    OfflineRenderer::Options options;
+    int repeat = 1;
+    juce::String errorMessage;
+
+    if (!parseOptions(args, scenarioFile, options, repeat, errorMessage))
+    {
+        std::cerr << errorMessage << "\n";
+        printUsage();
+        return 1;
+    }
+
+    if (!scenarioFile.existsAsFile())
+    {
+        std::cerr << "scenario not found: " << scenarioFile.getFullPathName() << "\n";
+        return 1;
+    }
+
+    RenderScenario scenario;
+
+    if (!scenario.parse(scenarioFile.loadFileAsString(), errorMessage))
+    {
+        std::cerr << scenarioFile.getFileName() << ": " << errorMessage << "\n";
+        return 1;
+    }
+
+    OfflineRenderer::Result best;
+
+    for (int run = 0; run < repeat; ++run)
+    {
+        // Nur der letzte Durchlauf schreibt die Datei, die anderen messen nur
+        auto runOptions = options;
+
+        if (run + 1 < repeat)
+            runOptions.outputFile = juce::File();
+
+        OfflineRenderer renderer;
+        const auto result = renderer.render(scenario, runOptions);
+
+        if (!result.ok)
+        {
+            std::cerr << "render failed: " << result.errorMessage << "\n";
+            return 1;
+        }
+
+        if (repeat > 1)
+            std::cout << juce::String::formatted("run %d: %.1fx real time\n", run + 1, result.realtimeFactor);
+
+        if (!best.ok || result.realtimeFactor > best.realtimeFactor)
+            best = result;
+    }
+
+    if (repeat > 1)
+        std::cout << "\nfastest run:\n";
+
+    printResult(best);
+
+    if (options.outputFile != juce::File())
+        std::cout << "\nwritten    " << options.outputFile.getFullPathName() << "\n";
+
+   #if RADIOBLAST_RT_SANITIZER
+    const auto violations = RealtimeSanitizer::getViolationCount();
+
+    std::cout << juce::String::formatted("\nrt safety  %lld violation(s) at %d call site(s)%s\n", (long long)violations,
+                                         RealtimeSanitizer::getNumCallSites(),
+                                         RealtimeSanitizer::isInterposing() ? "" : " (no libc hooks linked)");
+
+    if (violations > 0)
+        return 2;
+   #endif
+
+    return 0;
+}
@@ -0,0 +1,169 @@
+/*
+  ==============================================================================
+
+    RenderScenario.cpp
+    Created: 16 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "RenderScenario.h"
+
+namespace
+{
+    bool parseTime(juce::String token, RenderScenario::Time& time)
+    {
+        token = token.trim().toLowerCase();
+        time.inBeats = token.endsWithChar('b');
+
+        if (time.inBeats || token.endsWithChar('s'))
+            token = token.dropLastCharacters(1);
+
+        if (token.isEmpty() || !token.containsOnly("0123456789.+-"))
+            return false;
+
+        time.value = token.getDoubleValue();
+        return time.value >= 0.0;
+    }
+
+    bool parseDeck(const juce::String& token, int& deck)
+    {
+        const auto name = token.trim().toUpperCase();
+
+        if (name != "A" && name != "B")
+            return false;
+
+        deck = name == "A" ? 0 : 1;
+        return true;
+    }
+
+    bool parseNumber(const juce::String& token, double& value)
+    {
+        const auto text = token.trim();
+
+        if (text.isEmpty() || !text.containsOnly("0123456789.+-eE"))
+            return false;
+
+        value = text.getDoubleValue();
+        return true;
+    }
+
+    bool parseSwitch(const juce::String& token, double& value)
+    {
+        const auto text = token.trim().toLowerCase();
+
+        if (text != "on" && text != "off")
+            return false;
+
+        value = text == "on" ? 1.0 : 0.0;
+        return true;
+    }
+}
+
+bool RenderScenario::parse(const juce::String& script, juce::String& errorMessage)
+{
+    events.clear();
+
+    const auto lines = juce::StringArray::fromLines(script);
+
+    for (int i = 0; i < lines.size(); ++i)
+    {
+        const auto line = lines[i].upToFirstOccurrenceOf("#", false, false).trim();
+
+        if (line.isEmpty())
+            continue;
+
+        auto tokens = juce::StringArray::fromTokens(line, " \t", "");
+        tokens.removeEmptyStrings();
+
+        Event event;
+        event.line = i + 1;
+
+        auto fail = [&](const juce::String& reason)
+        {
+            errorMessage = "line " + juce::String(event.line) + ": " + reason + " (" + line + ")";
+            return false;
+        };
+
+        if (tokens.size() < 2 || !parseTime(tokens[0], event.time))
+            return fail("expected <time> <command>");
+
+        const auto command = tokens[1].toLowerCase();
+        const int numArgs = tokens.size() - 2;
+
+        if (command == "play" || command == "stop")
+        {
+            event.command = command == "play" ? Command::play : Command::stop;
+
+            if (numArgs != 1 || !parseDeck(tokens[2], event.deck))
+                return fail("expected " + command + " A|B");
+        }
+        else if (command == "seek" || command == "pitch" || command == "fader")
+        {
+            event.command = command == "seek" ? Command::seek : (command == "pitch" ? Command::pitch : Command::fader);
+
+            if (numArgs != 2 || !parseDeck(tokens[2], event.deck) || !parseNumber(tokens[3], event.value))
+                return fail("expected " + command + " A|B <value>");
+        }
+        else if (command == "keylock")
+        {
+            event.command = Command::keyLock;
+
+            if (numArgs != 2 || !parseDeck(tokens[2], event.deck) || !parseSwitch(tokens[3], event.value))
+                return fail("expected keylock A|B on|off");
+        }
+        else if (command == "crossfader")
+        {
+            event.command = Command::crossfader;
+
+            if (numArgs < 1 || numArgs > 2 || !parseNumber(tokens[2], event.value)
+                || (numArgs == 2 && !parseTime(tokens[3], event.duration)))
+                return fail("expected crossfader <-1..1> [<duration>]");
+
+            event.value = juce::jlimit(-1.0, 1.0, event.value);
+        }
+        else if (command == "filter" || command == "eq" || command == "chorus" || command == "reverb")
+        {
+            event.command = command == "filter" ? Command::filter
+                          : command == "eq" ? Command::eq
+                          : command == "chorus" ? Command::chorus : Command::reverb;
+
+            if (numArgs != 1 || !parseSwitch(tokens[2], event.value))
+                return fail("expected " + command + " on|off");
+        }
+        else if (command == "stutter")
+        {
+            event.command = Command::stutter;
+
+            if (numArgs == 1 && tokens[2].equalsIgnoreCase("off"))
+                event.value = -1.0;
+            else if (numArgs != 2 || !parseNumber(tokens[2], event.value) || !parseNumber(tokens[3], event.secondValue)
+                     || event.value < 0.0 || event.value > 3.0 || event.secondValue < 0.0 || event.secondValue > 3.0)
+                return fail("expected stutter <type 0..3> <subdivision 0..3> or stutter off");
+        }
+        else if (command == "end")
+        {
+            event.command = Command::end;
+
+            if (numArgs != 0)
+                return fail("end takes no arguments");
+        }
+        else
+        {
+            return fail("unknown command '" + tokens[1] + "'");
+        }
+
+        events.push_back(event);
+    }
+
+    return true;
+}
+
+double RenderScenario::getEndTime(double bpm) const
+{
+    for (const auto& event : events)
+        if (event.command == Command::end)
+            return event.time.toSeconds(bpm);
+
+    return -1.0;
+}
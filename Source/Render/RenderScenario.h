@@ -0,0 +1,77 @@
+/*
+  ==============================================================================
+
+    RenderScenario.h
+    Created: 16 Oct 2026
+
+    A scripted deck / crossfader session for the offline renderer. One event
+    per line, '#' starts a comment:
+
+        <time>  play A | stop B
+        <time>  seek A <seconds>
+        <time>  pitch A <ratio>             1.0 = original speed
+        <time>  keylock B on|off
+        <time>  fader A <gain>              channel fader, 0 .. 1
+        <time>  crossfader <-1 .. 1> [<duration>]
+        <time>  filter|eq|chorus|reverb on|off
+        <time>  stutter <0..3> <subdivision 0..3> | stutter off
+        <time>  end
+
+    Times are seconds ("12.5", "12.5s") or beats at the play head tempo
+    ("32b"); a crossfader move with a duration ramps linearly over it.
+    Events at the same time keep their order from the file.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+
+struct RenderScenario
+{
+    enum class Command
+    {
+        play,
+        stop,
+        seek,
+        pitch,
+        keyLock,
+        fader,
+        crossfader,
+        filter,
+        eq,
+        chorus,
+        reverb,
+        stutter,
+        end
+    };
+
+    struct Time
+    {
+        double value = 0.0;
+        bool inBeats = false;
+
+        double toSeconds(double bpm) const noexcept { return inBeats ? value * 60.0 / bpm : value; }
+    };
+
+    struct Event
+    {
+        Time time;
+        Command command = Command::end;
+        int deck = 0;               // 0 = A, 1 = B
+        double value = 0.0;         // Zielwert, Ratio, Position, on/off (1/0), Stutter-Typ (-1 = aus)
+        double secondValue = 0.0;   // Stutter-Unterteilung
+        Time duration;              // Rampe für den Crossfader
+        int line = 0;
+    };
+
+    std::vector<Event> events;
+
+    /** Parses a script; on a syntax error returns false and describes it in errorMessage. */
+    bool parse(const juce::String& script, juce::String& errorMessage);
+
+    /** Time of the end event in seconds, or -1 if the script has none. */
+    double getEndTime(double bpm) const;
+};
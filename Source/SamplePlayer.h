@@ -11,6 +11,8 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "AudioEngine/DecodedTrackCache.h"
+#include "AudioEngine/SampleSlotBank.h"
 
 //==============================================================================
 class SamplePlayer : public juce::Component,
@@ -20,46 +22,13 @@ class SamplePlayer : public juce::Component,
     public juce::ComboBox::Listener
 {
 public:
-    enum class PlayMode
-    {
-        OneShot,
-        LoopForward,
-        LoopBackward
-    };
-
-    struct SampleSlot
-    {
-        juce::AudioBuffer<float> buffer;
-        juce::String fileName;
-        int currentPosition = 0;
-        bool isPlaying = false;
-        PlayMode playMode = PlayMode::OneShot;
-        float gain = 1.0f;
-
-        void reset()
-        {
-            currentPosition = 0;
-            isPlaying = false;
-        }
-
-        void stop()
-        {
-            isPlaying = false;
-            currentPosition = 0;
-        }
-
-        bool isEmpty() const
-        {
-            return buffer.getNumSamples() == 0;
-        }
-    };
+    // Slots und Voices liegen in der SampleSlotBank, der Player ist nur die Bedienung
+    using PlayMode = SampleSlotBank::PlayMode;
+    using SampleSlot = SampleSlotBank::SampleSlot;
 
     //==============================================================================
     SamplePlayer()
     {
-        // Initialize 8 sample slots
-        sampleSlots.resize(8);
-
         setupUI();
         formatManager.registerBasicFormats();
 
@@ -341,8 +310,8 @@ public:
         // Stop target slot if playing
         target.stop();
 
-        // Copy buffer and properties
-        target.buffer = source.buffer;
+        // Copy properties, the data is immutable and shared
+        slotBank.setSlotData(toSlot, source.data);
         target.fileName = source.fileName + " (Copy)";
         target.playMode = source.playMode;
         target.gain = source.gain;
@@ -372,7 +341,7 @@ public:
 
         auto& slot = sampleSlots[slotIndex];
         slot.stop();
-        slot.buffer.clear();
+        slotBank.setSlotData(slotIndex, nullptr);
         slot.fileName.clear();
         slot.gain = 1.0f;
         slot.playMode = PlayMode::OneShot;
@@ -384,69 +353,44 @@ public:
     }
 
     //==============================================================================
-    // Hauptmethode fr Sample-Processing - wird in Ihrem Audio-Loop aufgerufen
-    void generateSampleOutput(std::vector<float>& leftOut, std::vector<float>& rightOut, int numSamples, float gain)
+    // Audio Thread, siehe SampleSlotBank
+    void generateSampleOutput(float* leftOut, float* rightOut, int numSamples, float gain)
     {
-        // Initialize output vectors with zeros
-        std::fill(leftOut.begin(), leftOut.end(), 0.0f);
-        std::fill(rightOut.begin(), rightOut.end(), 0.0f);
-
-        if (leftOut.size() < numSamples) leftOut.resize(numSamples, 0.0f);
-        if (rightOut.size() < numSamples) rightOut.resize(numSamples, 0.0f);
-
-        for (auto& slot : sampleSlots)
-        {
-            if (!slot.isPlaying || slot.buffer.getNumSamples() == 0)
-                continue;
-
-            processSampleSlot(slot, leftOut, rightOut, numSamples, gain);
-        }
+        slotBank.generateSampleOutput(leftOut, rightOut, numSamples, gain);
     }
 
     //==============================================================================
     void stopAllSamples()
     {
-        for (auto& slot : sampleSlots)
-        {
-            slot.stop();
-        }
+        slotBank.stopAllSamples();
         updateButtonStates();
     }
 
     void setSampleGain(int slotIndex, float gain)
     {
-        if (slotIndex >= 0 && slotIndex < sampleSlots.size())
-        {
-            sampleSlots[slotIndex].gain = juce::jlimit(0.0f, 2.0f, gain);
-        }
+        slotBank.setSampleGain(slotIndex, gain);
     }
 
     void triggerSample(int slotIndex)
     {
-        if (slotIndex >= 0 && slotIndex < sampleSlots.size())
-        {
-            auto& slot = sampleSlots[slotIndex];
-            if (slot.buffer.getNumSamples() > 0)
-            {
-                slot.isPlaying = true;
-                slot.currentPosition = 0;
-                updateButtonStates();
-            }
-        }
+        slotBank.triggerSample(slotIndex);
+        updateButtonStates();
     }
 
     bool isAnySamplePlaying() const
     {
-        for (const auto& slot : sampleSlots)
-        {
-            if (slot.isPlaying) return true;
-        }
-        return false;
+        return slotBank.isAnySamplePlaying();
     }
 
+    void setSampleStorage(SampleStorage storage) { slotBank.setSampleStorage(storage); }
+    SampleStorage getSampleStorage() const { return slotBank.getSampleStorage(); }
+
+    SampleSlotBank& getSlotBank() { return slotBank; }
+
 private:
     //==============================================================================
-    std::vector<SampleSlot> sampleSlots;
+    SampleSlotBank slotBank;
+    std::vector<SampleSlot>& sampleSlots { slotBank.getSlots() };
     juce::AudioFormatManager formatManager;
 
     // UI Components
@@ -542,7 +486,7 @@ private:
         sampleSlots[slot2].stop();
 
         // Swap the sample data
-        std::swap(sampleSlots[slot1], sampleSlots[slot2]);
+        slotBank.swapSlots(slot1, slot2);
 
         // Update UI for both slots
         updateSlotUI(slot1);
@@ -590,20 +534,22 @@ private:
         if (!audioFile.existsAsFile())
             return;
 
-        std::unique_ptr<juce::AudioFormatReader> reader(
-            formatManager.createReaderFor(audioFile));
+        // Gemeinsamer Cache: liegt der Track schon auf einem Deck, entfllt das Dekodieren
+        auto track = DecodedTrackCache::getInstance().getOrDecode(audioFile);
 
-        if (reader == nullptr)
+        if (track == nullptr)
             return;
 
+        // Umwandeln, bevor der Slot angefasst wird; der Audio Thread sieht nur den fertigen Zeiger
+        auto data = slotBank.makeSlotData(track->buffer, track->sampleRate);
+
         auto& slot = sampleSlots[slotIndex];
 
         // Stop current playback
         slot.stop();
 
         // Load the audio data
-        slot.buffer.setSize(reader->numChannels, (int)reader->lengthInSamples);
-        reader->read(&slot.buffer, 0, (int)reader->lengthInSamples, 0, true, true);
+        slotBank.setSlotData(slotIndex, std::move(data));
 
         slot.fileName = audioFile.getFileNameWithoutExtension();
 
@@ -620,7 +566,7 @@ private:
 
         auto& slot = sampleSlots[slotIndex];
 
-        if (slot.buffer.getNumSamples() == 0)
+        if (slot.isEmpty())
             return; // No sample loaded
 
         if (slot.isPlaying)
@@ -636,80 +582,6 @@ private:
         updateButtonStates();
     }
 
-    //==============================================================================
-    void processSampleSlot(SampleSlot& slot, std::vector<float>& leftOut, std::vector<float>& rightOut, int numSamples, float masterGain)
-    {
-        const int sampleLength = slot.buffer.getNumSamples();
-        const int numChannels = slot.buffer.getNumChannels();
-
-        for (int sample = 0; sample < numSamples; ++sample)
-        {
-            if (!slot.isPlaying)
-                break;
-
-            // Handle different play modes
-            int readPosition = slot.currentPosition;
-
-            if (slot.playMode == PlayMode::LoopBackward)
-            {
-                readPosition = sampleLength - 1 - slot.currentPosition;
-            }
-
-            // Bounds check
-            if (readPosition < 0 || readPosition >= sampleLength)
-            {
-                if (slot.playMode == PlayMode::OneShot)
-                {
-                    slot.stop();
-                    break;
-                }
-                else // Loop modes
-                {
-                    slot.currentPosition = 0;
-                    readPosition = slot.playMode == PlayMode::LoopBackward ?
-                        sampleLength - 1 : 0;
-                }
-            }
-
-            // Get sample values
-            float leftSample = 0.0f;
-            float rightSample = 0.0f;
-
-            if (numChannels >= 1)
-            {
-                leftSample = slot.buffer.getSample(0, readPosition);
-            }
-
-            if (numChannels >= 2)
-            {
-                rightSample = slot.buffer.getSample(1, readPosition);
-            }
-            else
-            {
-                rightSample = leftSample; // Mono zu Stereo
-            }
-
-            // Apply gains and mix to output
-            float finalGain = slot.gain * masterGain;
-            leftOut[sample] += leftSample * finalGain;
-            rightOut[sample] += rightSample * finalGain;
-
-            // Advance position
-            if (slot.playMode == PlayMode::LoopBackward)
-            {
-                slot.currentPosition++;
-                if (slot.currentPosition >= sampleLength)
-                    slot.currentPosition = 0;
-            }
-            else
-            {
-                slot.currentPosition++;
-                if (slot.currentPosition >= sampleLength && slot.playMode != PlayMode::OneShot)
-                    slot.currentPosition = 0;
-            }
-        }
-    }
-
     //==============================================================================
     void updateButtonStates()
     {
@@ -11,6 +11,7 @@
 
 #pragma once
 #include <JuceHeader.h>
+#include "AudioEngine/DecodedTrackCache.h"
 
 class WaveformGenerator
 {
@@ -42,182 +43,130 @@ public:
     };
 
     // Hauptfunktion - generiert klassische Min/Max Waveform-Daten
+    // Dekodiert ber den gemeinsamen DecodedTrackCache, Deck und BPM-Analyse nutzen dieselben Daten
     static WaveformData generateWaveformData(const juce::File& audioFile, int targetSamples = 2000)
     {
-        WaveformData result;
-
-        juce::AudioFormatManager formatManager;
-        formatManager.registerBasicFormats();
-
-        std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(audioFile));
+        auto track = DecodedTrackCache::getInstance().getOrDecode(audioFile);
 
-        if (reader == nullptr)
+        if (track == nullptr)
         {
             DBG("Could not create reader for file: " + audioFile.getFullPathName());
-            return result;
+            return {};
         }
 
-        result.duration = reader->lengthInSamples / reader->sampleRate;
-        result.sampleRate = (int)reader->sampleRate;
-        result.isValid = true;
+        return generateWaveformData(*track, targetSamples);
+    }
 
-        // Calculate how many samples per waveform point
-        int totalSamples = (int)reader->lengthInSamples;
-        int samplesPerPoint = juce::jmax(1, totalSamples / targetSamples);
-        int numChannels = (int)reader->numChannels;
+    static WaveformData generateWaveformData(const DecodedTrack& track, int targetSamples = 2000)
+    {
+        Builder builder(track.buffer.getNumSamples(), track.sampleRate, targetSamples);
+        builder.addBlock(track.buffer.getReadPointer(0), track.buffer.getReadPointer(1), track.buffer.getNumSamples());
 
-        result.minSamples.reserve(targetSamples);
-        result.maxSamples.reserve(targetSamples);
+        auto result = builder.finish();
 
-        // Read audio in chunks
-        const int bufferSize = 8192;
-        juce::AudioBuffer<float> buffer(numChannels, bufferSize);
+        DBG("Generated waveform with " + juce::String(result.maxSamples.size()) + " points");
+        DBG("Duration: " + juce::String(result.duration, 2) + " seconds");
 
-        juce::int64 currentPos = 0;
-        int currentPointSamples = 0;
-        float currentMin = 0.0f;
-        float currentMax = 0.0f;
+        return result;
+    }
 
-        while (currentPos < reader->lengthInSamples)
+    // Dieselbe Min/Max-Waveform blockweise, z.B. direkt aus einem AudioFormatReader,
+    // ohne den ganzen Track im Speicher zu halten (Hintergrundanalyse)
+    class Builder
+    {
+    public:
+        Builder(juce::int64 totalSamples, double sampleRate, int targetSamples = 2000)
+            : samplesPerPoint(juce::jmax((juce::int64)1, totalSamples / juce::jmax(1, targetSamples)))
+            , maxPoints(juce::jmax(1, targetSamples))
         {
-            int samplesToRead = juce::jmin(bufferSize, (int)(reader->lengthInSamples - currentPos));
+            result.duration = sampleRate > 0.0 ? totalSamples / sampleRate : 0.0;
+            result.sampleRate = (int)sampleRate;
+            result.minSamples.reserve((size_t)maxPoints);
+            result.maxSamples.reserve((size_t)maxPoints);
+        }
 
-            if (!reader->read(&buffer, 0, samplesToRead, currentPos, true, true))
+        void addBlock(const float* left, const float* right, int numSamples)
+        {
+            for (int i = 0; i < numSamples && (int)result.maxSamples.size() < maxPoints; ++i)
             {
-                DBG("Error reading audio data at position: " + juce::String(currentPos));
-                break;
+                // Min/Max ber beide Kanle, Nulllinie immer eingeschlossen
+                pointMin = juce::jmin(pointMin, left[i], right[i]);
+                pointMax = juce::jmax(pointMax, left[i], right[i]);
+
+                if (++samplesInPoint == samplesPerPoint)
+                    flushPoint();
             }
+        }
+
+        WaveformData finish()
+        {
+            if (samplesInPoint > 0 && (int)result.maxSamples.size() < maxPoints)
+                flushPoint();
 
-            // Process each sample in the buffer
-            for (int i = 0; i < samplesToRead; ++i)
+            // Apply smoothing for better visual appearance
+            if (result.maxSamples.size() > 2)
             {
-                // Find min/max across all channels for this sample
-                float sampleMin = 0.0f;
-                float sampleMax = 0.0f;
-
-                for (int channel = 0; channel < numChannels; ++channel)
-                {
-                    float sample = buffer.getSample(channel, i);
-                    sampleMin = juce::jmin(sampleMin, sample);
-                    sampleMax = juce::jmax(sampleMax, sample);
-                }
-
-                // Update current point's min/max
-                if (currentPointSamples == 0)
-                {
-                    currentMin = sampleMin;
-                    currentMax = sampleMax;
-                }
-                else
-                {
-                    currentMin = juce::jmin(currentMin, sampleMin);
-                    currentMax = juce::jmax(currentMax, sampleMax);
-                }
-
-                currentPointSamples++;
-
-                // When we've collected enough samples for one point, store it
-                if (currentPointSamples >= samplesPerPoint ||
-                    (currentPos + i + 1) >= reader->lengthInSamples)
-                {
-                    result.minSamples.push_back(currentMin);
-                    result.maxSamples.push_back(currentMax);
-
-                    currentPointSamples = 0;
-                    currentMin = 0.0f;
-                    currentMax = 0.0f;
-
-                    if (result.maxSamples.size() >= targetSamples)
-                        break;
-                }
+                smoothWaveform(result.minSamples, result.maxSamples);
             }
 
-            if (result.maxSamples.size() >= targetSamples)
-                break;
-
-            currentPos += samplesToRead;
+            result.isValid = true;
+            return std::move(result);
         }
 
-        // Apply smoothing for better visual appearance
-        if (result.maxSamples.size() > 2)
+    private:
+        void flushPoint()
         {
-            smoothWaveform(result.minSamples, result.maxSamples);
+            result.minSamples.push_back(pointMin);
+            result.maxSamples.push_back(pointMax);
+            pointMin = pointMax = 0.0f;
+            samplesInPoint = 0;
         }
 
-        DBG("Generated waveform with " + juce::String(result.maxSamples.size()) + " points");
-        DBG("Duration: " + juce::String(result.duration, 2) + " seconds");
-
-        return result;
-    }
+        WaveformData result;
+        juce::int64 samplesPerPoint;
+        int maxPoints;
+        juce::int64 samplesInPoint = 0;
+        float pointMin = 0.0f, pointMax = 0.0f;
+    };
 
     // RMS-basierte Version (smoother, fr Envelope-hnliche Darstellung)
     static WaveformData generateRMSWaveform(const juce::File& audioFile, int targetSamples = 2000)
     {
         WaveformData result;
 
-        juce::AudioFormatManager formatManager;
-        formatManager.registerBasicFormats();
+        auto track = DecodedTrackCache::getInstance().getOrDecode(audioFile);
 
-        std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(audioFile));
+        if (track == nullptr) return result;
 
-        if (reader == nullptr) return result;
-
-        result.duration = reader->lengthInSamples / reader->sampleRate;
-        result.sampleRate = (int)reader->sampleRate;
+        result.duration = track->getDuration();
+        result.sampleRate = (int)track->sampleRate;
         result.isValid = true;
 
-        int totalSamples = (int)reader->lengthInSamples;
-        int samplesPerBlock = juce::jmax(1, totalSamples / targetSamples);
-        int numChannels = (int)reader->numChannels;
+        const int totalSamples = track->buffer.getNumSamples();
+        const int samplesPerBlock = juce::jmax(1, totalSamples / targetSamples);
 
         result.minSamples.reserve(targetSamples);
         result.maxSamples.reserve(targetSamples);
 
-        const int bufferSize = 8192;
-        juce::AudioBuffer<float> buffer(numChannels, bufferSize);
-
-        juce::int64 currentPos = 0;
-
-        while (currentPos < reader->lengthInSamples && result.maxSamples.size() < targetSamples)
+        // Calculate RMS for blocks
+        for (int blockStart = 0; blockStart < totalSamples && (int)result.maxSamples.size() < targetSamples; blockStart += samplesPerBlock)
         {
-            int samplesToRead = juce::jmin(bufferSize, (int)(reader->lengthInSamples - currentPos));
-
-            if (!reader->read(&buffer, 0, samplesToRead, currentPos, true, true))
-                break;
+            const int blockLength = juce::jmin(samplesPerBlock, totalSamples - blockStart);
+            float rmsSum = 0.0f;
 
-            // Calculate RMS for blocks
-            for (int blockStart = 0; blockStart < samplesToRead; blockStart += samplesPerBlock)
+            for (int channel = 0; channel < track->buffer.getNumChannels(); ++channel)
             {
-                if (result.maxSamples.size() >= targetSamples) break;
-
-                int blockEnd = juce::jmin(blockStart + samplesPerBlock, samplesToRead);
-                float rmsSum = 0.0f;
-                int rmsCount = 0;
-
-                for (int channel = 0; channel < numChannels; ++channel)
-                {
-                    const float* channelData = buffer.getReadPointer(channel);
-
-                    for (int i = blockStart; i < blockEnd; ++i)
-                    {
-                        float sample = channelData[i];
-                        rmsSum += sample * sample;
-                        rmsCount++;
-                    }
-                }
-
-                float rms = 0.0f;
-                if (rmsCount > 0)
-                {
-                    rms = std::sqrt(rmsSum / rmsCount);
-                }
-
-                // Fr RMS: symmetrische Darstellung
-                result.minSamples.push_back(-rms);
-                result.maxSamples.push_back(rms);
+                const float* channelData = track->buffer.getReadPointer(channel, blockStart);
+
+                for (int i = 0; i < blockLength; ++i)
+                    rmsSum += channelData[i] * channelData[i];
             }
 
-            currentPos += samplesToRead;
+            const float rms = std::sqrt(rmsSum / (float)(blockLength * track->buffer.getNumChannels()));
+
+            // Fr RMS: symmetrische Darstellung
+            result.minSamples.push_back(-rms);
+            result.maxSamples.push_back(rms);
         }
 
         return result;
@@ -226,17 +175,7 @@ public:
     // Hilfsfunktion fr Audio-Dauer
     static double getAudioDuration(const juce::File& audioFile)
     {
-        juce::AudioFormatManager formatManager;
-        formatManager.registerBasicFormats();
-
-        std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(audioFile));
-
-        if (reader != nullptr)
-        {
-            return reader->lengthInSamples / reader->sampleRate;
-        }
-
-        return 0.0;
+        return DecodedTrackCache::getInstance().getDuration(audioFile);
     }
 
     // Async Version fr groe Dateien
@@ -0,0 +1,29 @@
+/*
+  ==============================================================================
+
+    JuceHeader.h (headless)
+
+    Stands in for JuceLibraryCode/JuceHeader.h when the mixing core is built
+    with CMake: only the modules the engine needs, no GUI, no devices and no
+    BinaryData. Engine and renderer sources include <JuceHeader.h> and get
+    this one, the app keeps the Projucer generated header.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_dsp/juce_dsp.h>
+
+#if ! JUCE_DONT_DECLARE_PROJECTINFO
+namespace ProjectInfo
+{
+    const char* const  projectName    = "RadioBlast";
+    const char* const  companyName    = "Matthias P\xc3\xbcski";
+    const char* const  versionString  = "1.0.0";
+    const int          versionNumber  = 0x10000;
+}
+#endif